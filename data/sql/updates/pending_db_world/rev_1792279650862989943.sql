@@ -0,0 +1,5 @@
+INSERT INTO `version_db_world` (`sql_rev`) VALUES ('1792279650862989943');
+
+DELETE FROM `command` WHERE `name` = 'server mapcosts';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('server mapcosts', 3, 'Syntax: .server mapcosts [#count]\r\n\r\nDisplay the #count (default 10) maps with the highest measured update time, as used by the map updater to schedule expensive maps first, and the terrain tile load and grid prefetch statistics.');
@@ -0,0 +1,5 @@
+INSERT INTO `version_db_world` (`sql_rev`) VALUES ('1792280467977124805');
+
+DELETE FROM `command` WHERE `name` = 'server dbstats';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('server dbstats', 3, 'Syntax: .server dbstats [#count]\r\n\r\nDisplay, for each database, how many commits the asynchronous workers made for grouped transactions and statements, and the #count (default 5) prepared statements with the highest total execution time.');
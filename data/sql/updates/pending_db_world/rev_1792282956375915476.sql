@@ -0,0 +1,5 @@
+INSERT INTO `version_db_world` (`sql_rev`) VALUES ('1792282956375915476');
+
+DELETE FROM `command` WHERE `name` = 'debug capture';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('debug capture', 3, 'Syntax: .debug capture [$playername]\r\n\r\nWrite the packets the selected or named player sent and received during the last PacketLog.Capture.Seconds to a file in the logs directory, in the PacketLogFile format. Needs PacketLog.Capture.BufferSize to be set.');
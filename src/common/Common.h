@@ -77,6 +77,7 @@
 #include <vector>
 
 #include "Threading/LockedQueue.h"
+#include "Threading/MPSCQueue.h"
 #include "Threading/Threading.h"
 
 #include <ace/RW_Thread_Mutex.h>
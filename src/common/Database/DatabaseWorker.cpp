@@ -12,7 +12,9 @@
 
 DatabaseWorker::DatabaseWorker(ACE_Activation_Queue* new_queue, MySQLConnection* con) :
     m_queue(new_queue),
-    m_conn(con)
+    m_conn(con),
+    m_groupCommits(0),
+    m_groupedOperations(0)
 {
     /// Assign thread to task
     activate();
@@ -24,17 +26,108 @@ int DatabaseWorker::svc()
         return -1;
 
     SQLOperation* request = nullptr;
+    SQLOperation* next = nullptr;
+    std::vector<SQLOperation*> group;
     while (1)
     {
-        request = (SQLOperation*)(m_queue->dequeue());
+        request = next ? next : (SQLOperation*)(m_queue->dequeue());
+        next = nullptr;
         if (!request)
             break;
 
         request->SetConnection(m_conn);
-        request->call();
 
-        delete request;
+        if (!request->CanGroup())
+        {
+            request->call();
+
+            delete request;
+            continue;
+        }
+
+        // Transactions and one-way statements already waiting in the queue are committed together,
+        // saving a commit (and its log flush) per operation. The first operation that can't be grouped
+        // is kept for the next iteration, so the queue order is respected.
+        group.push_back(request);
+        while (group.size() < MAX_GROUPED_OPERATIONS)
+        {
+            SQLOperation* op = (SQLOperation*)(m_queue->dequeue((ACE_Time_Value*)&ACE_Time_Value::zero));
+            if (!op)
+                break;
+
+            op->SetConnection(m_conn);
+            if (!op->CanGroup())
+            {
+                next = op;
+                break;
+            }
+
+            group.push_back(op);
+        }
+
+        ExecuteGroup(group);
+
+        for (SQLOperation* op : group)
+            delete op;
+        group.clear();
     }
 
     return 0;
 }
+
+void DatabaseWorker::ExecuteGroup(std::vector<SQLOperation*>& group)
+{
+    if (group.size() == 1)
+    {
+        group.front()->call();
+        return;
+    }
+
+    m_conn->BeginTransaction();
+
+    // A lost connection is reopened and the failing call repeated on the new one, without the transaction
+    // the lost connection had open, so every step checks whether that happened.
+    uint32 reconnects = m_conn->GetReconnectCount();
+    size_t executed = 0;
+    while (executed < group.size() && group[executed]->ExecuteInGroup() && m_conn->GetReconnectCount() == reconnects)
+        ++executed;
+
+    if (m_conn->GetReconnectCount() != reconnects)
+    {
+        // The operations before were rolled back with the lost connection and the ones after haven't run,
+        // both run on their own. The operation that lost it was repeated outside the transaction from the
+        // failing statement on, running it again could apply its statements twice.
+        sLog->outError("DatabaseWorker: connection lost during a group of %u operations, operation %u may be partially applied.",
+                       uint32(group.size()), uint32(executed + 1));
+        for (size_t i = 0; i < group.size(); ++i)
+            if (i != executed)
+                group[i]->call();
+        return;
+    }
+
+    if (executed == group.size())
+    {
+        bool committed = m_conn->CommitTransaction();
+        if (m_conn->GetReconnectCount() != reconnects)
+        {
+            // The COMMIT may have been applied before the connection was lost, running the group again could apply it twice
+            sLog->outError("DatabaseWorker: connection lost on the COMMIT of a group of %u operations, it may not have been applied.",
+                           uint32(group.size()));
+            return;
+        }
+
+        if (committed)
+        {
+            ++m_groupCommits;
+            m_groupedOperations += group.size();
+            return;
+        }
+    }
+
+    // An operation or the COMMIT failed on an open connection, the whole group is undone. Run every operation
+    // on its own, so a failure only affects its own operation, with the usual deadlock retries.
+    m_conn->RollbackTransaction();
+
+    for (SQLOperation* op : group)
+        op->call();
+}
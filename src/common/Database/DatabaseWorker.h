@@ -7,10 +7,14 @@
 #ifndef _WORKERTHREAD_H
 #define _WORKERTHREAD_H
 
+#include "Define.h"
 #include <ace/Task.h>
 #include <ace/Activation_Queue.h>
+#include <atomic>
+#include <vector>
 
 class MySQLConnection;
+class SQLOperation;
 
 class DatabaseWorker : protected ACE_Task_Base
 {
@@ -21,10 +25,21 @@ public:
     int svc() override;
     int wait() override { return ACE_Task_Base::wait(); }
 
+    uint64 GetGroupCommitCount() const { return m_groupCommits; }
+    uint64 GetGroupedOperationCount() const { return m_groupedOperations; }
+
 private:
+    //! Max number of queued one-way operations committed together.
+    static constexpr size_t MAX_GROUPED_OPERATIONS = 64;
+
+    void ExecuteGroup(std::vector<SQLOperation*>& group);
+
     DatabaseWorker() : ACE_Task_Base() { }
     ACE_Activation_Queue* m_queue;
     MySQLConnection* m_conn;
+
+    std::atomic<uint64> m_groupCommits;
+    std::atomic<uint64> m_groupedOperations;
 };
 
 #endif
@@ -141,11 +141,46 @@ void DatabaseWorkerPool<T>::DirectExecute(PreparedStatement* stmt)
 template <class T>
 QueryResult DatabaseWorkerPool<T>::Query(const char* sql, T* conn /* = nullptr*/)
 {
+    bool snapshot = _snapshot && QuerySnapshot::CanStore(sql);
+
+    QuerySnapshot::Result stored;
+    if (snapshot && _snapshot->Find(sql, stored))
+    {
+        if (!stored.RowCount)
+            return QueryResult(nullptr);
+
+        ResultSet* result = new ResultSet(_snapshot->GetOwner(), stored);
+        result->NextRow();
+        return QueryResult(result);
+    }
+
     if (!conn)
         conn = GetFreeConnection();
 
+    // the tables get their checksum before the query reads them, a change made in between only drops the snapshot later
+    if (snapshot)
+    {
+        std::lock_guard<std::mutex> guard(_snapshotChecksumLock);
+        std::vector<std::string> tables = _snapshot->GetTablesWithoutChecksum(sql);
+        QuerySnapshot::TableChecksums checksums;
+        if (ChecksumTables(conn, tables, checksums))
+            _snapshot->SetChecksums(checksums);
+        else
+            snapshot = false;
+    }
+
     ResultSet* result = conn->Query(sql);
     conn->Unlock();
+
+    // empty results cannot be told apart from errors here, their queries always go to the database
+    if (snapshot && result)
+    {
+        std::vector<uint32> types;
+        std::string rows;
+        result->CopyRows(types, rows);
+        _snapshot->Record(sql, result->GetFieldCount(), result->GetRowCount(), types, rows);
+    }
+
     if (!result || !result->GetRowCount())
     {
         delete result;
@@ -323,6 +358,169 @@ T* DatabaseWorkerPool<T>::GetFreeConnection()
     return t;
 }
 
+template <class T>
+void DatabaseWorkerPool<T>::GetStatementStats(std::vector<PreparedStatementStats>& stats) const
+{
+    stats.clear();
+
+    for (uint8 type = 0; type < IDX_SIZE; ++type)
+    {
+        for (T const* t : _connections[type])
+        {
+            for (uint32 index = 0; index < t->m_statementCounters.size(); ++index)
+            {
+                uint64 count = t->m_statementCounters[index].Count;
+                if (!count)
+                    continue;
+
+                if (stats.size() <= index)
+                    stats.resize(index + 1, { 0, 0, 0, std::string() });
+
+                PreparedStatementStats& stat = stats[index];
+                stat.Index = index;
+                stat.Count += count;
+                stat.Time += t->m_statementCounters[index].Time;
+                if (stat.Query.empty())
+                {
+                    auto itr = t->m_queries.find(index);
+                    if (itr != t->m_queries.end())
+                        stat.Query = itr->second.first;
+                }
+            }
+        }
+    }
+
+    stats.erase(std::remove_if(stats.begin(), stats.end(), [](PreparedStatementStats const& stat) { return !stat.Count; }), stats.end());
+    std::sort(stats.begin(), stats.end(), [](PreparedStatementStats const& left, PreparedStatementStats const& right) { return left.Time > right.Time; });
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::GetGroupCommitStats(uint64& commits, uint64& operations) const
+{
+    commits = 0;
+    operations = 0;
+
+    for (T const* t : _connections[IDX_ASYNC])
+    {
+        commits += t->m_worker->GetGroupCommitCount();
+        operations += t->m_worker->GetGroupedOperationCount();
+    }
+}
+
+template <class T>
+bool DatabaseWorkerPool<T>::ChecksumTables(T* conn, std::vector<std::string> const& tables, QuerySnapshot::TableChecksums& checksums)
+{
+    if (tables.empty())
+        return true;
+
+    std::string sql = "CHECKSUM TABLE ";
+    for (size_t i = 0; i < tables.size(); ++i)
+        sql += (i ? ", `" : "`") + tables[i] + "`";
+
+    ResultSet* result = conn->Query(sql.c_str());
+    if (!result)
+        return false;
+
+    while (result->NextRow())
+    {
+        Field* fields = result->Fetch();
+        // named database.table, a missing table has no checksum
+        std::string table = fields[0].GetString();
+        checksums[table.substr(table.find('.') + 1)] = fields[1].IsNull() ? std::string("-") : fields[1].GetString();
+    }
+
+    delete result;
+    return checksums.size() == tables.size();
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::StartSnapshot(std::string const& path)
+{
+    QueryResult result = Query("SELECT TABLE_NAME FROM information_schema.TABLES WHERE TABLE_SCHEMA = DATABASE()");
+    if (!result)
+        return;
+
+    // the versions of the database updates drop the snapshot after an update without asking for any checksum
+    uint64 key = QuerySnapshot::Hash(nullptr, 0);
+    std::vector<std::string> tables;
+    std::vector<std::string> versionTables;
+    do
+    {
+        std::string table = result->Fetch()[0].GetString();
+        tables.push_back(table);
+        if (table.compare(0, 11, "version_db_") == 0)
+            versionTables.push_back(table);
+    } while (result->NextRow());
+
+    std::sort(versionTables.begin(), versionTables.end());
+    for (std::string const& table : versionTables)
+    {
+        if (QueryResult version = Query(("SELECT * FROM `" + table + "`").c_str()))
+        {
+            do
+            {
+                Field* fields = version->Fetch();
+                for (uint32 i = 0; i < version->GetFieldCount(); ++i)
+                {
+                    std::string value = (fields[i].IsNull() ? std::string("-") : fields[i].GetString()) + ":";
+                    key = QuerySnapshot::Hash(value.c_str(), value.size(), key);
+                }
+            } while (version->NextRow());
+        }
+    }
+
+    _snapshot = std::make_unique<QuerySnapshot>(path, key);
+    _snapshot->SetTableNames(tables);
+    if (!_snapshot->Load())
+    {
+        sLog->outSQLDriver("DatabasePool '%s': no valid snapshot '%s' for the current database update versions, recording startup queries.", GetDatabaseName(), path.c_str());
+        return;
+    }
+
+    QuerySnapshot::TableChecksums const& stored = _snapshot->GetChecksums();
+    std::vector<std::string> storedTables;
+    for (auto const& checksum : stored)
+        storedTables.push_back(checksum.first);
+
+    QuerySnapshot::TableChecksums current;
+    T* conn = GetFreeConnection();
+    bool checked = ChecksumTables(conn, storedTables, current);
+    conn->Unlock();
+
+    if (!checked)
+    {
+        sLog->outSQLDriver("DatabasePool '%s': could not checksum the tables of snapshot '%s', recording startup queries.", GetDatabaseName(), path.c_str());
+        _snapshot->Unload();
+        return;
+    }
+
+    for (auto const& checksum : stored)
+    {
+        if (current[checksum.first] != checksum.second)
+        {
+            sLog->outSQLDriver("DatabasePool '%s': table '%s' changed since snapshot '%s' was written, recording startup queries.", GetDatabaseName(), checksum.first.c_str(), path.c_str());
+            _snapshot->Unload();
+            return;
+        }
+    }
+
+    sLog->outSQLDriver("DatabasePool '%s': reading startup queries from snapshot '%s', keyed on the database update versions and CHECKSUM TABLE of its %u tables.",
+        GetDatabaseName(), path.c_str(), uint32(stored.size()));
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::FinishSnapshot()
+{
+    if (!_snapshot)
+        return;
+
+    std::unique_ptr<QuerySnapshot> snapshot = std::move(_snapshot);
+    sLog->outString(">> Startup snapshot of %s: %u queries read from it, %u from the database", GetDatabaseName(), snapshot->GetHits(), snapshot->GetRecorded());
+
+    if (!snapshot->Save())
+        sLog->outError("DatabasePool '%s': could not write startup snapshot.", GetDatabaseName());
+}
+
 template class DatabaseWorkerPool<LoginDatabaseConnection>;
 template class DatabaseWorkerPool<WorldDatabaseConnection>;
 template class DatabaseWorkerPool<CharacterDatabaseConnection>;
@@ -17,6 +17,7 @@
 #include "PreparedStatement.h"
 #include "Log.h"
 #include "QueryResult.h"
+#include "QuerySnapshot.h"
 #include "QueryHolder.h"
 #include "AdhocStatement.h"
 #include "StringFormat.h"
@@ -31,6 +32,15 @@ class PingOperation : public SQLOperation
     }
 };
 
+//! Summed execution counters of one prepared statement over all connections of a pool.
+struct PreparedStatementStats
+{
+    uint32 Index;
+    uint64 Count;
+    uint64 Time;                                            //! Microseconds
+    std::string Query;
+};
+
 template <class T>
 class DatabaseWorkerPool
 {
@@ -204,6 +214,18 @@ public:
         return _connectionInfo.database.c_str();
     }
 
+    //! Fills stats with the executed prepared statements of all connections, by total execution time descending.
+    void GetStatementStats(std::vector<PreparedStatementStats>& stats) const;
+
+    //! Number of commits made by the async workers for grouped operations, and the operations they held.
+    void GetGroupCommitStats(uint64& commits, uint64& operations) const;
+
+    //! Answers synchronous string queries from the snapshot file at path while CHECKSUM TABLE still gives the values it
+    //! holds for the tables its queries read, queries it does not hold go to the database and their results are added
+    //! to it by FinishSnapshot().
+    void StartSnapshot(std::string const& path);
+    void FinishSnapshot();
+
     void EscapeString(std::string& str)
     {
         if (str.empty())
@@ -225,6 +247,9 @@ private:
     //! Caller MUST call t->Unlock() after touching the MySQL context to prevent deadlocks.
     T* GetFreeConnection();
 
+    //! Runs CHECKSUM TABLE for the tables on a locked connection, false when it failed or missed one.
+    bool ChecksumTables(T* conn, std::vector<std::string> const& tables, QuerySnapshot::TableChecksums& checksums);
+
 private:
     enum _internalIndex
     {
@@ -238,6 +263,8 @@ private:
     std::vector<std::vector<T*>>    _connections;
     uint32                          _connectionCount[2];       //! Counter of MySQL connections;
     MySQLConnectionInfo             _connectionInfo;
+    std::unique_ptr<QuerySnapshot>  _snapshot;                 //! Only set while loading at startup.
+    std::mutex                      _snapshotChecksumLock;     //! One checksum per table, taken before any query reads it.
 };
 
 #endif
@@ -25,6 +25,7 @@
 
 MySQLConnection::MySQLConnection(MySQLConnectionInfo& connInfo) :
     m_reconnecting(false),
+    m_reconnects(0),
     m_prepareError(false),
     m_queue(nullptr),
     m_worker(nullptr),
@@ -36,6 +37,7 @@ MySQLConnection::MySQLConnection(MySQLConnectionInfo& connInfo) :
 
 MySQLConnection::MySQLConnection(ACE_Activation_Queue* queue, MySQLConnectionInfo& connInfo) :
     m_reconnecting(false),
+    m_reconnects(0),
     m_prepareError(false),
     m_queue(queue),
     m_Mysql(nullptr),
@@ -164,9 +166,24 @@ bool MySQLConnection::Open()
 bool MySQLConnection::PrepareStatements()
 {
     DoPrepareStatements();
+
+    // sized once, reconnections keep the counters
+    if (m_statementCounters.size() != m_stmts.size())
+        m_statementCounters = std::vector<PreparedStatementCounters>(m_stmts.size());
+
     return !m_prepareError;
 }
 
+void MySQLConnection::RecordStatement(uint32 index, std::chrono::steady_clock::time_point start)
+{
+    if (index >= m_statementCounters.size())
+        return;
+
+    PreparedStatementCounters& counters = m_statementCounters[index];
+    ++counters.Count;
+    counters.Time += std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
 bool MySQLConnection::Execute(const char* sql)
 {
     if (!m_Mysql)
@@ -215,6 +232,7 @@ bool MySQLConnection::Execute(PreparedStatement* stmt)
         MYSQL_STMT* msql_STMT = m_mStmt->GetSTMT();
         MYSQL_BIND* msql_BIND = m_mStmt->GetBind();
 
+        auto startTime = std::chrono::steady_clock::now();
         uint32 _s = 0;
         if (sLog->GetSQLDriverQueryLogging())
             _s = getMSTime();
@@ -247,6 +265,7 @@ bool MySQLConnection::Execute(PreparedStatement* stmt)
             sLog->outSQLDriver("[%u ms] SQL(p): %s", getMSTimeDiff(_s, getMSTime()), m_mStmt->getQueryString(m_queries[index].first).c_str());
 
         m_mStmt->ClearParameters();
+        RecordStatement(index, startTime);
         return true;
     }
 }
@@ -268,6 +287,7 @@ bool MySQLConnection::_Query(PreparedStatement* stmt, MYSQL_RES** pResult, uint6
         MYSQL_STMT* msql_STMT = m_mStmt->GetSTMT();
         MYSQL_BIND* msql_BIND = m_mStmt->GetBind();
 
+        auto startTime = std::chrono::steady_clock::now();
         uint32 _s = 0;
         if (sLog->GetSQLDriverQueryLogging())
             _s = getMSTime();
@@ -301,6 +321,7 @@ bool MySQLConnection::_Query(PreparedStatement* stmt, MYSQL_RES** pResult, uint6
             sLog->outSQLDriver("[%u ms] SQL(p): %s", getMSTimeDiff(_s, getMSTime()), m_mStmt->getQueryString(m_queries[index].first).c_str());
 
         m_mStmt->ClearParameters();
+        RecordStatement(index, startTime);
 
         *pResult = mysql_stmt_result_metadata(msql_STMT);
         *pRowCount = mysql_stmt_num_rows(msql_STMT);
@@ -381,19 +402,37 @@ void MySQLConnection::RollbackTransaction()
     Execute("ROLLBACK");
 }
 
-void MySQLConnection::CommitTransaction()
+bool MySQLConnection::CommitTransaction()
 {
-    Execute("COMMIT");
+    return Execute("COMMIT");
 }
 
 bool MySQLConnection::ExecuteTransaction(SQLTransaction& transaction)
 {
-    std::list<SQLElementData> const& queries = transaction->m_queries;
-    if (queries.empty())
+    if (transaction->m_queries.empty())
         return false;
 
     BeginTransaction();
 
+    if (!ExecuteTransactionStatements(transaction))
+    {
+        RollbackTransaction();
+        return false;
+    }
+
+    // we might encounter errors during certain queries, and depending on the kind of error
+    // we might want to restart the transaction. So to prevent data loss, we only clean up when it's all done.
+    // This is done in calling functions DatabaseWorkerPool<T>::DirectCommitTransaction and TransactionTask::Execute,
+    // and not while iterating over every element.
+
+    CommitTransaction();
+    return true;
+}
+
+bool MySQLConnection::ExecuteTransactionStatements(SQLTransaction& transaction)
+{
+    std::list<SQLElementData> const& queries = transaction->m_queries;
+
     std::list<SQLElementData>::const_iterator itr;
     for (itr = queries.begin(); itr != queries.end(); ++itr)
     {
@@ -407,7 +446,6 @@ bool MySQLConnection::ExecuteTransaction(SQLTransaction& transaction)
                 if (!Execute(stmt))
                 {
                     sLog->outSQLDriver("[Warning] Transaction aborted. %u queries not executed.", (uint32)queries.size());
-                    RollbackTransaction();
                     return false;
                 }
             }
@@ -419,7 +457,6 @@ bool MySQLConnection::ExecuteTransaction(SQLTransaction& transaction)
                 if (!Execute(sql))
                 {
                     sLog->outSQLDriver("[Warning] Transaction aborted. %u queries not executed.", (uint32)queries.size());
-                    RollbackTransaction();
                     return false;
                 }
             }
@@ -427,12 +464,6 @@ bool MySQLConnection::ExecuteTransaction(SQLTransaction& transaction)
         }
     }
 
-    // we might encounter errors during certain queries, and depending on the kind of error
-    // we might want to restart the transaction. So to prevent data loss, we only clean up when it's all done.
-    // This is done in calling functions DatabaseWorkerPool<T>::DirectCommitTransaction and TransactionTask::Execute,
-    // and not while iterating over every element.
-
-    CommitTransaction();
     return true;
 }
 
@@ -527,6 +558,7 @@ bool MySQLConnection::_HandleMySQLErrno(uint32 errNo)
                                        (m_connectionFlags & CONNECTION_ASYNC) ? "asynchronous" : "synchronous");
 
                 m_reconnecting = false;
+                ++m_reconnects;
                 return true;
             }
 
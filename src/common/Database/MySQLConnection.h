@@ -5,6 +5,8 @@
  */
 
 #include <ace/Activation_Queue.h>
+#include <atomic>
+#include <chrono>
 
 #include "DatabaseWorkerPool.h"
 #include "Transaction.h"
@@ -53,6 +55,13 @@ struct MySQLConnectionInfo
 
 typedef std::map<uint32 /*index*/, std::pair<std::string /*query*/, ConnectionFlags /*sync/async*/>> PreparedStatementMap;
 
+//! Execution counters of one prepared statement on one connection, read by DatabaseWorkerPool::GetStatementStats.
+struct PreparedStatementCounters
+{
+    std::atomic<uint64> Count{0};
+    std::atomic<uint64> Time{0};                            //! Microseconds
+};
+
 class MySQLConnection
 {
     template <class T> friend class DatabaseWorkerPool;
@@ -76,13 +85,17 @@ public:
 
     void BeginTransaction();
     void RollbackTransaction();
-    void CommitTransaction();
+    bool CommitTransaction();
     bool ExecuteTransaction(SQLTransaction& transaction);
+    //! Executes the statements of the transaction in the currently open transaction, without committing or rolling back.
+    bool ExecuteTransactionStatements(SQLTransaction& transaction);
 
     operator bool () const { return m_Mysql != nullptr; }
     void Ping() { mysql_ping(m_Mysql); }
 
     uint32 GetLastError() { return mysql_errno(m_Mysql); }
+    //! Times the connection was lost and reopened, an open transaction is rolled back with it.
+    uint32 GetReconnectCount() const { return m_reconnects; }
 
 protected:
     bool LockIfReady()
@@ -105,10 +118,14 @@ protected:
     bool PrepareStatements();
     virtual void DoPrepareStatements() = 0;
 
+    void RecordStatement(uint32 index, std::chrono::steady_clock::time_point start);
+
 protected:
     std::vector<MySQLPreparedStatement*> m_stmts;         //! PreparedStatements storage
     PreparedStatementMap                 m_queries;       //! Query storage
+    std::vector<PreparedStatementCounters> m_statementCounters; //! Executions per statement index
     bool                                 m_reconnecting;  //! Are we reconnecting?
+    uint32                               m_reconnects;    //! Successful reconnections
     bool                                 m_prepareError;  //! Was there any error while preparing statements?
 
 private:
@@ -473,3 +473,8 @@ bool PreparedStatementTask::Execute()
 
     return m_conn->Execute(m_stmt);
 }
+
+bool PreparedStatementTask::ExecuteInGroup()
+{
+    return m_conn->Execute(m_stmt);
+}
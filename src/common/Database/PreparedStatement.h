@@ -148,6 +148,9 @@ public:
 
     bool Execute() override;
 
+    [[nodiscard]] bool CanGroup() const override { return !m_has_result; }
+    bool ExecuteInGroup() override;
+
 protected:
     PreparedStatement* m_stmt;
     bool m_has_result;
@@ -11,12 +11,35 @@ ResultSet::ResultSet(MYSQL_RES* result, MYSQL_FIELD* fields, uint64 rowCount, ui
     _rowCount(rowCount),
     _fieldCount(fieldCount),
     _result(result),
-    _fields(fields)
+    _fields(fields),
+    _snapshotRow(nullptr),
+    _snapshotRowsLeft(0)
 {
     _currentRow = new Field[_fieldCount];
     ASSERT(_currentRow);
 }
 
+ResultSet::ResultSet(std::shared_ptr<void const> owner, QuerySnapshot::Result const& snapshot) :
+    _rowCount(snapshot.RowCount),
+    _fieldCount(snapshot.FieldCount),
+    _result(nullptr),
+    _fields(nullptr),
+    _snapshotOwner(std::move(owner)),
+    _snapshotTypes(snapshot.FieldCount),
+    _snapshotRow(snapshot.Rows),
+    _snapshotRowsLeft(snapshot.RowCount)
+{
+    _currentRow = new Field[_fieldCount];
+    ASSERT(_currentRow);
+
+    for (uint32 i = 0; i < _fieldCount; ++i)
+    {
+        uint32 type;
+        memcpy(&type, snapshot.Types + i * sizeof(uint32), sizeof(uint32));
+        _snapshotTypes[i] = enum_field_types(type);
+    }
+}
+
 PreparedResultSet::PreparedResultSet(MYSQL_STMT* stmt, MYSQL_RES* result, uint64 rowCount, uint32 fieldCount) :
     m_rowCount(rowCount),
     m_rowPosition(0),
@@ -141,6 +164,35 @@ bool ResultSet::NextRow()
 {
     MYSQL_ROW row;
 
+    if (_snapshotOwner)
+    {
+        if (!_snapshotRowsLeft)
+        {
+            CleanUp();
+            return false;
+        }
+
+        --_snapshotRowsLeft;
+        for (uint32 i = 0; i < _fieldCount; ++i)
+        {
+            uint32 length;
+            memcpy(&length, _snapshotRow, sizeof(uint32));
+            _snapshotRow += sizeof(uint32);
+
+            if (length == QuerySnapshot::NULL_FIELD_LENGTH)
+            {
+                _currentRow[i].SetStructuredValue(nullptr, _snapshotTypes[i]);
+                continue;
+            }
+
+            // stored with their terminating zero, read in place like the rows of the MySQL library
+            _currentRow[i].SetStructuredValue(const_cast<char*>(_snapshotRow), _snapshotTypes[i]);
+            _snapshotRow += length + 1;
+        }
+
+        return true;
+    }
+
     if (!_result)
         return false;
 
@@ -185,11 +237,36 @@ bool PreparedResultSet::_NextRow()
     return retval;
 }
 
+void ResultSet::CopyRows(std::vector<uint32>& types, std::string& rows)
+{
+    types.resize(_fieldCount);
+    for (uint32 i = 0; i < _fieldCount; ++i)
+        types[i] = uint32(_fields[i].type);
+
+    while (MYSQL_ROW row = mysql_fetch_row(_result))
+    {
+        unsigned long* lengths = mysql_fetch_lengths(_result);
+        for (uint32 i = 0; i < _fieldCount; ++i)
+        {
+            uint32 length = row[i] ? uint32(lengths[i]) : QuerySnapshot::NULL_FIELD_LENGTH;
+            rows.append(reinterpret_cast<char const*>(&length), sizeof(uint32));
+            if (row[i])
+            {
+                rows.append(row[i], lengths[i]);
+                rows.push_back('\0');
+            }
+        }
+    }
+
+    // NextRow() starts again at the first row
+    mysql_data_seek(_result, 0);
+}
+
 #ifdef ELUNA
 std::string ResultSet::GetFieldName(uint32 index) const
 {
     ASSERT(index < _fieldCount);
-    return _fields[index].name;
+    return _fields ? _fields[index].name : "";
 }
 #endif
 
@@ -206,6 +283,8 @@ void ResultSet::CleanUp()
         mysql_free_result(_result);
         _result = nullptr;
     }
+
+    _snapshotOwner.reset();
 }
 
 void PreparedResultSet::CleanUp()
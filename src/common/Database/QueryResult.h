@@ -11,6 +11,7 @@
 
 #include "Errors.h"
 #include "Field.h"
+#include "QuerySnapshot.h"
 
 #ifdef _WIN32
 #include <winsock2.h>
@@ -25,8 +26,13 @@ class ResultSet
 {
 public:
     ResultSet(MYSQL_RES* result, MYSQL_FIELD* fields, uint64 rowCount, uint32 fieldCount);
+    /// Rows read from a QuerySnapshot, owner keeps their memory mapped
+    ResultSet(std::shared_ptr<void const> owner, QuerySnapshot::Result const& snapshot);
     ~ResultSet();
 
+    /// Copies all rows in the format of QuerySnapshot, called before the first NextRow()
+    void CopyRows(std::vector<uint32>& types, std::string& rows);
+
     bool NextRow();
     [[nodiscard]] uint64 GetRowCount() const { return _rowCount; }
     [[nodiscard]] uint32 GetFieldCount() const { return _fieldCount; }
@@ -49,6 +55,11 @@ private:
     void CleanUp();
     MYSQL_RES* _result;
     MYSQL_FIELD* _fields;
+
+    std::shared_ptr<void const> _snapshotOwner;
+    std::vector<enum_field_types> _snapshotTypes;
+    char const* _snapshotRow;
+    uint64 _snapshotRowsLeft;
 };
 
 typedef std::shared_ptr<ResultSet> QueryResult;
@@ -0,0 +1,354 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-GPL2
+ */
+
+#include "QuerySnapshot.h"
+#include <ace/Mem_Map.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+    char const SNAPSHOT_MAGIC[4] = { 'A', 'C', 'Q', 'S' };
+    uint32 const SNAPSHOT_VERSION = 2;
+
+    struct SnapshotHeader
+    {
+        char Magic[4];
+        uint32 Version;
+        uint64 Key;
+        uint64 PayloadHash;                                 // of everything after the header, finds damaged files
+        uint64 ResultCount;
+        uint64 TableCount;                                  // checksums of the tables, written after the results
+    };
+
+    // functions reading the database clock or random values give another result on every run
+    char const* const VolatileFunctions[] = { "NOW(", "UNIX_TIMESTAMP(", "CURDATE(", "CURTIME(", "CURRENT_", "SYSDATE(", "RAND(", "UUID(" };
+
+    /// Reads from the mapped file, false past its end
+    class Reader
+    {
+    public:
+        Reader(char const* data, uint64 size) : _pos(data), _end(data + size) { }
+
+        template <class T>
+        bool Get(T& value)
+        {
+            if (uint64(_end - _pos) < sizeof(T))
+                return false;
+
+            memcpy(&value, _pos, sizeof(T));
+            _pos += sizeof(T);
+            return true;
+        }
+
+        char const* Skip(uint64 size)
+        {
+            if (uint64(_end - _pos) < size)
+                return nullptr;
+
+            char const* data = _pos;
+            _pos += size;
+            return data;
+        }
+
+        bool GetString(std::string& value)
+        {
+            uint32 length;
+            char const* data;
+            if (!Get(length) || !(data = Skip(length)))
+                return false;
+
+            value.assign(data, length);
+            return true;
+        }
+
+        [[nodiscard]] bool AtEnd() const { return _pos == _end; }
+
+    private:
+        char const* _pos;
+        char const* _end;
+    };
+}
+
+QuerySnapshot::QuerySnapshot(std::string const& path, uint64 key) : _path(path), _key(key), _mapping(nullptr), _hits(0), _recordedCount(0),
+    _newFile(nullptr), _newPayloadHash(Hash(nullptr, 0)), _newResultCount(0), _newFileFailed(false)
+{
+}
+
+QuerySnapshot::~QuerySnapshot()
+{
+    // not saved, the new file is incomplete
+    if (_newFile)
+    {
+        CloseNewFile();
+        remove((_path + ".tmp").c_str());
+    }
+}
+
+uint64 QuerySnapshot::Hash(char const* data, size_t size, uint64 hash)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= uint8(data[i]);
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+bool QuerySnapshot::CanStore(char const* sql)
+{
+    while (isspace(uint8(*sql)))
+        ++sql;
+
+    std::string query(sql);
+    std::transform(query.begin(), query.end(), query.begin(), [](char c) { return char(toupper(uint8(c))); });
+
+    if (query.compare(0, 6, "SELECT") != 0)
+        return false;
+
+    for (char const* function : VolatileFunctions)
+        if (query.find(function) != std::string::npos)
+            return false;
+
+    return true;
+}
+
+bool QuerySnapshot::Load()
+{
+    ACE_Mem_Map* mapping = new ACE_Mem_Map();
+    if (mapping->map(_path.c_str(), static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ, ACE_MAP_SHARED) == -1 || mapping->size() < sizeof(SnapshotHeader))
+    {
+        delete mapping;
+        return false;
+    }
+
+    std::shared_ptr<ACE_Mem_Map> owner(mapping);
+    char const* data = static_cast<char const*>(mapping->addr());
+    uint64 size = mapping->size();
+
+    SnapshotHeader header;
+    memcpy(&header, data, sizeof(SnapshotHeader));
+    if (memcmp(header.Magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0 || header.Version != SNAPSHOT_VERSION || header.Key != _key)
+        return false;
+
+    if (Hash(data + sizeof(SnapshotHeader), size - sizeof(SnapshotHeader)) != header.PayloadHash)
+        return false;
+
+    std::unordered_map<std::string, Entry> index;
+    Reader reader(data + sizeof(SnapshotHeader), size - sizeof(SnapshotHeader));
+    for (uint64 i = 0; i < header.ResultCount; ++i)
+    {
+        uint32 sqlLength;
+        Entry entry;
+        char const* sql;
+        if (!reader.Get(sqlLength) || !(sql = reader.Skip(sqlLength)) ||
+            !reader.Get(entry.Data.FieldCount) || !reader.Get(entry.Data.RowCount) ||
+            !(entry.Data.Types = reader.Skip(uint64(entry.Data.FieldCount) * sizeof(uint32))) ||
+            !reader.Get(entry.RowsSize) || !(entry.Data.Rows = reader.Skip(entry.RowsSize)))
+            return false;
+
+        index[std::string(sql, sqlLength)] = entry;
+    }
+
+    TableChecksums checksums;
+    for (uint64 i = 0; i < header.TableCount; ++i)
+    {
+        std::string table;
+        if (!reader.GetString(table) || !reader.GetString(checksums[table]))
+            return false;
+    }
+
+    if (!reader.AtEnd())
+        return false;
+
+    _mapping = mapping;
+    _owner = owner;
+    _index = std::move(index);
+    _checksums = std::move(checksums);
+    return true;
+}
+
+void QuerySnapshot::Unload()
+{
+    _index.clear();
+    _checksums.clear();
+    _mapping = nullptr;
+    _owner.reset();
+}
+
+std::vector<std::string> QuerySnapshot::GetTablesWithoutChecksum(char const* sql)
+{
+    std::string query(sql);
+    std::transform(query.begin(), query.end(), query.begin(), [](char c) { return char(tolower(uint8(c))); });
+
+    auto isNamePart = [](char c) { return isalnum(uint8(c)) || c == '_' || c == '$'; };
+
+    std::vector<std::string> tables;
+    std::lock_guard<std::mutex> guard(_lock);
+    for (std::string const& table : _tableNames)
+    {
+        if (_checksums.count(table))
+            continue;
+
+        // a column of the same name adds a table that is not read, its checksum is only taken in vain
+        std::string name(table);
+        std::transform(name.begin(), name.end(), name.begin(), [](char c) { return char(tolower(uint8(c))); });
+        for (size_t pos = query.find(name); pos != std::string::npos; pos = query.find(name, pos + 1))
+        {
+            if ((pos && isNamePart(query[pos - 1])) || (pos + name.size() < query.size() && isNamePart(query[pos + name.size()])))
+                continue;
+
+            tables.push_back(table);
+            break;
+        }
+    }
+
+    return tables;
+}
+
+void QuerySnapshot::SetChecksums(TableChecksums const& checksums)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    // the first checksum was taken before any query read the table, a later one could miss a change it saw
+    _checksums.insert(checksums.begin(), checksums.end());
+}
+
+bool QuerySnapshot::Find(std::string const& sql, Result& result)
+{
+    if (!_mapping)
+        return false;
+
+    auto itr = _index.find(sql);
+    if (itr == _index.end())
+        return false;
+
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _used.insert(sql);
+    }
+
+    result = itr->second.Data;
+    ++_hits;
+    return true;
+}
+
+void QuerySnapshot::WritePayload(void const* data, size_t size)
+{
+    if (!size)
+        return;
+
+    _newPayloadHash = Hash(static_cast<char const*>(data), size, _newPayloadHash);
+    if (fwrite(data, size, 1, _newFile) != 1)
+        _newFileFailed = true;
+}
+
+void QuerySnapshot::WriteResult(std::string const& sql, uint32 fieldCount, uint64 rowCount, char const* types, char const* rows, uint64 rowsSize)
+{
+    if (!_newFile && !_newFileFailed)
+    {
+        // the header is written by Save(), once the hash and the count of the results are known
+        _newFile = fopen((_path + ".tmp").c_str(), "wb");
+        SnapshotHeader header = { };
+        if (!_newFile || fwrite(&header, sizeof(SnapshotHeader), 1, _newFile) != 1)
+            _newFileFailed = true;
+    }
+
+    if (_newFileFailed)
+        return;
+
+    uint32 sqlLength = uint32(sql.size());
+    WritePayload(&sqlLength, sizeof(sqlLength));
+    WritePayload(sql.data(), sql.size());
+    WritePayload(&fieldCount, sizeof(fieldCount));
+    WritePayload(&rowCount, sizeof(rowCount));
+    WritePayload(types, fieldCount * sizeof(uint32));
+    WritePayload(&rowsSize, sizeof(rowsSize));
+    WritePayload(rows, rowsSize);
+    ++_newResultCount;
+}
+
+void QuerySnapshot::CloseNewFile()
+{
+    if (fclose(_newFile) != 0)
+        _newFileFailed = true;
+    _newFile = nullptr;
+}
+
+void QuerySnapshot::Record(std::string const& sql, uint32 fieldCount, uint64 rowCount, std::vector<uint32> const& types, std::string const& rows)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    if (!_recorded.insert(sql).second)
+        return;
+
+    WriteResult(sql, fieldCount, rowCount, reinterpret_cast<char const*>(types.data()), rows.data(), rows.size());
+    _recordedCount = uint32(_recorded.size());
+}
+
+bool QuerySnapshot::Save()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    if (_recorded.empty())
+        return true;
+
+    // results of the old file that were still asked for are written again, the others are dropped
+    for (std::string const& sql : _used)
+    {
+        if (_recorded.count(sql))
+            continue;
+
+        Entry const& entry = _index[sql];
+        WriteResult(sql, entry.Data.FieldCount, entry.Data.RowCount, entry.Data.Types, entry.Data.Rows, entry.RowsSize);
+    }
+
+    // the checksums of the old file were checked at startup, so they hold for the results written again as well
+    if (_newFile)
+    {
+        for (auto const& checksum : _checksums)
+        {
+            uint32 length = uint32(checksum.first.size());
+            WritePayload(&length, sizeof(length));
+            WritePayload(checksum.first.data(), checksum.first.size());
+            length = uint32(checksum.second.size());
+            WritePayload(&length, sizeof(length));
+            WritePayload(checksum.second.data(), checksum.second.size());
+        }
+    }
+
+    uint64 tableCount = _checksums.size();
+
+    // the old file is not read anymore, it can be replaced
+    Unload();
+    _used.clear();
+    _recorded.clear();
+
+    std::string tempPath = _path + ".tmp";
+    if (_newFile)
+    {
+        SnapshotHeader header;
+        memcpy(header.Magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+        header.Version = SNAPSHOT_VERSION;
+        header.Key = _key;
+        header.PayloadHash = _newPayloadHash;
+        header.ResultCount = _newResultCount;
+        header.TableCount = tableCount;
+
+        if (fseek(_newFile, 0, SEEK_SET) != 0 || fwrite(&header, sizeof(SnapshotHeader), 1, _newFile) != 1)
+            _newFileFailed = true;
+
+        CloseNewFile();
+    }
+
+    // a server stopped while writing leaves no half written snapshot behind
+    remove(_path.c_str());
+    if (_newFileFailed || rename(tempPath.c_str(), _path.c_str()) != 0)
+    {
+        remove(tempPath.c_str());
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-GPL2
+ */
+
+#ifndef QUERYSNAPSHOT_H
+#define QUERYSNAPSHOT_H
+
+#include "Define.h"
+#include <atomic>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class ACE_Mem_Map;
+
+/// Results of the text queries made while loading static tables, written to a file after one startup and
+/// mapped into memory on the next ones instead of asking the database again. The file holds the CHECKSUM TABLE
+/// values of the tables its queries read, taken before they were first read, and is only used while the tables
+/// still have them. Its key, a hash of the versions of the database updates, drops it without asking for them.
+/// Rows are kept in the format ResultSet reads: for each field its length, 0xFFFFFFFF for NULL, then its
+/// bytes and a terminating zero.
+/// Results answered by the database are written to the new file as they are recorded, so they are not kept in memory
+/// until the end of the startup.
+class QuerySnapshot
+{
+public:
+    static constexpr uint32 NULL_FIELD_LENGTH = 0xFFFFFFFF;
+
+    struct Result
+    {
+        uint32 FieldCount;
+        uint64 RowCount;
+        char const* Types;                                  // FieldCount uint32, not aligned
+        char const* Rows;
+    };
+
+    /// CHECKSUM TABLE value of each table, as text
+    typedef std::map<std::string, std::string> TableChecksums;
+
+    QuerySnapshot(std::string const& path, uint64 key);
+    ~QuerySnapshot();
+
+    QuerySnapshot(QuerySnapshot const&) = delete;
+    QuerySnapshot& operator=(QuerySnapshot const&) = delete;
+
+    /// Maps the file and indexes its results, false when it is missing, damaged or made for another key
+    bool Load();
+    [[nodiscard]] bool IsLoaded() const { return _mapping != nullptr; }
+    /// Drops the loaded file, when the tables changed since it was written
+    void Unload();
+
+    /// Checksums of the tables read by the queries of the loaded file, to be compared with the current ones
+    [[nodiscard]] TableChecksums const& GetChecksums() const { return _checksums; }
+
+    /// Names of the tables of the database, queries naming one of them read it
+    void SetTableNames(std::vector<std::string> const& tables) { _tableNames = tables; }
+    /// Tables read by a query that have no checksum yet, they must get one before the query reads them
+    std::vector<std::string> GetTablesWithoutChecksum(char const* sql);
+    void SetChecksums(TableChecksums const& checksums);
+
+    /// Only reads whose result depends on nothing but the tables are kept
+    static bool CanStore(char const* sql);
+
+    /// Finds the result of a query in the loaded file, the memory stays valid while GetOwner() is held
+    bool Find(std::string const& sql, Result& result);
+    [[nodiscard]] std::shared_ptr<void const> const& GetOwner() const { return _owner; }
+
+    /// Writes the result of a query answered by the database to the new file
+    void Record(std::string const& sql, uint32 fieldCount, uint64 rowCount, std::vector<uint32> const& types, std::string const& rows);
+
+    /// Adds the results found since Load() to the new file and replaces the old one with it, when any were recorded
+    bool Save();
+
+    [[nodiscard]] uint32 GetHits() const { return _hits; }
+    [[nodiscard]] uint32 GetRecorded() const { return _recordedCount; }
+
+    /// 64 bit FNV-1a, to build the key from the contents of the tables
+    static uint64 Hash(char const* data, size_t size, uint64 hash = 14695981039346656037ULL);
+
+private:
+    // writes a result to _newFile, with _lock held
+    void WriteResult(std::string const& sql, uint32 fieldCount, uint64 rowCount, char const* types, char const* rows, uint64 rowsSize);
+    void WritePayload(void const* data, size_t size);
+    void CloseNewFile();
+
+    struct Entry
+    {
+        Result Data;
+        uint64 RowsSize;
+    };
+
+    std::string _path;
+    uint64 _key;
+
+    ACE_Mem_Map* _mapping;
+    std::shared_ptr<void const> _owner;                     // unmaps the file when the last result read from it is gone
+    std::unordered_map<std::string, Entry> _index;
+
+    std::mutex _lock;                                       // loaders query from several threads
+    std::unordered_set<std::string> _used;
+    std::unordered_set<std::string> _recorded;
+    std::vector<std::string> _tableNames;
+    TableChecksums _checksums;
+    FILE* _newFile;                                         // written aside and renamed by Save()
+    uint64 _newPayloadHash;
+    uint64 _newResultCount;
+    bool _newFileFailed;
+    std::atomic<uint32> _hits;
+    std::atomic<uint32> _recordedCount;
+};
+
+#endif
@@ -57,6 +57,12 @@ public:
     virtual bool Execute() = 0;
     virtual void SetConnection(MySQLConnection* con) { m_conn = con; }
 
+    //! One-way operations that may share a single commit with other queued ones, see DatabaseWorker::svc.
+    [[nodiscard]] virtual bool CanGroup() const { return false; }
+
+    //! Executes the operation inside a transaction opened by the worker, without committing.
+    virtual bool ExecuteInGroup() { return false; }
+
     MySQLConnection* m_conn;
 };
 
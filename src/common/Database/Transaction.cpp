@@ -79,3 +79,9 @@ bool TransactionTask::Execute()
 
     return false;
 }
+
+bool TransactionTask::ExecuteInGroup()
+{
+    // failures are handled by the worker, which rolls back and runs every grouped operation on its own
+    return m_conn->ExecuteTransactionStatements(m_trans);
+}
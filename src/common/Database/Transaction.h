@@ -53,6 +53,9 @@ public:
     TransactionTask(SQLTransaction trans) : m_trans(std::move(trans)) { } ;
     ~TransactionTask() override = default;
 
+    [[nodiscard]] bool CanGroup() const override { return true; }
+    bool ExecuteInGroup() override;
+
 protected:
     bool Execute() override;
 
@@ -10,10 +10,12 @@
 #include "Configuration/Config.h"
 #include "Util.h"
 #include "SHA1.h"
+#include "StringFormat.h"
 
 #include "Implementation/LoginDatabase.h" // For logging
 extern LoginDatabaseWorkerPool LoginDatabase;
 
+#include <algorithm>
 #include <stdarg.h>
 #include <stdio.h>
 
@@ -27,6 +29,9 @@ Log::Log() :
 
 Log::~Log()
 {
+    // writes the queued records before the files are closed
+    m_writer.reset();
+
     if (logfile != nullptr)
         fclose(logfile);
     logfile = nullptr;
@@ -170,6 +175,13 @@ void Log::Initialize()
             if ((m_dumpsDir.at(m_dumpsDir.length() - 1) != '/') && (m_dumpsDir.at(m_dumpsDir.length() - 1) != '\\'))
                 m_dumpsDir.push_back('/');
     }
+
+    if (sConfigMgr->GetOption<bool>("Log.Async.Enable", false, false))
+    {
+        LogOverflowPolicy policy = sConfigMgr->GetOption<int32>("Log.Async.Overflow", LOG_OVERFLOW_WAIT, false) == LOG_OVERFLOW_DROP ? LOG_OVERFLOW_DROP : LOG_OVERFLOW_WAIT;
+        m_writer = std::make_unique<LogWriter>(sConfigMgr->GetOption<uint32>("Log.Async.QueueSize", 4096, false), policy,
+            [this](std::vector<LogRecord*> const& records, uint64 droppedRecords) { writeRecords(records, droppedRecords); });
+    }
 }
 
 void Log::ReloadConfig()
@@ -211,15 +223,20 @@ FILE* Log::openGmlogPerAccount(uint32 account)
 
 void Log::outTimestamp(FILE* file)
 {
-    time_t t = time(nullptr);
-    tm* aTm = localtime(&t);
+    outTimestamp(file, time(nullptr));
+}
+
+void Log::outTimestamp(FILE* file, time_t t)
+{
+    tm aTm;
+    localtime_r(&t, &aTm);
     //       YYYY   year
     //       MM     month (2 digits 01-12)
     //       DD     day (2 digits 01-31)
     //       HH     hour (2 digits 00-23)
     //       MM     minutes (2 digits 00-59)
     //       SS     seconds (2 digits 00-59)
-    fprintf(file, "%-4d-%02d-%02d %02d:%02d:%02d ", aTm->tm_year + 1900, aTm->tm_mon + 1, aTm->tm_mday, aTm->tm_hour, aTm->tm_min, aTm->tm_sec);
+    fprintf(file, "%-4d-%02d-%02d %02d:%02d:%02d ", aTm.tm_year + 1900, aTm.tm_mon + 1, aTm.tm_mday, aTm.tm_hour, aTm.tm_min, aTm.tm_sec);
 }
 
 void Log::InitColors(const std::string& str)
@@ -357,11 +374,175 @@ std::string Log::GetTimestampStr()
     return std::string(buf);
 }
 
+void Log::SetLogDB(bool enable)
+{
+    // queued records are written while the database is still there
+    if (!enable && m_writer)
+        m_writer->Flush();
+
+    m_enableLogDB = enable;
+}
+
+std::string Log::formatLogText(char const* format, va_list ap)
+{
+    char buffer[1024];
+
+    va_list ap2;
+    va_copy(ap2, ap);
+    int length = vsnprintf(buffer, sizeof(buffer), format, ap2);
+    va_end(ap2);
+
+    if (length < 0)
+        return std::string();
+
+    if (size_t(length) < sizeof(buffer))
+        return std::string(buffer, length);
+
+    std::string text(length, '\0');
+    vsnprintf(&text[0], length + 1, format, ap);
+    return text;
+}
+
+void Log::writeConsole(bool stdout_stream, int8 color, std::string const& text, bool newLine)
+{
+    LogRecord record(LOG_RECORD_CONSOLE, std::string(text));
+    record.Stream = stdout_stream ? stdout : stderr;
+    record.Color = color;
+    record.NewLine = newLine;
+    writeRecord(std::move(record));
+}
+
+void Log::writeFile(FILE* file, char const* prefix, std::string const& text, bool timestamp, bool newLine)
+{
+    if (!file)
+        return;
+
+    LogRecord record(LOG_RECORD_FILE, std::string(text));
+    record.Stream = file;
+    record.Prefix = prefix;
+    record.Timestamp = timestamp;
+    record.NewLine = newLine;
+    writeRecord(std::move(record));
+}
+
+void Log::writeRecord(LogRecord&& record)
+{
+    if (m_writer)
+    {
+        m_writer->Push(new LogRecord(std::move(record)));
+        return;
+    }
+
+    writeRecordNow(record);
+    if (record.Stream)
+        fflush(record.Stream);
+}
+
+void Log::writeRecordNow(LogRecord const& record)
+{
+    switch (record.Type)
+    {
+        case LOG_RECORD_CONSOLE:
+            if (record.Color >= 0)
+                SetColor(record.Stream == stdout, ColorTypes(record.Color));
+
+            utf8printf(record.Stream, "%s", record.Text.c_str());
+
+            if (record.Color >= 0)
+                ResetColor(record.Stream == stdout);
+
+            if (record.NewLine)
+                fputc('\n', record.Stream);
+            break;
+        case LOG_RECORD_FILE:
+            if (record.Timestamp)
+                outTimestamp(record.Stream, record.Time);
+
+            fputs(record.Prefix, record.Stream);
+            fputs(record.Text.c_str(), record.Stream);
+
+            if (record.NewLine)
+                fputc('\n', record.Stream);
+            break;
+        case LOG_RECORD_GM_ACCOUNT:
+            if (FILE* per_file = openGmlogPerAccount(record.Value))
+            {
+                outTimestamp(per_file, record.Time);
+                fprintf(per_file, "%s\n", record.Text.c_str());
+                fclose(per_file);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void Log::writeRecords(std::vector<LogRecord*> const& records, uint64 droppedRecords)
+{
+    std::vector<FILE*> streams;
+    std::string dbQuery;
+
+    for (LogRecord const* record : records)
+    {
+        if (record->Type != LOG_RECORD_DB)
+        {
+            writeRecordNow(*record);
+            if (record->Stream && std::find(streams.begin(), streams.end(), record->Stream) == streams.end())
+                streams.push_back(record->Stream);
+            continue;
+        }
+
+        // database records of the batch are inserted together
+        std::string text(record->Text);
+        LoginDatabase.EscapeString(text);
+
+        dbQuery += dbQuery.empty() ? "INSERT INTO logs (time, realm, type, string) VALUES " : ", ";
+        dbQuery += acore::StringFormat("(" UI64FMTD ", %u, %u, '%s')", uint64(record->Time), realm, record->Value, text.c_str());
+
+        if (dbQuery.size() >= MAX_QUERY_LEN / 2)
+        {
+            LoginDatabase.Execute(dbQuery.c_str());
+            dbQuery.clear();
+        }
+    }
+
+    if (!dbQuery.empty())
+        LoginDatabase.Execute(dbQuery.c_str());
+
+    if (droppedRecords)
+    {
+        std::string text = acore::StringFormat("Log: " UI64FMTD " records were dropped, the queue of a thread was full (Log.Async.QueueSize)", droppedRecords);
+        for (FILE* stream : { stderr, logfile })
+        {
+            if (!stream)
+                continue;
+
+            LogRecord record(stream == stderr ? LOG_RECORD_CONSOLE : LOG_RECORD_FILE, std::string(text));
+            record.Stream = stream;
+            writeRecordNow(record);
+            if (std::find(streams.begin(), streams.end(), stream) == streams.end())
+                streams.push_back(stream);
+        }
+    }
+
+    // once per batch instead of once per record
+    for (FILE* stream : streams)
+        fflush(stream);
+}
+
 void Log::outDB(LogTypes type, const char* str)
 {
     if (!str || std::string(str).empty() || type >= MAX_LOG_TYPES)
         return;
 
+    if (m_writer)
+    {
+        LogRecord* record = new LogRecord(LOG_RECORD_DB, std::string(str));
+        record->Value = type;
+        m_writer->Push(record);
+        return;
+    }
+
     std::string new_str(str);
     LoginDatabase.EscapeString(new_str);
 
@@ -374,52 +555,19 @@ void Log::outString(const char* str, ...)
     if (!str)
         return;
 
-    /*if (m_enableLogDB)
-    {
-        va_list ap2;
-        va_start(ap2, str);
-        char nnew_str[MAX_QUERY_LEN];
-        vsnprintf(nnew_str, MAX_QUERY_LEN, str, ap2);
-        outDB(LOG_TYPE_STRING, nnew_str);
-        va_end(ap2);
-    }*/
-
-    if (m_colored)
-        SetColor(true, m_colors[LOGL_NORMAL]);
-
     va_list ap;
-
     va_start(ap, str);
-    vutf8printf(stdout, str, &ap);
+    std::string text = formatLogText(str, ap);
     va_end(ap);
 
-    if (m_colored)
-        ResetColor(true);
-
-    printf("\n");
-    if (logfile)
-    {
-        outTimestamp(logfile);
-        va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        fprintf(logfile, "\n");
-        va_end(ap);
-
-        fflush(logfile);
-    }
-    fflush(stdout);
+    writeConsole(true, m_colored ? m_colors[LOGL_NORMAL] : -1, text);
+    writeFile(logfile, "", text);
 }
 
 void Log::outString()
 {
-    printf("\n");
-    if (logfile)
-    {
-        outTimestamp(logfile);
-        fprintf(logfile, "\n");
-        fflush(logfile);
-    }
-    fflush(stdout);
+    writeConsole(true, -1, "");
+    writeFile(logfile, "", "");
 }
 
 void Log::outCrash(const char* err, ...)
@@ -427,42 +575,20 @@ void Log::outCrash(const char* err, ...)
     if (!err)
         return;
 
-    if (m_enableLogDB)
-    {
-        va_list ap2;
-        va_start(ap2, err);
-        char nnew_str[MAX_QUERY_LEN];
-        vsnprintf(nnew_str, MAX_QUERY_LEN, err, ap2);
-        outDB(LOG_TYPE_CRASH, nnew_str);
-        va_end(ap2);
-    }
-
-    if (m_colored)
-        SetColor(false, LRED);
-
     va_list ap;
-
     va_start(ap, err);
-    vutf8printf(stderr, err, &ap);
+    std::string text = formatLogText(err, ap);
     va_end(ap);
 
-    if (m_colored)
-        ResetColor(false);
-
-    fprintf(stderr, "\n");
-    if (logfile)
-    {
-        outTimestamp(logfile);
-        fprintf(logfile, "CRASH ALERT: ");
+    if (m_enableLogDB)
+        outDB(LOG_TYPE_CRASH, text.c_str());
 
-        va_start(ap, err);
-        vfprintf(logfile, err, ap);
-        va_end(ap);
+    writeConsole(false, m_colored ? LRED : -1, text);
+    writeFile(logfile, "CRASH ALERT: ", text);
 
-        fprintf(logfile, "\n");
-        fflush(logfile);
-    }
-    fflush(stderr);
+    // the process is likely to end before the next writer pass
+    if (m_writer)
+        m_writer->Flush();
 }
 
 void Log::outError(const char* err, ...)
@@ -470,42 +596,16 @@ void Log::outError(const char* err, ...)
     if (!err)
         return;
 
-    if (m_enableLogDB)
-    {
-        va_list ap2;
-        va_start(ap2, err);
-        char nnew_str[MAX_QUERY_LEN];
-        vsnprintf(nnew_str, MAX_QUERY_LEN, err, ap2);
-        outDB(LOG_TYPE_ERROR, nnew_str);
-        va_end(ap2);
-    }
-
-    if (m_colored)
-        SetColor(false, LRED);
-
     va_list ap;
-
     va_start(ap, err);
-    vutf8printf(stderr, err, &ap);
+    std::string text = formatLogText(err, ap);
     va_end(ap);
 
-    if (m_colored)
-        ResetColor(false);
-
-    fprintf( stderr, "\n");
-    if (logfile)
-    {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR: ");
-
-        va_start(ap, err);
-        vfprintf(logfile, err, ap);
-        va_end(ap);
+    if (m_enableLogDB)
+        outDB(LOG_TYPE_ERROR, text.c_str());
 
-        fprintf(logfile, "\n");
-        fflush(logfile);
-    }
-    fflush(stderr);
+    writeConsole(false, m_colored ? LRED : -1, text);
+    writeFile(logfile, "ERROR: ", text);
 }
 
 void Log::outSQLDriver(const char* str, ...)
@@ -515,25 +615,11 @@ void Log::outSQLDriver(const char* str, ...)
 
     va_list ap;
     va_start(ap, str);
-    vutf8printf(stdout, str, &ap);
+    std::string text = formatLogText(str, ap);
     va_end(ap);
 
-    printf("\n");
-
-    if (sqlLogFile)
-    {
-        outTimestamp(sqlLogFile);
-
-        va_list apSQL;
-        va_start(apSQL, str);
-        vfprintf(sqlLogFile, str, apSQL);
-        va_end(apSQL);
-
-        fprintf(sqlLogFile, "\n");
-        fflush(sqlLogFile);
-    }
-
-    fflush(stdout);
+    writeConsole(true, -1, text);
+    writeFile(sqlLogFile, "", text);
 }
 
 void Log::outErrorDb(const char* err, ...)
@@ -541,54 +627,17 @@ void Log::outErrorDb(const char* err, ...)
     if (!err)
         return;
 
-    if (m_colored)
-        SetColor(false, LRED);
-
-    if (m_enableLogDB)
-    {
-        va_list ap2;
-        va_start(ap2, err);
-        char nnew_str[MAX_QUERY_LEN];
-        vsnprintf(nnew_str, MAX_QUERY_LEN, err, ap2);
-        outDB(LOG_TYPE_ERROR, nnew_str);
-        va_end(ap2);
-    }
-
     va_list ap;
-
     va_start(ap, err);
-    vutf8printf(stderr, err, &ap);
+    std::string text = formatLogText(err, ap);
     va_end(ap);
 
-    if (m_colored)
-        ResetColor(false);
-
-    fprintf( stderr, "\n" );
-
-    if (logfile)
-    {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR: " );
-
-        va_start(ap, err);
-        vfprintf(logfile, err, ap);
-        va_end(ap);
-
-        fprintf(logfile, "\n" );
-        fflush(logfile);
-    }
-
-    if (dberLogfile)
-    {
-        outTimestamp(dberLogfile);
-        va_start(ap, err);
-        vfprintf(dberLogfile, err, ap);
-        va_end(ap);
+    if (m_enableLogDB)
+        outDB(LOG_TYPE_ERROR, text.c_str());
 
-        fprintf(dberLogfile, "\n" );
-        fflush(dberLogfile);
-    }
-    fflush(stderr);
+    writeConsole(false, m_colored ? LRED : -1, text);
+    writeFile(logfile, "ERROR: ", text);
+    writeFile(dberLogfile, "", text);
 }
 
 void Log::outBasic(const char* str, ...)
@@ -596,43 +645,23 @@ void Log::outBasic(const char* str, ...)
     if (!str)
         return;
 
-    if (m_enableLogDB && m_dbLogLevel > LOGL_NORMAL)
-    {
-        va_list ap2;
-        va_start(ap2, str);
-        char nnew_str[MAX_QUERY_LEN];
-        vsnprintf(nnew_str, MAX_QUERY_LEN, str, ap2);
-        outDB(LOG_TYPE_BASIC, nnew_str);
-        va_end(ap2);
-    }
-
-    if (m_logLevel > LOGL_NORMAL)
-    {
-        if (m_colored)
-            SetColor(true, m_colors[LOGL_BASIC]);
-
-        va_list ap;
-        va_start(ap, str);
-        vutf8printf(stdout, str, &ap);
-        va_end(ap);
+    bool toDB = m_enableLogDB && m_dbLogLevel > LOGL_NORMAL;
+    if (!toDB && m_logLevel <= LOGL_NORMAL)
+        return;
 
-        if (m_colored)
-            ResetColor(true);
+    va_list ap;
+    va_start(ap, str);
+    std::string text = formatLogText(str, ap);
+    va_end(ap);
 
-        printf("\n");
+    if (toDB)
+        outDB(LOG_TYPE_BASIC, text.c_str());
 
-        if (logfile)
-        {
-            outTimestamp(logfile);
-            va_list ap2;
-            va_start(ap2, str);
-            vfprintf(logfile, str, ap2);
-            fprintf(logfile, "\n" );
-            va_end(ap2);
-            fflush(logfile);
-        }
+    if (m_logLevel > LOGL_NORMAL)
+    {
+        writeConsole(true, m_colored ? m_colors[LOGL_BASIC] : -1, text);
+        writeFile(logfile, "", text);
     }
-    fflush(stdout);
 }
 
 void Log::outDetail(const char* str, ...)
@@ -640,45 +669,23 @@ void Log::outDetail(const char* str, ...)
     if (!str)
         return;
 
-    if (m_enableLogDB && m_dbLogLevel > LOGL_BASIC)
-    {
-        va_list ap2;
-        va_start(ap2, str);
-        char nnew_str[MAX_QUERY_LEN];
-        vsnprintf(nnew_str, MAX_QUERY_LEN, str, ap2);
-        outDB(LOG_TYPE_DETAIL, nnew_str);
-        va_end(ap2);
-    }
-
-    if (m_logLevel > LOGL_BASIC)
-    {
-        if (m_colored)
-            SetColor(true, m_colors[LOGL_DETAIL]);
-
-        va_list ap;
-        va_start(ap, str);
-        vutf8printf(stdout, str, &ap);
-        va_end(ap);
+    bool toDB = m_enableLogDB && m_dbLogLevel > LOGL_BASIC;
+    if (!toDB && m_logLevel <= LOGL_BASIC)
+        return;
 
-        if (m_colored)
-            ResetColor(true);
+    va_list ap;
+    va_start(ap, str);
+    std::string text = formatLogText(str, ap);
+    va_end(ap);
 
-        printf("\n");
+    if (toDB)
+        outDB(LOG_TYPE_DETAIL, text.c_str());
 
-        if (logfile)
-        {
-            outTimestamp(logfile);
-            va_list ap2;
-            va_start(ap2, str);
-            vfprintf(logfile, str, ap2);
-            va_end(ap2);
-
-            fprintf(logfile, "\n");
-            fflush(logfile);
-        }
+    if (m_logLevel > LOGL_BASIC)
+    {
+        writeConsole(true, m_colored ? m_colors[LOGL_DETAIL] : -1, text);
+        writeFile(logfile, "", text);
     }
-
-    fflush(stdout);
 }
 
 void Log::outSQLDev(const char* str, ...)
@@ -688,23 +695,11 @@ void Log::outSQLDev(const char* str, ...)
 
     va_list ap;
     va_start(ap, str);
-    vutf8printf(stdout, str, &ap);
+    std::string text = formatLogText(str, ap);
     va_end(ap);
 
-    printf("\n");
-
-    if (sqlDevLogFile)
-    {
-        va_list ap2;
-        va_start(ap2, str);
-        vfprintf(sqlDevLogFile, str, ap2);
-        va_end(ap2);
-
-        fprintf(sqlDevLogFile, "\n");
-        fflush(sqlDevLogFile);
-    }
-
-    fflush(stdout);
+    writeConsole(true, -1, text);
+    writeFile(sqlDevLogFile, "", text, false);
 }
 
 void Log::outDebug(DebugLogFilters f, const char* str, ...)
@@ -715,44 +710,23 @@ void Log::outDebug(DebugLogFilters f, const char* str, ...)
     if (!str)
         return;
 
-    if (m_enableLogDB && m_dbLogLevel > LOGL_DETAIL)
-    {
-        va_list ap2;
-        va_start(ap2, str);
-        char nnew_str[MAX_QUERY_LEN];
-        vsnprintf(nnew_str, MAX_QUERY_LEN, str, ap2);
-        outDB(LOG_TYPE_DEBUG, nnew_str);
-        va_end(ap2);
-    }
-
-    if ( m_logLevel > LOGL_DETAIL )
-    {
-        if (m_colored)
-            SetColor(true, m_colors[LOGL_DEBUG]);
-
-        va_list ap;
-        va_start(ap, str);
-        vutf8printf(stdout, str, &ap);
-        va_end(ap);
+    bool toDB = m_enableLogDB && m_dbLogLevel > LOGL_DETAIL;
+    if (!toDB && m_logLevel <= LOGL_DETAIL)
+        return;
 
-        if (m_colored)
-            ResetColor(true);
+    va_list ap;
+    va_start(ap, str);
+    std::string text = formatLogText(str, ap);
+    va_end(ap);
 
-        printf( "\n" );
+    if (toDB)
+        outDB(LOG_TYPE_DEBUG, text.c_str());
 
-        if (logfile)
-        {
-            outTimestamp(logfile);
-            va_list ap2;
-            va_start(ap2, str);
-            vfprintf(logfile, str, ap2);
-            va_end(ap2);
-
-            fprintf(logfile, "\n" );
-            fflush(logfile);
-        }
+    if (m_logLevel > LOGL_DETAIL)
+    {
+        writeConsole(true, m_colored ? m_colors[LOGL_DEBUG] : -1, text);
+        writeFile(logfile, "", text);
     }
-    fflush(stdout);
 }
 
 void Log::outStaticDebug(const char* str, ...)
@@ -760,44 +734,23 @@ void Log::outStaticDebug(const char* str, ...)
     if (!str)
         return;
 
-    if (m_enableLogDB && m_dbLogLevel > LOGL_DETAIL)
-    {
-        va_list ap2;
-        va_start(ap2, str);
-        char nnew_str[MAX_QUERY_LEN];
-        vsnprintf(nnew_str, MAX_QUERY_LEN, str, ap2);
-        outDB(LOG_TYPE_DEBUG, nnew_str);
-        va_end(ap2);
-    }
-
-    if ( m_logLevel > LOGL_DETAIL )
-    {
-        if (m_colored)
-            SetColor(true, m_colors[LOGL_DEBUG]);
-
-        va_list ap;
-        va_start(ap, str);
-        vutf8printf(stdout, str, &ap);
-        va_end(ap);
+    bool toDB = m_enableLogDB && m_dbLogLevel > LOGL_DETAIL;
+    if (!toDB && m_logLevel <= LOGL_DETAIL)
+        return;
 
-        if (m_colored)
-            ResetColor(true);
+    va_list ap;
+    va_start(ap, str);
+    std::string text = formatLogText(str, ap);
+    va_end(ap);
 
-        printf( "\n" );
+    if (toDB)
+        outDB(LOG_TYPE_DEBUG, text.c_str());
 
-        if (logfile)
-        {
-            outTimestamp(logfile);
-            va_list ap2;
-            va_start(ap2, str);
-            vfprintf(logfile, str, ap2);
-            va_end(ap2);
-
-            fprintf(logfile, "\n" );
-            fflush(logfile);
-        }
+    if (m_logLevel > LOGL_DETAIL)
+    {
+        writeConsole(true, m_colored ? m_colors[LOGL_DEBUG] : -1, text);
+        writeFile(logfile, "", text);
     }
-    fflush(stdout);
 }
 
 void Log::outStringInLine(const char* str, ...)
@@ -806,17 +759,12 @@ void Log::outStringInLine(const char* str, ...)
         return;
 
     va_list ap;
-
     va_start(ap, str);
-    vutf8printf(stdout, str, &ap);
+    std::string text = formatLogText(str, ap);
     va_end(ap);
 
-    if (logfile)
-    {
-        va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        va_end(ap);
-    }
+    writeConsole(true, -1, text, false);
+    writeFile(logfile, "", text, false, false);
 }
 
 void Log::outCommand(uint32 account, const char* str, ...)
@@ -824,69 +772,29 @@ void Log::outCommand(uint32 account, const char* str, ...)
     if (!str)
         return;
 
+    va_list ap;
+    va_start(ap, str);
+    std::string text = formatLogText(str, ap);
+    va_end(ap);
+
     // TODO: support accountid
     if (m_enableLogDB && m_dbGM)
-    {
-        va_list ap2;
-        va_start(ap2, str);
-        char nnew_str[MAX_QUERY_LEN];
-        vsnprintf(nnew_str, MAX_QUERY_LEN, str, ap2);
-        outDB(LOG_TYPE_GM, nnew_str);
-        va_end(ap2);
-    }
+        outDB(LOG_TYPE_GM, text.c_str());
 
     if (m_logLevel > LOGL_NORMAL)
     {
-        if (m_colored)
-            SetColor(true, m_colors[LOGL_BASIC]);
-
-        va_list ap;
-        va_start(ap, str);
-        vutf8printf(stdout, str, &ap);
-        va_end(ap);
-
-        if (m_colored)
-            ResetColor(true);
-
-        printf("\n");
-
-        if (logfile)
-        {
-            outTimestamp(logfile);
-            va_list ap2;
-            va_start(ap2, str);
-            vfprintf(logfile, str, ap2);
-            fprintf(logfile, "\n" );
-            va_end(ap2);
-            fflush(logfile);
-        }
+        writeConsole(true, m_colored ? m_colors[LOGL_BASIC] : -1, text);
+        writeFile(logfile, "", text);
     }
 
     if (m_gmlog_per_account)
     {
-        if (FILE* per_file = openGmlogPerAccount (account))
-        {
-            outTimestamp(per_file);
-            va_list ap;
-            va_start(ap, str);
-            vfprintf(per_file, str, ap);
-            fprintf(per_file, "\n" );
-            va_end(ap);
-            fclose(per_file);
-        }
-    }
-    else if (gmLogfile)
-    {
-        outTimestamp(gmLogfile);
-        va_list ap;
-        va_start(ap, str);
-        vfprintf(gmLogfile, str, ap);
-        fprintf(gmLogfile, "\n" );
-        va_end(ap);
-        fflush(gmLogfile);
+        LogRecord record(LOG_RECORD_GM_ACCOUNT, std::move(text));
+        record.Value = account;
+        writeRecord(std::move(record));
     }
-
-    fflush(stdout);
+    else
+        writeFile(gmLogfile, "", text);
 }
 
 void Log::outChar(const char* str, ...)
@@ -894,48 +802,35 @@ void Log::outChar(const char* str, ...)
     if (!str)
         return;
 
+    va_list ap;
+    va_start(ap, str);
+    std::string text = formatLogText(str, ap);
+    va_end(ap);
+
     if (m_enableLogDB && m_dbChar)
-    {
-        va_list ap2;
-        va_start(ap2, str);
-        char nnew_str[MAX_QUERY_LEN];
-        vsnprintf(nnew_str, MAX_QUERY_LEN, str, ap2);
-        outDB(LOG_TYPE_CHAR, nnew_str);
-        va_end(ap2);
-    }
+        outDB(LOG_TYPE_CHAR, text.c_str());
 
-    if (charLogfile)
-    {
-        outTimestamp(charLogfile);
-        va_list ap;
-        va_start(ap, str);
-        vfprintf(charLogfile, str, ap);
-        fprintf(charLogfile, "\n" );
-        va_end(ap);
-        fflush(charLogfile);
-    }
+    writeFile(charLogfile, "", text);
 }
 
 void Log::outCharDump(const char* str, uint32 account_id, uint32 guid, const char* name)
 {
-    FILE* file = nullptr;
-    if (m_charLog_Dump_Separate)
+    if (!m_charLog_Dump_Separate)
     {
-        char fileName[29]; // Max length: name(12) + guid(11) + _.log (5) + \0
-        snprintf(fileName, 29, "%d_%s.log", guid, name);
-        std::string sFileName(m_dumpsDir);
-        sFileName.append(fileName);
-        file = fopen((m_logsDir + sFileName).c_str(), "w");
+        writeFile(charLogfile, "", acore::StringFormat("== START DUMP == (account: %u guid: %u name: %s )\n%s\n== END DUMP ==", account_id, guid, name, str), false);
+        return;
     }
-    else
-        file = charLogfile;
-    if (file)
+
+    char fileName[29]; // Max length: name(12) + guid(11) + _.log (5) + \0
+    snprintf(fileName, 29, "%d_%s.log", guid, name);
+    std::string sFileName(m_dumpsDir);
+    sFileName.append(fileName);
+
+    if (FILE* file = fopen((m_logsDir + sFileName).c_str(), "w"))
     {
         fprintf(file, "== START DUMP == (account: %u guid: %u name: %s )\n%s\n== END DUMP ==\n",
                 account_id, guid, name, str);
-        fflush(file);
-        if (m_charLog_Dump_Separate)
-            fclose(file);
+        fclose(file);
     }
 }
 
@@ -944,26 +839,15 @@ void Log::outChat(const char* str, ...)
     if (!str)
         return;
 
+    va_list ap;
+    va_start(ap, str);
+    std::string text = formatLogText(str, ap);
+    va_end(ap);
+
     if (m_enableLogDB && m_dbChat)
-    {
-        va_list ap2;
-        va_start(ap2, str);
-        char nnew_str[MAX_QUERY_LEN];
-        vsnprintf(nnew_str, MAX_QUERY_LEN, str, ap2);
-        outDB(LOG_TYPE_CHAT, nnew_str);
-        va_end(ap2);
-    }
+        outDB(LOG_TYPE_CHAT, text.c_str());
 
-    if (chatLogfile)
-    {
-        outTimestamp(chatLogfile);
-        va_list ap;
-        va_start(ap, str);
-        vfprintf(chatLogfile, str, ap);
-        fprintf(chatLogfile, "\n");
-        fflush(chatLogfile);
-        va_end(ap);
-    }
+    writeFile(chatLogfile, "", text);
 }
 
 void Log::outRemote(const char* str, ...)
@@ -971,26 +855,15 @@ void Log::outRemote(const char* str, ...)
     if (!str)
         return;
 
+    va_list ap;
+    va_start(ap, str);
+    std::string text = formatLogText(str, ap);
+    va_end(ap);
+
     if (m_enableLogDB && m_dbRA)
-    {
-        va_list ap2;
-        va_start(ap2, str);
-        char nnew_str[MAX_QUERY_LEN];
-        vsnprintf(nnew_str, MAX_QUERY_LEN, str, ap2);
-        outDB(LOG_TYPE_RA, nnew_str);
-        va_end(ap2);
-    }
+        outDB(LOG_TYPE_RA, text.c_str());
 
-    if (raLogfile)
-    {
-        outTimestamp(raLogfile);
-        va_list ap;
-        va_start(ap, str);
-        vfprintf(raLogfile, str, ap);
-        fprintf(raLogfile, "\n" );
-        va_end(ap);
-        fflush(raLogfile);
-    }
+    writeFile(raLogfile, "", text);
 }
 
 void Log::outMisc(const char* str, ...)
@@ -998,24 +871,13 @@ void Log::outMisc(const char* str, ...)
     if (!str)
         return;
 
+    va_list ap;
+    va_start(ap, str);
+    std::string text = formatLogText(str, ap);
+    va_end(ap);
+
     if (m_enableLogDB)
-    {
-        va_list ap2;
-        va_start(ap2, str);
-        char nnew_str[MAX_QUERY_LEN];
-        vsnprintf(nnew_str, MAX_QUERY_LEN, str, ap2);
-        outDB(LOG_TYPE_PERF, nnew_str);
-        va_end(ap2);
-    }
+        outDB(LOG_TYPE_PERF, text.c_str());
 
-    if (miscLogFile)
-    {
-        outTimestamp(miscLogFile);
-        va_list ap;
-        va_start(ap, str);
-        vfprintf(miscLogFile, str, ap);
-        fprintf(miscLogFile, "\n" );
-        fflush(miscLogFile);
-        va_end(ap);
-    }
+    writeFile(miscLogFile, "", text);
 }
@@ -9,6 +9,7 @@
 
 #include "Common.h"
 #include "ILog.h"
+#include "LogWriter.h"
 #include <ace/Task.h>
 
 class Log : public ILog
@@ -51,6 +52,7 @@ public:
     void outCharDump(const char* str, uint32 account_id, uint32 guid, const char* name);
 
     static void outTimestamp(FILE* file);
+    static void outTimestamp(FILE* file, time_t t);
     static std::string GetTimestampStr();
 
     void SetLogLevel(char* Level);
@@ -62,12 +64,21 @@ public:
     [[nodiscard]] bool IsOutCharDump() const { return m_charLog_Dump; }
 
     [[nodiscard]] bool GetLogDB() const { return m_enableLogDB; }
-    void SetLogDB(bool enable) { m_enableLogDB = enable; }
+    void SetLogDB(bool enable);
     [[nodiscard]] bool GetSQLDriverQueryLogging() const { return m_sqlDriverQueryLogging; }
 private:
     FILE* openLogFile(char const* configFileName, char const* configTimeStampFlag, char const* mode);
     FILE* openGmlogPerAccount(uint32 account);
 
+    static std::string formatLogText(char const* format, va_list ap);
+
+    // outputs go through these, they are written at once or handed to the async writer
+    void writeConsole(bool stdout_stream, int8 color, std::string const& text, bool newLine = true);
+    void writeFile(FILE* file, char const* prefix, std::string const& text, bool timestamp = true, bool newLine = true);
+    void writeRecord(LogRecord&& record);
+    void writeRecordNow(LogRecord const& record);
+    void writeRecords(std::vector<LogRecord*> const& records, uint64 droppedRecords);
+
     FILE* raLogfile;
     FILE* logfile;
     FILE* gmLogfile;
@@ -111,6 +122,9 @@ private:
     std::string m_dumpsDir;
 
     DebugLogFilters m_DebugLogMask;
+
+    // set with Log.Async.Enable
+    std::unique_ptr<LogWriter> m_writer;
 };
 
 std::unique_ptr<ILog>& getLogInstance();
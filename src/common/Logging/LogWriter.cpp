@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-GPL2
+ */
+
+#include "LogWriter.h"
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+    std::atomic<uint64> nextWriterId(1);
+
+    // queue of the current thread, marked abandoned when the thread ends
+    struct ThreadQueueHolder
+    {
+        ~ThreadQueueHolder()
+        {
+            if (Queue)
+                Queue->Abandoned = true;
+        }
+
+        uint64 WriterId = 0;
+        std::shared_ptr<LogThreadQueue> Queue;
+    };
+
+    thread_local ThreadQueueHolder threadQueue;
+    thread_local bool isWriterThread = false;
+
+    uint32 RoundUpToPowerOfTwo(uint32 value)
+    {
+        uint32 result = 2;
+        while (result < value)
+            result <<= 1;
+        return result;
+    }
+}
+
+LogWriter::LogWriter(uint32 queueSize, LogOverflowPolicy policy, WriteFunction write) : _id(nextWriterId++), _queueSize(RoundUpToPowerOfTwo(queueSize)),
+    _policy(policy), _write(std::move(write)), _passes(0), _flushRequested(false), _stop(false), _droppedRecords(0)
+{
+    _thread = std::thread(&LogWriter::WriterThread, this);
+}
+
+LogWriter::~LogWriter()
+{
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _stop = true;
+        _condition.notify_all();
+    }
+
+    _thread.join();
+}
+
+LogThreadQueue* LogWriter::GetThreadQueue()
+{
+    ThreadQueueHolder& holder = threadQueue;
+    if (holder.WriterId == _id)
+        return holder.Queue.get();
+
+    // first record of this thread, or it logged through another writer before
+    if (holder.Queue)
+        holder.Queue->Abandoned = true;
+
+    holder.Queue = std::make_shared<LogThreadQueue>(_queueSize);
+    holder.WriterId = _id;
+
+    std::lock_guard<std::mutex> guard(_lock);
+    _queues.push_back(holder.Queue);
+    return holder.Queue.get();
+}
+
+void LogWriter::Push(LogRecord* record)
+{
+    LogThreadQueue* queue = GetThreadQueue();
+    while (!queue->Queue.add(record))
+    {
+        // the writer thread can't wait for itself, it logs when its write function fails
+        if (_policy == LOG_OVERFLOW_DROP || isWriterThread)
+        {
+            delete record;
+            ++_droppedRecords;
+            return;
+        }
+
+        _condition.notify_one();
+        std::this_thread::yield();
+    }
+}
+
+void LogWriter::Flush()
+{
+    if (isWriterThread)
+        return;
+
+    std::unique_lock<std::mutex> guard(_lock);
+
+    // the pass running now may have missed records pushed just before, wait for the one after it
+    uint64 passes = _passes + 2;
+    _flushRequested = true;
+    _condition.notify_one();
+
+    while (_passes < passes)
+        _passCondition.wait(guard);
+}
+
+void LogWriter::WriterThread()
+{
+    isWriterThread = true;
+
+    std::vector<std::shared_ptr<LogThreadQueue>> queues;
+    std::vector<LogRecord*> records;
+    uint64 reportedDropped = 0;
+
+    while (1)
+    {
+        bool stop;
+
+        {
+            std::unique_lock<std::mutex> guard(_lock);
+
+            // while the threads log faster than the passes take, the next pass starts at once
+            if (!_stop && !_flushRequested && records.empty())
+                _condition.wait_for(guard, std::chrono::milliseconds(10));
+
+            _flushRequested = false;
+            stop = _stop;
+            queues = _queues;
+        }
+
+        records.clear();
+        for (std::shared_ptr<LogThreadQueue> const& queue : queues)
+        {
+            LogRecord* record;
+            while (queue->Queue.next(record))
+                records.push_back(record);
+        }
+
+        uint64 dropped = _droppedRecords - reportedDropped;
+        reportedDropped += dropped;
+
+        if (!records.empty() || dropped)
+            _write(records, dropped);
+
+        for (LogRecord* record : records)
+            delete record;
+
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+
+            // a queue is only abandoned after its thread's last record was added
+            _queues.erase(std::remove_if(_queues.begin(), _queues.end(), [](std::shared_ptr<LogThreadQueue> const& queue)
+            {
+                return queue->Abandoned && queue->Queue.empty();
+            }), _queues.end());
+
+            ++_passes;
+            _passCondition.notify_all();
+        }
+
+        // records added while stopping are still written, the last pass found none
+        if (stop && records.empty())
+            return;
+    }
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-GPL2
+ */
+
+#ifndef AZEROTHCORE_LOGWRITER_H
+#define AZEROTHCORE_LOGWRITER_H
+
+#include "Define.h"
+#include "Threading/MPSCQueue.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum LogRecordType
+{
+    LOG_RECORD_CONSOLE,                                     // Stream is stdout or stderr
+    LOG_RECORD_FILE,
+    LOG_RECORD_GM_ACCOUNT,                                  // per account gm log, Value is the account
+    LOG_RECORD_DB                                           // Value is the LogTypes
+};
+
+enum LogOverflowPolicy
+{
+    LOG_OVERFLOW_WAIT = 0,                                  // the logging thread waits for free space
+    LOG_OVERFLOW_DROP = 1                                   // the record is dropped and counted
+};
+
+/// Formatted log message waiting for the writer thread
+struct LogRecord
+{
+    LogRecord(LogRecordType type, std::string&& text) : Type(type), Stream(nullptr), Prefix(""), Color(-1), Timestamp(true), NewLine(true),
+        Value(0), Time(time(nullptr)), Text(std::move(text)) { }
+
+    LogRecordType Type;
+    FILE* Stream;
+    char const* Prefix;                                     // string literal written between timestamp and text
+    int8 Color;                                             // console color, -1 for none
+    bool Timestamp;
+    bool NewLine;
+    uint32 Value;
+    time_t Time;
+    std::string Text;
+};
+
+/// Records of one logging thread, only that thread adds to it
+struct LogThreadQueue
+{
+    explicit LogThreadQueue(size_t capacity) : Queue(capacity), Abandoned(false) { }
+
+    acore::MPSCQueue<LogRecord*> Queue;
+    std::atomic<bool> Abandoned;                            // the thread ended, removed once empty
+};
+
+/// Writes log records on its own thread, so threads logging to files and the database don't wait for the I/O.
+/// Every logging thread gets a lock-free queue of its own, the writer thread takes the records of all queues
+/// every 10 ms, or right away while it finds records, and hands them in one batch to the write function,
+/// which flushes each file once per batch.
+/// Records of one thread keep their order. When a thread's queue is full the policy decides whether it waits.
+class LogWriter
+{
+public:
+    typedef std::function<void(std::vector<LogRecord*> const& records, uint64 droppedRecords)> WriteFunction;
+
+    /// queueSize is rounded up to a power of two
+    LogWriter(uint32 queueSize, LogOverflowPolicy policy, WriteFunction write);
+    ~LogWriter();
+
+    LogWriter(LogWriter const&) = delete;
+    LogWriter& operator=(LogWriter const&) = delete;
+
+    /// Queues the record for the writer thread, which deletes it
+    void Push(LogRecord* record);
+
+    /// Returns after every record pushed before the call was written
+    void Flush();
+
+    [[nodiscard]] uint64 GetDroppedRecords() const { return _droppedRecords; }
+
+private:
+    LogThreadQueue* GetThreadQueue();
+    void WriterThread();
+
+    uint64 const _id;
+    uint32 const _queueSize;
+    LogOverflowPolicy const _policy;
+    WriteFunction const _write;
+
+    std::mutex _lock;
+    std::condition_variable _condition;
+    std::condition_variable _passCondition;
+    std::vector<std::shared_ptr<LogThreadQueue>> _queues;
+    uint64 _passes;                                         // completed writer passes, for Flush()
+    bool _flushRequested;
+    bool _stop;
+
+    std::atomic<uint64> _droppedRecords;
+    std::thread _thread;
+};
+
+#endif
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-GPL2
+ */
+
+#ifndef MPSCQUEUE_H
+#define MPSCQUEUE_H
+
+#include "Debugging/Errors.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace acore
+{
+    /// Bounded lock-free queue for many producer threads and a single consumer thread.
+    /// Follows the interface of ACE_Based::LockedQueue, except that add() fails instead of growing when the queue is full.
+    /// Every slot carries a sequence number telling whether it is free for the producer claiming that position
+    /// or filled for the consumer, so neither side takes a lock and items keep the order their positions were claimed in.
+    /// next(), peek() and pop_front() must only be called by the consumer thread.
+    template <class T>
+    class MPSCQueue
+    {
+    public:
+        //! Create a queue holding up to capacity items, capacity must be a power of two.
+        explicit MPSCQueue(size_t capacity) : _cells(new Cell[capacity]), _mask(capacity - 1), _enqueuePos(0), _dequeuePos(0), _canceled(false)
+        {
+            ASSERT(capacity >= 2 && (capacity & (capacity - 1)) == 0);
+
+            for (size_t i = 0; i < capacity; ++i)
+                _cells[i].Sequence.store(i, std::memory_order_relaxed);
+        }
+
+        MPSCQueue(MPSCQueue const&) = delete;
+        MPSCQueue& operator=(MPSCQueue const&) = delete;
+
+        //! Adds an item to the queue, returns false if the queue is full.
+        bool add(T const& item)
+        {
+            Cell* cell;
+            size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+            while (true)
+            {
+                cell = &_cells[pos & _mask];
+                size_t sequence = cell->Sequence.load(std::memory_order_acquire);
+                intptr_t diff = intptr_t(sequence) - intptr_t(pos);
+
+                if (diff == 0)
+                {
+                    // slot is free for this position, claim it
+                    if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                    return false;                           // the consumer did not free this slot yet
+                else
+                    pos = _enqueuePos.load(std::memory_order_relaxed);
+            }
+
+            cell->Data = item;
+            cell->Sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        //! Gets the next item in the queue, if any.
+        bool next(T& result)
+        {
+            Cell* cell = front();
+            if (!cell)
+                return false;
+
+            result = cell->Data;
+            release(cell);
+            return true;
+        }
+
+        //! Gets the next item in the queue only if the checker accepts it, a rejected item stays at the front.
+        template<class Checker>
+        bool next(T& result, Checker& check)
+        {
+            Cell* cell = front();
+            if (!cell)
+                return false;
+
+            result = cell->Data;
+            if (!check.Process(result))
+                return false;
+
+            release(cell);
+            return true;
+        }
+
+        //! Gets the front item without removing it, returns false if the queue is empty.
+        bool peek(T& result)
+        {
+            Cell* cell = front();
+            if (!cell)
+                return false;
+
+            result = cell->Data;
+            return true;
+        }
+
+        //! Removes the front item, the queue must not be empty.
+        void pop_front()
+        {
+            Cell* cell = front();
+            ASSERT(cell);
+            release(cell);
+        }
+
+        //! Checks if there is an item ready at the front of the queue.
+        bool empty()
+        {
+            size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+            return _cells[pos & _mask].Sequence.load(std::memory_order_acquire) != pos + 1;
+        }
+
+        //! Cancels the queue.
+        void cancel() { _canceled = true; }
+
+        //! Checks if the queue is cancelled.
+        bool cancelled() const { return _canceled; }
+
+        size_t capacity() const { return _mask + 1; }
+
+    private:
+        struct Cell
+        {
+            std::atomic<size_t> Sequence;
+            T Data;
+        };
+
+        Cell* front()
+        {
+            size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+            Cell* cell = &_cells[pos & _mask];
+            if (cell->Sequence.load(std::memory_order_acquire) != pos + 1)
+                return nullptr;
+
+            return cell;
+        }
+
+        void release(Cell* cell)
+        {
+            size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+            cell->Sequence.store(pos + _mask + 1, std::memory_order_release);
+            _dequeuePos.store(pos + 1, std::memory_order_relaxed);
+        }
+
+        std::unique_ptr<Cell[]> _cells;
+        size_t const _mask;
+
+        // producers and the consumer write different positions, keep them on separate cache lines
+        alignas(64) std::atomic<size_t> _enqueuePos;
+        alignas(64) std::atomic<size_t> _dequeuePos;
+        std::atomic<bool> _canceled;
+    };
+}
+
+#endif
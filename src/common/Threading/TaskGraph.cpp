@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-GPL2
+ */
+
+#include "TaskGraph.h"
+#include "Debugging/Errors.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+
+using namespace acore;
+
+namespace
+{
+    uint32 MillisecondsSince(std::chrono::steady_clock::time_point start)
+    {
+        return uint32(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+}
+
+TaskGraph::TaskId TaskGraph::Add(std::string const& name, std::function<void()> task, std::initializer_list<TaskId> dependencies)
+{
+    TaskId id = TaskId(_tasks.size());
+    for (TaskId dependency : dependencies)
+    {
+        ASSERT(dependency < id);
+        _tasks[dependency].Dependents.push_back(id);
+    }
+
+    _tasks.push_back({ name, std::move(task), std::vector<TaskId>(dependencies), std::vector<TaskId>(), 0 });
+    return id;
+}
+
+void TaskGraph::RunTask(Task& task)
+{
+    auto start = std::chrono::steady_clock::now();
+    task.Function();
+    task.Time = MillisecondsSince(start);
+}
+
+void TaskGraph::Run(uint32 threads)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    if (!threads)
+    {
+        for (Task& task : _tasks)
+            RunTask(task);
+
+        _wallTime = MillisecondsSince(start);
+        return;
+    }
+
+    std::mutex lock;
+    std::condition_variable condition;
+    std::set<TaskId> ready;
+    std::vector<uint32> waitingFor(_tasks.size());
+    uint32 finished = 0;
+
+    for (TaskId id = 0; id < _tasks.size(); ++id)
+    {
+        waitingFor[id] = uint32(_tasks[id].Dependencies.size());
+        if (!waitingFor[id])
+            ready.insert(id);
+    }
+
+    auto worker = [&]()
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        while (finished < _tasks.size())
+        {
+            if (ready.empty())
+            {
+                condition.wait(guard);
+                continue;
+            }
+
+            TaskId id = *ready.begin();
+            ready.erase(ready.begin());
+
+            guard.unlock();
+            RunTask(_tasks[id]);
+            guard.lock();
+
+            for (TaskId dependent : _tasks[id].Dependents)
+                if (!--waitingFor[dependent])
+                    ready.insert(dependent);
+
+            ++finished;
+            condition.notify_all();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (uint32 i = 0; i < threads; ++i)
+        workers.emplace_back(worker);
+
+    for (std::thread& thread : workers)
+        thread.join();
+
+    _wallTime = MillisecondsSince(start);
+}
+
+std::vector<TaskGraph::TaskId> TaskGraph::GetCriticalPath() const
+{
+    if (_tasks.empty())
+        return std::vector<TaskId>();
+
+    // dependencies come before their dependents, one pass in the order of adding finds the longest chain ending at each task
+    std::vector<uint32> chainTime(_tasks.size());
+    std::vector<TaskId> previous(_tasks.size());
+    TaskId last = 0;
+    for (TaskId id = 0; id < _tasks.size(); ++id)
+    {
+        uint32 longest = 0;
+        previous[id] = id;
+        for (TaskId dependency : _tasks[id].Dependencies)
+        {
+            if (chainTime[dependency] >= longest)
+            {
+                longest = chainTime[dependency];
+                previous[id] = dependency;
+            }
+        }
+
+        chainTime[id] = longest + _tasks[id].Time;
+        if (chainTime[id] >= chainTime[last])
+            last = id;
+    }
+
+    std::vector<TaskId> path;
+    for (TaskId id = last; ; id = previous[id])
+    {
+        path.insert(path.begin(), id);
+        if (previous[id] == id)
+            break;
+    }
+
+    return path;
+}
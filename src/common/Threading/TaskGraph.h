@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-GPL2
+ */
+
+#ifndef TASKGRAPH_H
+#define TASKGRAPH_H
+
+#include "Define.h"
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace acore
+{
+    /// Named tasks with dependencies between them, each run once after all of its dependencies finished.
+    /// A dependency has to be added before the tasks depending on it, so the graph has no cycles and the order
+    /// the tasks were added in is always a valid order to run them in.
+    /// Every task is timed, the critical path is the chain of dependent tasks that took the longest,
+    /// no number of threads runs the graph faster than it.
+    class TaskGraph
+    {
+    public:
+        typedef uint32 TaskId;
+
+        TaskGraph() : _wallTime(0) { }
+
+        TaskId Add(std::string const& name, std::function<void()> task, std::initializer_list<TaskId> dependencies = {});
+
+        /// Runs the tasks on the calling thread in the order they were added when threads is 0,
+        /// otherwise on that many threads, each taking the earliest added task whose dependencies finished.
+        void Run(uint32 threads);
+
+        [[nodiscard]] uint32 GetTaskCount() const { return uint32(_tasks.size()); }
+        [[nodiscard]] std::string const& GetName(TaskId id) const { return _tasks[id].Name; }
+
+        /// Milliseconds taken by a task and by Run()
+        [[nodiscard]] uint32 GetTime(TaskId id) const { return _tasks[id].Time; }
+        [[nodiscard]] uint32 GetWallTime() const { return _wallTime; }
+
+        /// The chain of dependent tasks with the longest total time, first task first
+        [[nodiscard]] std::vector<TaskId> GetCriticalPath() const;
+
+    private:
+        struct Task
+        {
+            std::string Name;
+            std::function<void()> Function;
+            std::vector<TaskId> Dependencies;
+            std::vector<TaskId> Dependents;
+            uint32 Time;
+        };
+
+        void RunTask(Task& task);
+
+        std::vector<Task> _tasks;
+        uint32 _wallTime;
+    };
+}
+
+#endif
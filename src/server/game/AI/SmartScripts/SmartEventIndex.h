@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-GPL2
+ */
+
+#ifndef ACORE_SMARTEVENTINDEX_H
+#define ACORE_SMARTEVENTINDEX_H
+
+#include "Define.h"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+/// Rows of a SmartScript by event type, so raising an event looks only at the rows of that type, and the rows
+/// whose timer has to be updated, so an update skips the rows waiting for an event that have no cooldown running.
+/// Rows are positions in the event list of the script, both keep them in the order of the list.
+class SmartEventIndex
+{
+public:
+    typedef std::pair<uint32, uint32> Entry;                // event type, row
+    typedef std::vector<Entry>::const_iterator const_iterator;
+
+    SmartEventIndex() : _updatePos(NOT_UPDATING) { }
+
+    /// Rows provide uint32 GetEventType(), needsTimer(row) tells the rows to update the timer of
+    template<class Rows, class NeedsTimer>
+    void Build(Rows const& rows, NeedsTimer needsTimer)
+    {
+        _byType.clear();
+        _timerRows.clear();
+        for (uint32 row = 0; row < uint32(rows.size()); ++row)
+        {
+            _byType.emplace_back(rows[row].GetEventType(), row);
+            if (needsTimer(rows[row]))
+                _timerRows.push_back(row);
+        }
+
+        std::sort(_byType.begin(), _byType.end());
+    }
+
+    std::pair<const_iterator, const_iterator> GetRows(uint32 eventType) const
+    {
+        return std::equal_range(_byType.begin(), _byType.end(), Entry(eventType, 0), [](Entry const& left, Entry const& right)
+        {
+            return left.first < right.first;
+        });
+    }
+
+    /// A row started a timer, it is updated from now on, within the current UpdateTimers() if it comes after the row updated
+    void AddTimerRow(uint32 row)
+    {
+        auto itr = std::lower_bound(_timerRows.begin(), _timerRows.end(), row);
+        if (itr != _timerRows.end() && *itr == row)
+            return;
+
+        size_t pos = size_t(itr - _timerRows.begin());
+        _timerRows.insert(itr, row);
+        if (_updatePos != NOT_UPDATING && pos <= _updatePos)
+            ++_updatePos;
+    }
+
+    /// Calls update(row) for the rows with a timer, then drops those keep(row) is false for
+    template<class Update, class Keep>
+    void UpdateTimers(Update update, Keep keep)
+    {
+        for (_updatePos = 0; _updatePos < _timerRows.size(); ++_updatePos)
+            update(_timerRows[_updatePos]);
+        _updatePos = NOT_UPDATING;
+
+        _timerRows.erase(std::remove_if(_timerRows.begin(), _timerRows.end(), [&keep](uint32 row) { return !keep(row); }), _timerRows.end());
+    }
+
+    [[nodiscard]] uint32 GetTimerRowCount() const { return uint32(_timerRows.size()); }
+
+private:
+    static constexpr size_t NOT_UPDATING = ~size_t(0);
+
+    std::vector<Entry> _byType;                             // sorted by type, then row
+    std::vector<uint32> _timerRows;                         // sorted
+    size_t _updatePos;
+};
+
+#endif
@@ -11,6 +11,7 @@
 #include "Creature.h"
 #include "CreatureAI.h"
 #include "GridNotifiers.h"
+#include "SmartEventIndex.h"
 #include "SmartScriptMgr.h"
 #include "Spell.h"
 #include "Unit.h"
@@ -258,6 +259,7 @@ private:
     void SetPhase(uint32 p = 0) { mEventPhase = p; }
 
     SmartAIEventList mEvents;
+    SmartEventIndex mEventIndex;                            // of mEvents, rebuilt by IndexEvents() when rows are added
     SmartAIEventList mInstallEvents;
     SmartAIEventList mTimedActionList;
     bool isProcessingTimedActionList;
@@ -293,6 +295,9 @@ private:
 
     SMARTAI_TEMPLATE mTemplate;
     void InstallEvents();
+    void IndexEvents();
+    // events processed by UpdateTimer() when their timer runs out, the others only wait for their cooldown there
+    static bool IsTimedEvent(uint32 eventType);
 
     void RemoveStoredEvent (uint32 id)
     {
@@ -323,6 +323,11 @@ void AuctionHouseMgr::LoadAuctions()
 {
     uint32 oldMSTime = getMSTime();
 
+    // the names are indexed as the auctions are added, and not at the first search in a locale
+    mHordeAuctions.AddSearchLocales();
+    mAllianceAuctions.AddSearchLocales();
+    mNeutralAuctions.AddSearchLocales();
+
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_AUCTIONS);
     PreparedQueryResult result = CharacterDatabase.Query(stmt);
 
@@ -451,17 +456,110 @@ AuctionHouseEntry const* AuctionHouseMgr::GetAuctionHouseEntry(uint32 factionTem
     return sAuctionHouseStore.LookupEntry(houseid);
 }
 
+// name of the auctioned item as the client of the given locale key shows it, in lower case for the search index
+static bool BuildAuctionSearchName(AuctionEntry const* auction, uint32 nameLocale, std::wstring& wname)
+{
+    Item* item = sAuctionMgr->GetAItem(auction->item_guidlow);
+    if (!item)
+        return false;
+
+    ItemTemplate const* proto = item->GetTemplate();
+    std::string name = proto->Name1;
+    if (name.empty())
+        return false;
+
+    int loc_idx = int(nameLocale / TOTAL_LOCALES);
+    int locdbc_idx = int(nameLocale % TOTAL_LOCALES);
+
+    // local name
+    if (loc_idx >= 0)
+        if (ItemLocale const* il = sObjectMgr->GetItemLocale(proto->ItemId))
+            ObjectMgr::GetLocaleString(il->Name, loc_idx, name);
+
+    // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
+    //  that matches the search but it may not equal item->GetItemRandomPropertyId()
+    //  used in BuildAuctionInfo() which then causes wrong items to be listed
+    int32 propRefID = item->GetItemRandomPropertyId();
+
+    if (propRefID)
+    {
+        // Append the suffix to the name (ie: of the Monkey) if one exists
+        // These are found in ItemRandomSuffix.dbc and ItemRandomProperties.dbc
+        //  even though the DBC name seems misleading
+
+        char* const* suffix = nullptr;
+
+        if (propRefID < 0)
+        {
+            const ItemRandomSuffixEntry* itemRandEntry = sItemRandomSuffixStore.LookupEntry(-item->GetItemRandomPropertyId());
+            if (itemRandEntry)
+                suffix = itemRandEntry->nameSuffix;
+        }
+        else
+        {
+            const ItemRandomPropertiesEntry* itemRandEntry = sItemRandomPropertiesStore.LookupEntry(item->GetItemRandomPropertyId());
+            if (itemRandEntry)
+                suffix = itemRandEntry->nameSuffix;
+        }
+
+        // dbc local name
+        if (suffix)
+        {
+            // Append the suffix (ie: of the Monkey) to the name using localization
+            // or default enUS if localization is invalid
+            name += ' ';
+            name += suffix[locdbc_idx >= 0 ? locdbc_idx : LOCALE_enUS];
+        }
+    }
+
+    // Allow search by suffix (ie: of the Monkey) or partial name (ie: Monkey)
+    if (!Utf8toWStr(name, wname))
+        return false;
+
+    wstrToLower(wname);
+    return true;
+}
+
+// key of the names a session searches in, locales without item names list the same names as enUS
+static uint32 GetAuctionSearchNameLocale(LocaleConstant dbLocale, LocaleConstant dbcLocale)
+{
+    if (!sObjectMgr->HasItemNameLocale(dbLocale))
+        dbLocale = LOCALE_enUS;
+
+    return uint32(dbLocale) * TOTAL_LOCALES + uint32(dbcLocale);
+}
+
+AuctionHouseObject::AuctionHouseObject() : _searchIndex(&BuildAuctionSearchName)
+{
+    next = AuctionsMap.begin();
+}
+
 void AuctionHouseObject::AddAuction(AuctionEntry* auction)
 {
     ASSERT(auction);
 
     AuctionsMap[auction->Id] = auction;
+
+    Item* item = sAuctionMgr->GetAItem(auction->item_guidlow);
+    if (ItemTemplate const* proto = item ? item->GetTemplate() : sObjectMgr->GetItemTemplate(auction->item_template))
+    {
+        AuctionSearchRow row;
+        row.ItemClass = uint8(proto->Class);
+        row.ItemSubClass = uint8(proto->SubClass);
+        row.InventoryType = uint8(proto->InventoryType);
+        row.Quality = uint8(proto->Quality);
+        row.RequiredLevel = uint8(std::min<uint32>(proto->RequiredLevel, 0xFF));
+        row.ExpireTime = auction->expire_time;
+        _searchIndex.Insert(auction, auction->Id, row);
+    }
+
     sScriptMgr->OnAuctionAdd(this, auction);
 }
 
 bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction)
 {
     bool wasInMap = !!AuctionsMap.erase(auction->Id);
+    _searchIndex.Remove(auction->Id);
 
     sScriptMgr->OnAuctionRemove(this, auction);
 
@@ -472,6 +570,17 @@ bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction)
     return wasInMap;
 }
 
+void AuctionHouseObject::AddSearchLocales()
+{
+    // every pair of item name and DBC locale a client of any locale can search in, for the suffixes of the DBC
+    // locale loaded for its own or the default one, so no search has to index all names while listing
+    for (uint8 locale = 0; locale < TOTAL_LOCALES; ++locale)
+    {
+        _searchIndex.AddLocale(GetAuctionSearchNameLocale(LocaleConstant(locale), sWorld->GetDefaultDbcLocale()));
+        _searchIndex.AddLocale(GetAuctionSearchNameLocale(LocaleConstant(locale), sWorld->GetAvailableDbcLocale(LocaleConstant(locale))));
+    }
+}
+
 void AuctionHouseObject::Update()
 {
     time_t checkTime = sWorld->GetGameTime() + 60;
@@ -572,112 +681,43 @@ bool AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player
         return true;
     }
 
-    time_t curTime = sWorld->GetGameTime();
-
-    int loc_idx = player->GetSession()->GetSessionDbLocaleIndex();
-    int locdbc_idx = player->GetSession()->GetSessionDbcLocale();
-
-    for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
+    AuctionSearchQuery query;
+    query.Name = wsearchedname;
+    query.NameLocale = GetAuctionSearchNameLocale(player->GetSession()->GetSessionDbLocaleIndex(), player->GetSession()->GetSessionDbcLocale());
+    query.InventoryType = inventoryType;
+    query.ItemClass = itemClass;
+    query.ItemSubClass = itemSubClass;
+    query.Quality = quality;
+    query.LevelMin = levelmin;
+    query.LevelMax = levelmax;
+    query.CurTime = sWorld->GetGameTime();
+
+    // item filters and the name are checked by the index, only the player dependant checks are left
+    std::vector<AuctionEntry*> auctions;
+    _searchIndex.Search(query, auctions);
+
+    for (AuctionEntry* Aentry : auctions)
     {
         if (AsyncAuctionListingMgr::IsAuctionListingAllowed() == false) // pussywizard: World::Update is waiting for us...
             if ((itrcounter++) % 100 == 0) // check condition every 100 iterations
                 if (avgDiffTracker.getAverage() >= 30 || getMSTimeDiff(World::GetGameTimeMS(), getMSTime()) >= 10) // pussywizard: stop immediately if diff is high or waiting too long
                     return false;
 
-        AuctionEntry* Aentry = itr->second;
-        // Skip expired auctions
-        if (Aentry->expire_time < curTime)
-            continue;
-
         Item* item = sAuctionMgr->GetAItem(Aentry->item_guidlow);
         if (!item)
             continue;
 
-        ItemTemplate const* proto = item->GetTemplate();
-
-        if (itemClass != 0xffffffff && proto->Class != itemClass)
-            continue;
-
-        if (itemSubClass != 0xffffffff && proto->SubClass != itemSubClass)
-            continue;
-
-        if (inventoryType != 0xffffffff && proto->InventoryType != inventoryType)
-        {
-            // xinef: exception, robes are counted as chests
-            if (inventoryType != INVTYPE_CHEST || proto->InventoryType != INVTYPE_ROBE)
-                continue;
-        }
-
-        if (quality != 0xffffffff && proto->Quality != quality)
-            continue;
-
-        if (levelmin != 0x00 && (proto->RequiredLevel < levelmin || (levelmax != 0x00 && proto->RequiredLevel > levelmax)))
-            continue;
-
         if (usable != 0x00)
         {
             if (player->CanUseItem(item) != EQUIP_ERR_OK)
                 continue;
 
             // xinef: check already learded recipes and pets
+            ItemTemplate const* proto = item->GetTemplate();
             if (proto->Spells[1].SpellTrigger == ITEM_SPELLTRIGGER_LEARN_SPELL_ID && player->HasSpell(proto->Spells[1].SpellId))
                 continue;
         }
 
-        // Allow search by suffix (ie: of the Monkey) or partial name (ie: Monkey)
-        // No need to do any of this if no search term was entered
-        if (!wsearchedname.empty())
-        {
-            std::string name = proto->Name1;
-            if (name.empty())
-                continue;
-
-            // local name
-            if (loc_idx >= 0)
-                if (ItemLocale const* il = sObjectMgr->GetItemLocale(proto->ItemId))
-                    ObjectMgr::GetLocaleString(il->Name, loc_idx, name);
-
-            // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
-            //  that matches the search but it may not equal item->GetItemRandomPropertyId()
-            //  used in BuildAuctionInfo() which then causes wrong items to be listed
-            int32 propRefID = item->GetItemRandomPropertyId();
-
-            if (propRefID)
-            {
-                // Append the suffix to the name (ie: of the Monkey) if one exists
-                // These are found in ItemRandomSuffix.dbc and ItemRandomProperties.dbc
-                //  even though the DBC name seems misleading
-
-                char* const* suffix = nullptr;
-
-                if (propRefID < 0)
-                {
-                    const ItemRandomSuffixEntry* itemRandEntry = sItemRandomSuffixStore.LookupEntry(-item->GetItemRandomPropertyId());
-                    if (itemRandEntry)
-                        suffix = itemRandEntry->nameSuffix;
-                }
-                else
-                {
-                    const ItemRandomPropertiesEntry* itemRandEntry = sItemRandomPropertiesStore.LookupEntry(item->GetItemRandomPropertyId());
-                    if (itemRandEntry)
-                        suffix = itemRandEntry->nameSuffix;
-                }
-
-                // dbc local name
-                if (suffix)
-                {
-                    // Append the suffix (ie: of the Monkey) to the name using localization
-                    // or default enUS if localization is invalid
-                    name += ' ';
-                    name += suffix[locdbc_idx >= 0 ? locdbc_idx : LOCALE_enUS];
-                }
-            }
-
-            // Perform the search (with or without suffix)
-            if (!Utf8FitTo(name, wsearchedname))
-                continue;
-        }
-
         // Add the item if no search term or if entered search term was found
         if (count < 50 && totalcount >= listfrom)
         {
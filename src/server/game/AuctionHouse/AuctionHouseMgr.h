@@ -7,6 +7,7 @@
 #ifndef _AUCTION_HOUSE_MGR_H
 #define _AUCTION_HOUSE_MGR_H
 
+#include "AuctionSearchIndex.h"
 #include "Common.h"
 #include "DatabaseEnv.h"
 #include "DBCStructure.h"
@@ -86,7 +87,7 @@ class AuctionHouseObject
 {
 public:
     // Initialize storage
-    AuctionHouseObject() { next = AuctionsMap.begin(); }
+    AuctionHouseObject();
     ~AuctionHouseObject()
     {
         for (auto & itr : AuctionsMap)
@@ -110,6 +111,9 @@ public:
 
     bool RemoveAuction(AuctionEntry* auction);
 
+    /// Indexes the item names of every locale with item names, so no search has to index them
+    void AddSearchLocales();
+
     void Update();
 
     void BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount);
@@ -122,6 +126,9 @@ public:
 private:
     AuctionEntryMap AuctionsMap;
 
+    // filters and item names of AuctionsMap for BuildListAuctionItems
+    AuctionSearchIndex _searchIndex;
+
     // storage for "next" auction item for next Update()
     AuctionEntryMap::const_iterator next;
 };
@@ -0,0 +1,266 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-GPL2
+ */
+
+#include "AuctionSearchIndex.h"
+#include "ItemTemplate.h"
+#include <algorithm>
+
+namespace
+{
+    // removed auctions are dropped from the lists once they are this many and more than half of the live ones
+    constexpr size_t MIN_COMPACT_COUNT = 256;
+}
+
+AuctionSearchIndex::AuctionSearchIndex(NameBuilder nameBuilder) : _nameBuilder(std::move(nameBuilder))
+{
+}
+
+AuctionSearchIndex::~AuctionSearchIndex() = default;
+
+void AuctionSearchIndex::Insert(AuctionEntry* auction, uint32 auctionId, AuctionSearchRow const& row)
+{
+    if (_slots.count(auctionId))
+        Remove(auctionId);
+
+    uint32 slot;
+    if (!_freeSlots.empty())
+    {
+        slot = _freeSlots.back();
+        _freeSlots.pop_back();
+    }
+    else
+    {
+        slot = uint32(_auctions.size());
+        _auctions.push_back(nullptr);
+        _auctionIds.push_back(0);
+        _itemClass.push_back(0);
+        _itemSubClass.push_back(0);
+        _inventoryType.push_back(0);
+        _quality.push_back(0);
+        _requiredLevel.push_back(0);
+        _expireTime.push_back(0);
+    }
+
+    _auctions[slot] = auction;
+    _auctionIds[slot] = auctionId;
+    _itemClass[slot] = row.ItemClass;
+    _itemSubClass[slot] = row.ItemSubClass;
+    _inventoryType[slot] = row.InventoryType;
+    _quality[slot] = row.Quality;
+    _requiredLevel[slot] = row.RequiredLevel;
+    _expireTime[slot] = row.ExpireTime;
+    _slots[auctionId] = slot;
+
+    AddToList(_all, slot);
+    AddToList(_classLists[ClassKey(row.ItemClass)], slot);
+    AddToList(_classLists[SubClassKey(row.ItemClass, row.ItemSubClass)], slot);
+
+    for (auto& itr : _localeNames)
+        AddName(*itr.second, itr.first, slot);
+}
+
+void AuctionSearchIndex::Remove(uint32 auctionId)
+{
+    auto itr = _slots.find(auctionId);
+    if (itr == _slots.end())
+        return;
+
+    // the slot stays in the lists until the next compaction, searches skip it
+    uint32 slot = itr->second;
+    _slots.erase(itr);
+    _auctions[slot] = nullptr;
+    _removedSlots.push_back(slot);
+
+    // expired auctions are the oldest ones at the front of every list, erasing them one by one would move the whole lists
+    if (_removedSlots.size() >= MIN_COMPACT_COUNT && _removedSlots.size() * 2 > _slots.size())
+        Compact();
+}
+
+void AuctionSearchIndex::AddLocale(uint32 nameLocale)
+{
+    GetLocaleNames(nameLocale);
+}
+
+void AuctionSearchIndex::Compact()
+{
+    auto isRemoved = [this](uint32 slot) { return _auctions[slot] == nullptr; };
+    auto compactLists = [&isRemoved](std::unordered_map<uint32, SlotList>& lists)
+    {
+        for (auto itr = lists.begin(); itr != lists.end();)
+        {
+            itr->second.erase(std::remove_if(itr->second.begin(), itr->second.end(), isRemoved), itr->second.end());
+            if (itr->second.empty())
+                itr = lists.erase(itr);
+            else
+                ++itr;
+        }
+    };
+
+    _all.erase(std::remove_if(_all.begin(), _all.end(), isRemoved), _all.end());
+    compactLists(_classLists);
+
+    for (auto& itr : _localeNames)
+    {
+        LocaleNames& names = *itr.second;
+        for (auto trigram = names.Trigrams.begin(); trigram != names.Trigrams.end();)
+        {
+            trigram->second.erase(std::remove_if(trigram->second.begin(), trigram->second.end(), isRemoved), trigram->second.end());
+            if (trigram->second.empty())
+                trigram = names.Trigrams.erase(trigram);
+            else
+                ++trigram;
+        }
+
+        for (uint32 slot : _removedSlots)
+            if (slot < names.Names.size())
+                std::wstring().swap(names.Names[slot]);
+    }
+
+    // no list refers to these slots any more, they can be reused
+    for (uint32 slot : _removedSlots)
+        _auctionIds[slot] = 0;
+
+    _freeSlots.insert(_freeSlots.end(), _removedSlots.begin(), _removedSlots.end());
+    _removedSlots.clear();
+}
+
+void AuctionSearchIndex::Search(AuctionSearchQuery const& query, std::vector<AuctionEntry*>& result)
+{
+    // start from the shortest list every match must be in
+    SlotList const* candidates = &_all;
+
+    if (query.ItemClass != 0xffffffff)
+    {
+        auto itr = _classLists.find(query.ItemSubClass != 0xffffffff ? SubClassKey(query.ItemClass, query.ItemSubClass) : ClassKey(query.ItemClass));
+        if (itr == _classLists.end())
+            return;
+
+        candidates = &itr->second;
+    }
+
+    LocaleNames* names = nullptr;
+    if (!query.Name.empty())
+    {
+        names = &GetLocaleNames(query.NameLocale);
+
+        std::vector<uint64> trigrams;
+        GetTrigrams(query.Name, trigrams);
+        for (uint64 trigram : trigrams)
+        {
+            auto itr = names->Trigrams.find(trigram);
+            if (itr == names->Trigrams.end())
+                return;
+
+            if (itr->second.size() < candidates->size())
+                candidates = &itr->second;
+        }
+    }
+
+    for (uint32 slot : *candidates)
+    {
+        if (!MatchesColumns(query, slot))
+            continue;
+
+        // the trigrams only narrow the candidates, the name must still contain the searched text
+        if (names && names->Names[slot].find(query.Name) == std::wstring::npos)
+            continue;
+
+        result.push_back(_auctions[slot]);
+    }
+}
+
+bool AuctionSearchIndex::MatchesColumns(AuctionSearchQuery const& query, uint32 slot) const
+{
+    // removed since the last compaction
+    if (!_auctions[slot])
+        return false;
+
+    // skip expired auctions
+    if (_expireTime[slot] < query.CurTime)
+        return false;
+
+    if (query.ItemClass != 0xffffffff && _itemClass[slot] != query.ItemClass)
+        return false;
+
+    if (query.ItemSubClass != 0xffffffff && _itemSubClass[slot] != query.ItemSubClass)
+        return false;
+
+    if (query.InventoryType != 0xffffffff && _inventoryType[slot] != query.InventoryType)
+    {
+        // xinef: exception, robes are counted as chests
+        if (query.InventoryType != INVTYPE_CHEST || _inventoryType[slot] != INVTYPE_ROBE)
+            return false;
+    }
+
+    if (query.Quality != 0xffffffff && _quality[slot] != query.Quality)
+        return false;
+
+    if (query.LevelMin != 0x00 && (_requiredLevel[slot] < query.LevelMin || (query.LevelMax != 0x00 && _requiredLevel[slot] > query.LevelMax)))
+        return false;
+
+    return true;
+}
+
+void AuctionSearchIndex::GetTrigrams(std::wstring const& name, std::vector<uint64>& trigrams)
+{
+    trigrams.clear();
+    if (name.size() < 3)
+        return;
+
+    // wchar_t holds at most 21 bits of a code point
+    for (size_t i = 0; i + 2 < name.size(); ++i)
+        trigrams.push_back((uint64(name[i] & 0x1FFFFF) << 42) | (uint64(name[i + 1] & 0x1FFFFF) << 21) | uint64(name[i + 2] & 0x1FFFFF));
+
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+}
+
+void AuctionSearchIndex::AddToList(SlotList& list, uint32 slot)
+{
+    // new auctions get the highest id, so this appends in almost every case
+    uint32 auctionId = _auctionIds[slot];
+    if (list.empty() || _auctionIds[list.back()] < auctionId)
+    {
+        list.push_back(slot);
+        return;
+    }
+
+    auto itr = std::lower_bound(list.begin(), list.end(), auctionId, [this](uint32 listSlot, uint32 id) { return _auctionIds[listSlot] < id; });
+    list.insert(itr, slot);
+}
+
+void AuctionSearchIndex::AddName(LocaleNames& names, uint32 nameLocale, uint32 slot)
+{
+    if (names.Names.size() <= slot)
+        names.Names.resize(slot + 1);
+
+    std::wstring& name = names.Names[slot];
+    if (!_nameBuilder(_auctions[slot], nameLocale, name))
+    {
+        // never matches a search, like items without a name
+        name.clear();
+        return;
+    }
+
+    std::vector<uint64> trigrams;
+    GetTrigrams(name, trigrams);
+    for (uint64 trigram : trigrams)
+        AddToList(names.Trigrams[trigram], slot);
+}
+
+AuctionSearchIndex::LocaleNames& AuctionSearchIndex::GetLocaleNames(uint32 nameLocale)
+{
+    std::unique_ptr<LocaleNames>& names = _localeNames[nameLocale];
+    if (names)
+        return *names;
+
+    // first search in this locale, from now on it is kept up to date with the auctions
+    names.reset(new LocaleNames());
+    names->Names.resize(_auctions.size());
+    for (uint32 slot : _all)
+        if (_auctions[slot])
+            AddName(*names, nameLocale, slot);
+
+    return *names;
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-GPL2
+ */
+
+#ifndef _AUCTION_SEARCH_INDEX_H
+#define _AUCTION_SEARCH_INDEX_H
+
+#include "Define.h"
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct AuctionEntry;
+
+/// Item properties of an auction the search filters on
+struct AuctionSearchRow
+{
+    uint8 ItemClass;
+    uint8 ItemSubClass;
+    uint8 InventoryType;
+    uint8 Quality;
+    uint8 RequiredLevel;
+    time_t ExpireTime;
+};
+
+/// Filters of CMSG_AUCTION_LIST_ITEMS, 0xffffffff and 0 mean no filter like in the packet
+struct AuctionSearchQuery
+{
+    std::wstring Name;                                      // lower case, empty for no name filter
+    uint32 NameLocale = 0;                                  // see AuctionSearchIndex::NameBuilder
+    uint32 InventoryType = 0xffffffff;
+    uint32 ItemClass = 0xffffffff;
+    uint32 ItemSubClass = 0xffffffff;
+    uint32 Quality = 0xffffffff;
+    uint8 LevelMin = 0;
+    uint8 LevelMax = 0;
+    time_t CurTime = 0;
+};
+
+/// Secondary index over the auctions of one auction house.
+/// Filtered columns are kept in arrays indexed by slot, and auctions are listed per item class and
+/// subclass, and per name trigram for every locale added or searched in, all sorted by auction id.
+/// A search walks the shortest of these lists and checks the columns of each candidate, so its cost
+/// follows the number of auctions in that list instead of the number of auctions in the house.
+class AuctionSearchIndex
+{
+public:
+    /// Returns the lower case name of the auctioned item as listed to players of the given locale key
+    typedef std::function<bool(AuctionEntry const* auction, uint32 nameLocale, std::wstring& name)> NameBuilder;
+
+    explicit AuctionSearchIndex(NameBuilder nameBuilder);
+    ~AuctionSearchIndex();
+
+    void Insert(AuctionEntry* auction, uint32 auctionId, AuctionSearchRow const& row);
+    void Remove(uint32 auctionId);
+    /// Indexes the names in the locale now instead of at the first search in it
+    void AddLocale(uint32 nameLocale);
+
+    /// Appends the auctions matching the query to result, in auction id order
+    void Search(AuctionSearchQuery const& query, std::vector<AuctionEntry*>& result);
+
+    [[nodiscard]] uint32 GetCount() const { return uint32(_slots.size()); }
+
+private:
+    typedef std::vector<uint32> SlotList;                   // slots sorted by auction id
+
+    struct LocaleNames
+    {
+        std::vector<std::wstring> Names;                    // by slot
+        std::unordered_map<uint64, SlotList> Trigrams;
+    };
+
+    static uint32 ClassKey(uint32 itemClass) { return 0x10000 | itemClass; }
+    static uint32 SubClassKey(uint32 itemClass, uint32 itemSubClass) { return (itemClass << 8) | itemSubClass; }
+    static void GetTrigrams(std::wstring const& name, std::vector<uint64>& trigrams);
+
+    void AddToList(SlotList& list, uint32 slot);
+    void AddName(LocaleNames& names, uint32 nameLocale, uint32 slot);
+    void Compact();
+    LocaleNames& GetLocaleNames(uint32 nameLocale);
+    bool MatchesColumns(AuctionSearchQuery const& query, uint32 slot) const;
+
+    NameBuilder _nameBuilder;
+
+    // columns by slot, slots of removed auctions are reused after they are compacted out of the lists
+    std::vector<AuctionEntry*> _auctions;
+    std::vector<uint32> _auctionIds;
+    std::vector<uint8> _itemClass;
+    std::vector<uint8> _itemSubClass;
+    std::vector<uint8> _inventoryType;
+    std::vector<uint8> _quality;
+    std::vector<uint8> _requiredLevel;
+    std::vector<time_t> _expireTime;
+    std::vector<uint32> _freeSlots;
+    std::vector<uint32> _removedSlots;                      // still in the lists
+
+    std::unordered_map<uint32, uint32> _slots;              // auction id -> slot
+    SlotList _all;
+    std::unordered_map<uint32, SlotList> _classLists;
+    std::unordered_map<uint32, std::unique_ptr<LocaleNames>> _localeNames;
+};
+
+#endif
@@ -234,7 +234,7 @@ void ThreatContainer::clearReferences()
         delete (*i);
     }
 
-    iThreatList.clear();
+    iThreatList.Clear();
 }
 
 //============================================================
@@ -244,15 +244,7 @@ HostileReference* ThreatContainer::getReferenceByTarget(Unit* victim) const
     if (!victim)
         return nullptr;
 
-    uint64 const guid = victim->GetGUID();
-    for (ThreatContainer::StorageType::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
-    {
-        HostileReference* ref = (*i);
-        if (ref && ref->getUnitGuid() == guid)
-            return ref;
-    }
-
-    return nullptr;
+    return iThreatList.Find(victim->GetGUID());
 }
 
 //============================================================
@@ -275,12 +267,14 @@ void ThreatContainer::modifyThreatPercent(Unit* victim, int32 percent)
 }
 
 //============================================================
-// Check if the list is dirty and sort if necessary
+// Move the references with changed threat to their positions, sort the whole list if it is dirty
 
 void ThreatContainer::update()
 {
-    if (iDirty && iThreatList.size() > 1)
-        iThreatList.sort(acore::ThreatOrderPred());
+    if (iDirty)
+        iThreatList.Sort();
+    else
+        iThreatList.Update();
 
     iDirty = false;
 }
@@ -305,6 +299,9 @@ HostileReference* ThreatContainer::selectNextVictim(Creature* attacker, HostileR
             currentVictim = nullptr;
         else if (cvUnit->IsImmunedToDamageOrSchool(attacker->GetMeleeDamageSchoolMask()) || cvUnit->HasNegativeAuraWithInterruptFlag(AURA_INTERRUPT_FLAG_TAKE_DAMAGE)) // pussywizard: no 10%/30% if currentVictim is immune to damage or has auras breakable by damage
             currentVictim = nullptr;
+        // the list is in threat order, if the highest threat does not exceed 110% of currentVictim's no target can take it over
+        else if (!cvUnit->HasAuraTypeWithCaster(SPELL_AURA_IGNORED, attacker->GetGUID()) && getMostHated()->getThreat() <= 1.1f * currentVictim->getThreat())
+            return currentVictim;
     }
 
     ThreatContainer::StorageType::const_iterator lastRef = iThreatList.end();
@@ -534,18 +531,14 @@ void ThreatManager::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStat
     switch (threatRefStatusChangeEvent->getType())
     {
         case UEV_THREAT_REF_THREAT_CHANGE:
-            if ((getCurrentVictim() == hostilRef && threatRefStatusChangeEvent->getFValue() < 0.0f) ||
-                    (getCurrentVictim() != hostilRef && threatRefStatusChangeEvent->getFValue() > 0.0f))
-                setDirty(true);                             // the order in the threat list might have changed
+            if (hostilRef->isOnline())
+                iThreatContainer.threatChanged(hostilRef);  // the order in the threat list might have changed
             break;
         case UEV_THREAT_REF_ONLINE_STATUS:
             if (!hostilRef->isOnline())
             {
                 if (hostilRef == getCurrentVictim())
-                {
                     setCurrentVictim(nullptr);
-                    setDirty(true);
-                }
                 if (GetOwner() && GetOwner()->IsInWorld())
                     if (Unit* target = ObjectAccessor::GetUnit(*GetOwner(), hostilRef->getUnitGuid()))
                         if (GetOwner()->IsInMap(target))
@@ -555,23 +548,23 @@ void ThreatManager::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStat
             }
             else
             {
-                if (getCurrentVictim() && hostilRef->getThreat() > (1.1f * getCurrentVictim()->getThreat()))
-                    setDirty(true);
                 iThreatContainer.addReference(hostilRef);
                 iThreatOfflineContainer.remove(hostilRef);
             }
+            // nothing selects victims from the offline list, it is compacted here or its removed positions pile up
+            iThreatOfflineContainer.update();
             break;
         case UEV_THREAT_REF_REMOVE_FROM_LIST:
             if (hostilRef == getCurrentVictim())
-            {
                 setCurrentVictim(nullptr);
-                setDirty(true);
-            }
             iOwner->SendRemoveFromThreatListOpcode(hostilRef);
             if (hostilRef->isOnline())
                 iThreatContainer.remove(hostilRef);
             else
+            {
                 iThreatOfflineContainer.remove(hostilRef);
+                iThreatOfflineContainer.update();
+            }
             break;
     }
 }
@@ -10,8 +10,8 @@
 #include "Common.h"
 #include "LinkedReference/Reference.h"
 #include "SharedDefines.h"
+#include "ThreatStorage.h"
 #include "UnitEvents.h"
-#include <list>
 
 //==============================================================
 
@@ -125,7 +125,7 @@ class ThreatContainer
     friend class ThreatManager;
 
 public:
-    typedef std::list<HostileReference*> StorageType;
+    typedef ThreatStorage<HostileReference> StorageType;
 
     ThreatContainer() { }
 
@@ -158,17 +158,22 @@ public:
 private:
     void remove(HostileReference* hostileRef)
     {
-        iThreatList.remove(hostileRef);
+        iThreatList.Remove(hostileRef);
     }
 
     void addReference(HostileReference* hostileRef)
     {
-        iThreatList.push_back(hostileRef);
+        iThreatList.Add(hostileRef);
+    }
+
+    void threatChanged(HostileReference* hostileRef)
+    {
+        iThreatList.ThreatChanged(hostileRef);
     }
 
     void clearReferences();
 
-    // Sort the list if necessary
+    // Restore the threat order if necessary
     void update();
 
     StorageType iThreatList;
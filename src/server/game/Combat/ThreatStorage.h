@@ -0,0 +1,275 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-GPL2
+ */
+
+#ifndef _THREAT_STORAGE_H
+#define _THREAT_STORAGE_H
+
+#include "Define.h"
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+/// Contiguous threat list, ordered from the highest to the lowest threat by Update().
+/// References whose threat changed are only flagged, Update() takes them out and merges them back at their
+/// new positions, so keeping the order costs a pass over the list instead of a full sort of it.
+/// The guid and the threat of every reference are kept next to it, target lookups and merges don't touch the references.
+/// Iterators are positions in the list like with FlatAuraList: references added while iterating are reached,
+/// removed ones leave an empty position that iteration skips until the next Update().
+/// Ref needs getThreat() and getUnitGuid().
+template <class Ref>
+class ThreatStorage
+{
+public:
+    typedef Ref* value_type;
+    typedef Ref* const& const_reference;
+
+    class const_iterator
+    {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef Ref* value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Ref* const* pointer;
+        typedef Ref* const& reference;
+
+        const_iterator() : _list(nullptr), _index(0) { }
+        const_iterator(ThreatStorage const* list, uint32 index) : _list(list), _index(index) { }
+
+        reference operator*() const { return _list->_refs[_index]; }
+        pointer operator->() const { return &_list->_refs[_index]; }
+
+        const_iterator& operator++()
+        {
+            ++_index;
+            _index = _list->Skip(_index);
+            return *this;
+        }
+
+        const_iterator operator++(int) { const_iterator tmp = *this; ++*this; return tmp; }
+
+        const_iterator& operator--()
+        {
+            do
+                --_index;
+            while (_index > 0 && !_list->_refs[_index]);
+            return *this;
+        }
+
+        const_iterator operator--(int) { const_iterator tmp = *this; --*this; return tmp; }
+
+        bool operator==(const_iterator const& right) const { return _index == right._index; }
+        bool operator!=(const_iterator const& right) const { return _index != right._index; }
+
+    private:
+        ThreatStorage const* _list;
+        uint32 _index;
+    };
+
+    // references are only read through iterators, the list is changed by its ThreatContainer
+    typedef const_iterator iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef const_reverse_iterator reverse_iterator;
+
+    ThreatStorage() : _count(0), _changed(false) { }
+    ThreatStorage(ThreatStorage const& right) : _count(0), _changed(false) { *this = right; }
+
+    ThreatStorage& operator=(ThreatStorage const& right)
+    {
+        if (this == &right)
+            return *this;
+
+        Clear();
+        Reserve(right._count);
+        for (uint32 i = 0; i < right._refs.size(); ++i)
+            if (right._refs[i])
+                Append(right._refs[i], right._guids[i], right._threats[i], right._moved[i]);
+        _count = right._count;
+        _changed = right._changed;
+        return *this;
+    }
+
+    const_iterator begin() const { return const_iterator(this, Skip(0)); }
+    const_iterator end() const { return const_iterator(this, uint32(_refs.size())); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    [[nodiscard]] bool empty() const { return _count == 0; }
+    [[nodiscard]] size_t size() const { return _count; }
+    Ref* front() const { return *begin(); }
+    Ref* back() const { return *rbegin(); }
+
+    /// Adds ref at the end, Update() moves it to its position
+    void Add(Ref* ref)
+    {
+        Append(ref, ref->getUnitGuid(), ref->getThreat(), true);
+        ++_count;
+        _changed = true;
+    }
+
+    /// Empties the position of ref, Update() gives it back, so lists that are changed often need their Update() called
+    void Remove(Ref* ref)
+    {
+        for (uint32 i = 0; i < _refs.size(); ++i)
+        {
+            if (_refs[i] == ref)
+            {
+                _refs[i] = nullptr;
+                _guids[i] = 0;
+                --_count;
+                _changed = true;
+            }
+        }
+    }
+
+    /// Flags ref to be moved to the position of its new threat by the next Update()
+    void ThreatChanged(Ref* ref)
+    {
+        for (uint32 i = 0; i < _refs.size(); ++i)
+        {
+            if (_refs[i] == ref)
+            {
+                _moved[i] = true;
+                _changed = true;
+            }
+        }
+    }
+
+    void Clear()
+    {
+        _refs.clear();
+        _guids.clear();
+        _threats.clear();
+        _moved.clear();
+        _count = 0;
+        _changed = false;
+    }
+
+    [[nodiscard]] Ref* Find(uint64 guid) const
+    {
+        for (uint32 i = 0; i < _guids.size(); ++i)
+            if (_guids[i] == guid)
+                return _refs[i];
+        return nullptr;
+    }
+
+    /// True if references were added, removed or flagged since the last Update()
+    [[nodiscard]] bool NeedsUpdate() const { return _changed; }
+
+    /// Restores the threat order and gives back the positions of removed references.
+    /// Flagged references keep their relative order, and are placed after unflagged ones of the same threat.
+    /// The list must not be iterated meanwhile.
+    void Update()
+    {
+        if (!_changed)
+            return;
+
+        _changed = false;
+
+        // unflagged references are still in threat order, the flagged ones are taken out
+        _movedRefs.clear();
+        uint32 used = 0;
+        for (uint32 i = 0; i < _refs.size(); ++i)
+        {
+            if (!_refs[i])
+                continue;
+
+            if (_moved[i])
+            {
+                _movedRefs.push_back(_refs[i]);
+                continue;
+            }
+
+            _refs[used] = _refs[i];
+            _guids[used] = _guids[i];
+            _threats[used] = _threats[i];
+            ++used;
+        }
+
+        if (_movedRefs.empty())
+        {
+            Resize(used);
+            return;
+        }
+
+        std::stable_sort(_movedRefs.begin(), _movedRefs.end(), [](Ref const* left, Ref const* right) { return left->getThreat() > right->getThreat(); });
+
+        // merge from the back, into the positions freed by the flagged references
+        Resize(used + uint32(_movedRefs.size()));
+        std::fill(_moved.begin(), _moved.end(), false);
+
+        uint32 out = uint32(_refs.size());
+        uint32 kept = used;
+        uint32 moved = uint32(_movedRefs.size());
+        while (moved > 0)
+        {
+            Ref* ref = _movedRefs[moved - 1];
+            float threat = ref->getThreat();
+            --out;
+
+            if (kept > 0 && _threats[kept - 1] < threat)
+            {
+                --kept;
+                _refs[out] = _refs[kept];
+                _guids[out] = _guids[kept];
+                _threats[out] = _threats[kept];
+                continue;
+            }
+
+            _refs[out] = ref;
+            _guids[out] = ref->getUnitGuid();
+            _threats[out] = threat;
+            --moved;
+        }
+    }
+
+    /// Orders the whole list again, for threat changes that were not flagged. The list must not be iterated meanwhile.
+    void Sort()
+    {
+        std::fill(_moved.begin(), _moved.end(), true);
+        _changed = true;
+        Update();
+    }
+
+private:
+    uint32 Skip(uint32 index) const
+    {
+        while (index < _refs.size() && !_refs[index])
+            ++index;
+        return index;
+    }
+
+    void Append(Ref* ref, uint64 guid, float threat, bool moved)
+    {
+        _refs.push_back(ref);
+        _guids.push_back(guid);
+        _threats.push_back(threat);
+        _moved.push_back(moved);
+    }
+
+    void Reserve(uint32 size)
+    {
+        _refs.reserve(size);
+        _guids.reserve(size);
+        _threats.reserve(size);
+        _moved.reserve(size);
+    }
+
+    void Resize(uint32 size)
+    {
+        _refs.resize(size);
+        _guids.resize(size);
+        _threats.resize(size);
+        _moved.resize(size);
+    }
+
+    std::vector<Ref*> _refs;
+    std::vector<uint64> _guids;                             // 0 for removed references
+    std::vector<float> _threats;                            // threat of each reference at the last Update()
+    std::vector<bool> _moved;                               // threat changed since the last Update()
+    std::vector<Ref*> _movedRefs;
+    uint32 _count;
+    bool _changed;
+};
+
+#endif
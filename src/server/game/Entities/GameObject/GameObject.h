@@ -732,7 +732,9 @@ public:
     explicit GameObject();
     ~GameObject() override;
 
-    void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const override;
+    void AddForcedUpdateFields(uint32 visibleFlag, UpdateMask& updateMask) const override;
+    uint32 GetUpdateFieldValue(uint16 index, Player* target) const override;
+    [[nodiscard]] bool IsUpdateFieldTargetDependent(uint16 index) const override;
 
     void AddToWorld() override;
     void RemoveFromWorld() override;
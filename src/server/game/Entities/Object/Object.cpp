@@ -265,14 +265,40 @@ void Object::SendUpdateToPlayer(Player* player)
     player->GetSession()->SendPacket(&packet);
 }
 
-void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) const
+void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target, ValuesUpdateCache* cache) const
 {
     ByteBuffer buf(500);
 
     buf << (uint8) UPDATETYPE_VALUES;
     buf.append(GetPackGUID());
 
-    BuildValuesUpdate(UPDATETYPE_VALUES, &buf, target);
+    if (!cache)
+    {
+        BuildValuesUpdate(UPDATETYPE_VALUES, &buf, target);
+        data->AddUpdateBlock(buf);
+        return;
+    }
+
+    // observers with the same field visibility get the same fields, only the target dependant values differ
+    uint32* flags = nullptr;
+    uint32 visibleFlag = GetUpdateFieldData(target, flags);
+
+    ValuesUpdateCache::const_iterator itr = std::find_if(cache->begin(), cache->end(), [visibleFlag](ValuesUpdateCacheEntry const& entry) { return entry.VisibleFlag == visibleFlag; });
+    if (itr == cache->end())
+    {
+        cache->emplace_back();
+        ValuesUpdateCacheEntry& entry = cache->back();
+        entry.VisibleFlag = visibleFlag;
+        BuildValuesUpdate(UPDATETYPE_VALUES, &entry.Values, target, &entry.TargetFields);
+        buf.append(entry.Values);
+    }
+    else
+    {
+        size_t valuesPos = buf.wpos();
+        buf.append(itr->Values);
+        for (auto const& field : itr->TargetFields)
+            buf.put<uint32>(valuesPos + field.first, GetUpdateFieldValue(field.second, target));
+    }
 
     data->AddUpdateBlock(buf);
 }
@@ -463,31 +489,42 @@ void Object::BuildMovementUpdate(ByteBuffer* data, uint16 flags) const
         *data << int64(ToGameObject()->GetPackedWorldRotation());
 }
 
-void Object::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target) const
+void Object::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target, TargetUpdateFieldList* targetFields) const
 {
     if (!target)
         return;
 
-    ByteBuffer fieldBuffer;
-    UpdateMask updateMask;
-    updateMask.SetCount(m_valuesCount);
-
     uint32* flags = nullptr;
     uint32 visibleFlag = GetUpdateFieldData(target, flags);
+    UpdateFieldFlagsMasks const& flagsMasks = UpdateFieldFlagsMasks::Get(flags);
 
-    for (uint16 index = 0; index < m_valuesCount; ++index)
-    {
-        if (_fieldNotifyFlags & flags[index] ||
-                ((updateType == UPDATETYPE_VALUES ? _changesMask.GetBit(index) : m_uint32Values[index]) && (flags[index] & visibleFlag)))
+    // visible fields that changed, or are set when creating
+    UpdateMask updateMask;
+    updateMask.SetCount(m_valuesCount);
+    flagsMasks.AddFields(visibleFlag, updateMask);
+
+    if (updateType == UPDATETYPE_VALUES)
+        updateMask &= _changesMask;
+    else
+        updateMask.ForEachSetBit([&](uint32 index)
         {
-            updateMask.SetBit(index);
-            fieldBuffer << m_uint32Values[index];
-        }
-    }
+            if (!m_uint32Values[index])
+                updateMask.UnsetBit(index);
+        });
+
+    flagsMasks.AddFields(_fieldNotifyFlags, updateMask);
+    AddForcedUpdateFields(visibleFlag, updateMask);
 
     *data << uint8(updateMask.GetBlockCount());
     updateMask.AppendToPacket(data);
-    data->append(fieldBuffer);
+
+    updateMask.ForEachSetBit([&](uint32 index)
+    {
+        if (targetFields && IsUpdateFieldTargetDependent(index))
+            targetFields->emplace_back(data->wpos(), uint16(index));
+
+        *data << GetUpdateFieldValue(index, target);
+    });
 }
 
 void Object::ClearUpdateMask(bool remove)
@@ -502,7 +539,7 @@ void Object::ClearUpdateMask(bool remove)
     }
 }
 
-void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) const
+void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map, ValuesUpdateCache* cache) const
 {
     UpdateDataMapType::iterator iter = data_map.find(player);
 
@@ -513,7 +550,7 @@ void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) cons
         iter = p.first;
     }
 
-    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first, cache);
 }
 
 uint32 Object::GetUpdateFieldData(Player const* target, uint32*& flags) const
@@ -2926,7 +2963,7 @@ void WorldObject::AddToNotify(uint16 f)
         {
             if (f & NOTIFY_VISIBILITY_CHANGED)
             {
-                uint32 EVENT_VISIBILITY_DELAY = u->FindMap() ? DynamicVisibilityMgr::GetVisibilityNotifyDelay(u->FindMap()->GetEntry()->map_type) : 1000;
+                uint32 EVENT_VISIBILITY_DELAY = u->FindMap() ? DynamicVisibilityMgr::GetVisibilityNotifyDelay(u->FindMap()) : 1000;
 
                 uint32 diff = getMSTimeDiff(u->m_last_notify_mstime, World::GetGameTimeMS());
                 if (diff >= EVENT_VISIBILITY_DELAY / 2)
@@ -2938,7 +2975,7 @@ void WorldObject::AddToNotify(uint16 f)
             }
             else if (f & NOTIFY_AI_RELOCATION)
             {
-                u->m_delayed_unit_ai_notify_timer = u->FindMap() ? DynamicVisibilityMgr::GetAINotifyDelay(u->FindMap()->GetEntry()->map_type) : 500;
+                u->m_delayed_unit_ai_notify_timer = u->FindMap() ? DynamicVisibilityMgr::GetAINotifyDelay(u->FindMap()) : 500;
             }
 
             m_notifyflags |= f;
@@ -2950,6 +2987,7 @@ struct WorldObjectChangeAccumulator
     UpdateDataMapType& i_updateDatas;
     UpdatePlayerSet& i_playerSet;
     WorldObject& i_object;
+    ValuesUpdateCache i_valuesCache;
     WorldObjectChangeAccumulator(WorldObject& obj, UpdateDataMapType& d, UpdatePlayerSet& p) : i_updateDatas(d), i_playerSet(p), i_object(obj)
     {
         i_playerSet.clear();
@@ -3010,7 +3048,7 @@ struct WorldObjectChangeAccumulator
         // Only send update once to a player
         if (i_playerSet.find(player->GetGUIDLow()) == i_playerSet.end() && player->HaveAtClient(&i_object))
         {
-            i_object.BuildFieldsUpdate(player, i_updateDatas);
+            i_object.BuildFieldsUpdate(player, i_updateDatas, &i_valuesCache);
             i_playerSet.insert(player->GetGUIDLow());
         }
     }
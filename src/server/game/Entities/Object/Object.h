@@ -99,6 +99,20 @@ class MotionTransport;
 typedef std::unordered_map<Player*, UpdateData> UpdateDataMapType;
 typedef std::unordered_set<uint32> UpdatePlayerSet;
 
+// write position in a values block and index of a field whose value depends on the receiving player
+typedef std::vector<std::pair<size_t, uint16>> TargetUpdateFieldList;
+
+/// Values block built for one observer of an object, reused for the other observers with the same field visibility
+struct ValuesUpdateCacheEntry
+{
+    uint32 VisibleFlag;
+    ByteBuffer Values;
+    TargetUpdateFieldList TargetFields;
+};
+
+/// Values blocks of one object during one update, see Object::BuildFieldsUpdate
+typedef std::vector<ValuesUpdateCacheEntry> ValuesUpdateCache;
+
 class Object
 {
 public:
@@ -126,7 +140,7 @@ public:
     virtual void BuildCreateUpdateBlockForPlayer(UpdateData* data, Player* target) const;
     void SendUpdateToPlayer(Player* player);
 
-    void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) const;
+    void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target, ValuesUpdateCache* cache = nullptr) const;
     void BuildOutOfRangeUpdateBlock(UpdateData* data) const;
     void BuildMovementUpdateBlock(UpdateData* data, uint32 flags = 0) const;
 
@@ -281,7 +295,7 @@ public:
     [[nodiscard]] virtual bool hasQuest(uint32 /* quest_id */) const { return false; }
     [[nodiscard]] virtual bool hasInvolvedQuest(uint32 /* quest_id */) const { return false; }
     virtual void BuildUpdate(UpdateDataMapType&, UpdatePlayerSet&) {}
-    void BuildFieldsUpdate(Player*, UpdateDataMapType&) const;
+    void BuildFieldsUpdate(Player*, UpdateDataMapType&, ValuesUpdateCache* cache = nullptr) const;
 
     void SetFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags |= flag; }
     void RemoveFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags &= ~flag; }
@@ -318,7 +332,14 @@ protected:
     uint32 GetUpdateFieldData(Player const* target, uint32*& flags) const;
 
     void BuildMovementUpdate(ByteBuffer* data, uint16 flags) const;
-    virtual void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const;
+    void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target, TargetUpdateFieldList* targetFields = nullptr) const;
+
+    /// Fields sent regardless of their flags and changes, besides the ones of _fieldNotifyFlags
+    virtual void AddForcedUpdateFields(uint32 /*visibleFlag*/, UpdateMask& /*updateMask*/) const { }
+    /// Value of the field as sent to the target
+    virtual uint32 GetUpdateFieldValue(uint16 index, Player* /*target*/) const { return m_uint32Values[index]; }
+    /// Whether GetUpdateFieldValue depends on more than the field visibility of the target
+    [[nodiscard]] virtual bool IsUpdateFieldTargetDependent(uint16 /*index*/) const { return false; }
 
     uint16 m_objectType;
 
@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-GPL2
+ */
+
+#include "UpdateCompressor.h"
+#include "Log.h"
+#include "Opcodes.h"
+#include "World.h"
+#include "WorldPacket.h"
+#include "zlib.h"
+#include <chrono>
+
+namespace
+{
+    // deflate state of the current thread, kept between packets
+    struct DeflateStream
+    {
+        DeflateStream() : Level(0) { }
+        ~DeflateStream() { End(); }
+
+        bool Begin(int level)
+        {
+            if (Level == level)
+                return deflateReset(&Stream) == Z_OK;
+
+            // first packet of this thread, or the level was changed by a config reload
+            End();
+
+            Stream.zalloc = (alloc_func)0;
+            Stream.zfree = (free_func)0;
+            Stream.opaque = (voidpf)0;
+
+            int z_res = deflateInit(&Stream, level);
+            if (z_res != Z_OK)
+            {
+                sLog->outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
+                return false;
+            }
+
+            Level = level;
+            return true;
+        }
+
+        void End()
+        {
+            if (!Level)
+                return;
+
+            deflateEnd(&Stream);
+            Level = 0;
+        }
+
+        z_stream Stream;
+        int Level;                                          // 0 while no stream is allocated
+    };
+
+    thread_local DeflateStream threadStream;
+}
+
+void UpdateCompressionBatch::Wait()
+{
+    std::unique_lock<std::mutex> guard(_lock);
+
+    while (_pending > 0)
+        _condition.wait(guard);
+}
+
+void UpdateCompressionBatch::Finished()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+
+    --_pending;
+
+    _condition.notify_all();
+}
+
+UpdateCompressor::UpdateCompressor() : _cancelationToken(false), _compressedPackets(0), _offloadedPackets(0), _uncompressedPackets(0),
+    _inputBytes(0), _outputBytes(0), _compressTime(0)
+{
+}
+
+UpdateCompressor::~UpdateCompressor()
+{
+    Deactivate();
+}
+
+UpdateCompressor* UpdateCompressor::instance()
+{
+    static UpdateCompressor instance;
+    return &instance;
+}
+
+void UpdateCompressor::Initialize()
+{
+    if (IsActive())
+        return;
+
+    _cancelationToken = false;
+    for (uint32 i = 0; i < sWorld->getIntConfig(CONFIG_COMPRESSION_THREADS); ++i)
+        _workerThreads.push_back(std::thread(&UpdateCompressor::WorkerThread, this));
+}
+
+void UpdateCompressor::Deactivate()
+{
+    if (!IsActive())
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _cancelationToken = true;
+        _condition.notify_all();
+    }
+
+    for (auto& thread : _workerThreads)
+        thread.join();
+
+    _workerThreads.clear();
+}
+
+bool UpdateCompressor::CompressPacket(WorldPacket* packet, ByteBuffer const& source)
+{
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    uint32 pSize = uint32(source.wpos());
+    uint32 destsize = compressBound(pSize);
+    packet->resize(destsize + sizeof(uint32));
+
+    packet->put<uint32>(0, pSize);
+    if (!Compress(const_cast<uint8*>(packet->contents()) + sizeof(uint32), &destsize, source.contents(), pSize))
+    {
+        packet->clear();
+        return false;
+    }
+
+    packet->resize(destsize + sizeof(uint32));
+    packet->SetOpcode(SMSG_COMPRESSED_UPDATE_OBJECT);
+
+    _compressedPackets.fetch_add(1, std::memory_order_relaxed);
+    _inputBytes.fetch_add(pSize, std::memory_order_relaxed);
+    _outputBytes.fetch_add(destsize + sizeof(uint32), std::memory_order_relaxed);
+    _compressTime.fetch_add(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count(), std::memory_order_relaxed);
+    return true;
+}
+
+bool UpdateCompressor::CompressPacket(WorldPacket* packet, ByteBuffer&& source, UpdateCompressionBatch& batch)
+{
+    if (!IsActive() || source.wpos() < sWorld->getIntConfig(CONFIG_COMPRESSION_OFFLOAD_THRESHOLD))
+        return CompressPacket(packet, source);
+
+    {
+        std::lock_guard<std::mutex> guard(batch._lock);
+        ++batch._pending;
+    }
+
+    std::lock_guard<std::mutex> guard(_lock);
+
+    _requests.push_back({ &batch, packet, std::move(source) });
+    _offloadedPackets.fetch_add(1, std::memory_order_relaxed);
+
+    _condition.notify_one();
+    return true;
+}
+
+bool UpdateCompressor::Compress(uint8* dst, uint32* dstSize, uint8 const* src, uint32 srcSize)
+{
+    DeflateStream& stream = threadStream;
+    if (!stream.Begin(sWorld->getIntConfig(CONFIG_COMPRESSION)))
+        return false;
+
+    z_stream& c_stream = stream.Stream;
+    c_stream.next_out = (Bytef*)dst;
+    c_stream.avail_out = *dstSize;
+    c_stream.next_in = (Bytef*)src;
+    c_stream.avail_in = (uInt)srcSize;
+
+    // the output buffer is compressBound() large, so a single call compresses everything
+    int z_res = deflate(&c_stream, Z_FINISH);
+    if (z_res != Z_STREAM_END)
+    {
+        sLog->outError("Can't compress update packet (zlib: deflate should report Z_STREAM_END instead %i (%s)", z_res, zError(z_res));
+        stream.End();
+        return false;
+    }
+
+    *dstSize = uint32(c_stream.total_out);
+    return true;
+}
+
+void UpdateCompressor::WorkerThread()
+{
+    while (1)
+    {
+        CompressionRequest request;
+
+        {
+            std::unique_lock<std::mutex> guard(_lock);
+
+            while (_requests.empty() && !_cancelationToken)
+                _condition.wait(guard);
+
+            // queued packets are still compressed, their map thread is waiting for them
+            if (_requests.empty())
+                return;
+
+            request = std::move(_requests.front());
+            _requests.pop_front();
+        }
+
+        CompressPacket(request.Packet, request.Source);
+        request.Batch->Finished();
+    }
+}
+
+UpdateCompressionStats UpdateCompressor::GetStats() const
+{
+    UpdateCompressionStats stats;
+    stats.CompressedPackets = _compressedPackets;
+    stats.OffloadedPackets = _offloadedPackets;
+    stats.UncompressedPackets = _uncompressedPackets;
+    stats.InputBytes = _inputBytes;
+    stats.OutputBytes = _outputBytes;
+    stats.CompressTime = _compressTime;
+    return stats;
+}
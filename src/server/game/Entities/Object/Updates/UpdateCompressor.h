@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-GPL2
+ */
+
+#ifndef _UPDATE_COMPRESSOR_H_INCLUDED
+#define _UPDATE_COMPRESSOR_H_INCLUDED
+
+#include "ByteBuffer.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorldPacket;
+
+/// Totals since startup of the update packets built by UpdateData::BuildPacket
+struct UpdateCompressionStats
+{
+    uint64 CompressedPackets;
+    uint64 OffloadedPackets;                                // compressed by the compression threads
+    uint64 UncompressedPackets;                             // below Compression.Threshold
+    uint64 InputBytes;                                      // size of the compressed packets before compression
+    uint64 OutputBytes;
+    uint64 CompressTime;                                    // microseconds, in all threads
+};
+
+/// Packets of one map update whose compression was handed to the compression threads.
+/// Wait() must return before the packets are sent or destroyed.
+class UpdateCompressionBatch
+{
+public:
+    UpdateCompressionBatch() : _pending(0) { }
+    ~UpdateCompressionBatch() { Wait(); }
+
+    void Wait();
+
+private:
+    friend class UpdateCompressor;
+
+    void Finished();
+
+    std::mutex _lock;
+    std::condition_variable _condition;
+    uint32 _pending;
+};
+
+/// Compresses SMSG_COMPRESSED_UPDATE_OBJECT packets.
+/// Every thread keeps its own deflate stream and only resets it between packets, instead of allocating
+/// and freeing the zlib state for each of them. Packets of at least Compression.OffloadThreshold bytes
+/// may be compressed by Compression.Threads worker threads, so the map thread builds the other packets
+/// of its update meanwhile; it waits for the batch before sending them, which keeps each session's packets in order.
+class UpdateCompressor
+{
+public:
+    UpdateCompressor();
+    ~UpdateCompressor();
+
+    static UpdateCompressor* instance();
+
+    void Initialize();
+    void Deactivate();
+    bool IsActive() const { return !_workerThreads.empty(); }
+
+    /// Compresses source into packet, with the uncompressed size in front as the client expects. Returns false on zlib errors.
+    bool CompressPacket(WorldPacket* packet, ByteBuffer const& source);
+
+    /// Compresses source into packet like CompressPacket, on a compression thread if the packet is large enough.
+    /// Returns false if it was compressed here and failed, the packet is left empty when a compression thread fails.
+    bool CompressPacket(WorldPacket* packet, ByteBuffer&& source, UpdateCompressionBatch& batch);
+
+    void RecordUncompressed() { _uncompressedPackets.fetch_add(1, std::memory_order_relaxed); }
+    UpdateCompressionStats GetStats() const;
+
+private:
+    struct CompressionRequest
+    {
+        UpdateCompressionBatch* Batch;
+        WorldPacket* Packet;
+        ByteBuffer Source;
+    };
+
+    bool Compress(uint8* dst, uint32* dstSize, uint8 const* src, uint32 srcSize);
+    void WorkerThread();
+
+    std::vector<std::thread> _workerThreads;
+    std::atomic<bool> _cancelationToken;
+
+    std::mutex _lock;
+    std::condition_variable _condition;
+    std::deque<CompressionRequest> _requests;
+
+    std::atomic<uint64> _compressedPackets;
+    std::atomic<uint64> _offloadedPackets;
+    std::atomic<uint64> _uncompressedPackets;
+    std::atomic<uint64> _inputBytes;
+    std::atomic<uint64> _outputBytes;
+    std::atomic<uint64> _compressTime;
+};
+
+#define sUpdateCompressor UpdateCompressor::instance()
+
+#endif //_UPDATE_COMPRESSOR_H_INCLUDED
@@ -8,10 +8,10 @@
 #include "Common.h"
 #include "Log.h"
 #include "Opcodes.h"
+#include "UpdateCompressor.h"
 #include "UpdateData.h"
 #include "World.h"
 #include "WorldPacket.h"
-#include "zlib.h"
 
 UpdateData::UpdateData() : m_blockCount(0)
 {
@@ -31,67 +31,12 @@ void UpdateData::AddUpdateBlock(const ByteBuffer& block)
 
 void UpdateData::AddUpdateBlock(const UpdateData& block)
 {
+    m_outOfRangeGUIDs.insert(m_outOfRangeGUIDs.end(), block.m_outOfRangeGUIDs.begin(), block.m_outOfRangeGUIDs.end());
     m_data.append(block.m_data);
     m_blockCount += block.m_blockCount;
 }
 
-void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
-{
-    z_stream c_stream;
-
-    c_stream.zalloc = (alloc_func)0;
-    c_stream.zfree = (free_func)0;
-    c_stream.opaque = (voidpf)0;
-
-    // default Z_BEST_SPEED (1)
-    int z_res = deflateInit(&c_stream, sWorld->getIntConfig(CONFIG_COMPRESSION));
-    if (z_res != Z_OK)
-    {
-        sLog->outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
-
-    c_stream.next_out = (Bytef*)dst;
-    c_stream.avail_out = *dst_size;
-    c_stream.next_in = (Bytef*)src;
-    c_stream.avail_in = (uInt)src_size;
-
-    z_res = deflate(&c_stream, Z_NO_FLUSH);
-    if (z_res != Z_OK)
-    {
-        sLog->outError("Can't compress update packet (zlib: deflate) Error code: %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
-
-    if (c_stream.avail_in != 0)
-    {
-        sLog->outError("Can't compress update packet (zlib: deflate not greedy)");
-        *dst_size = 0;
-        return;
-    }
-
-    z_res = deflate(&c_stream, Z_FINISH);
-    if (z_res != Z_STREAM_END)
-    {
-        sLog->outError("Can't compress update packet (zlib: deflate should report Z_STREAM_END instead %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
-
-    z_res = deflateEnd(&c_stream);
-    if (z_res != Z_OK)
-    {
-        sLog->outError("Can't compress update packet (zlib: deflateEnd) Error code: %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
-
-    *dst_size = c_stream.total_out;
-}
-
-bool UpdateData::BuildPacket(WorldPacket* packet)
+bool UpdateData::BuildPacket(WorldPacket* packet, UpdateCompressionBatch* batch)
 {
     ASSERT(packet->empty());                                // shouldn't happen
 
@@ -114,23 +59,18 @@ bool UpdateData::BuildPacket(WorldPacket* packet)
 
     size_t pSize = buf.wpos();                              // use real used data size
 
-    if (pSize > 100)                                       // compress large packets
+    if (pSize > sWorld->getIntConfig(CONFIG_COMPRESSION_THRESHOLD))   // compress large packets
     {
-        uint32 destsize = compressBound(pSize);
-        packet->resize(destsize + sizeof(uint32));
-
-        packet->put<uint32>(0, pSize);
-        Compress(const_cast<uint8*>(packet->contents()) + sizeof(uint32), &destsize, (void*)buf.contents(), pSize);
-        if (destsize == 0)
-            return false;
+        if (batch)
+            return sUpdateCompressor->CompressPacket(packet, std::move(buf), *batch);
 
-        packet->resize(destsize + sizeof(uint32));
-        packet->SetOpcode(SMSG_COMPRESSED_UPDATE_OBJECT);
+        return sUpdateCompressor->CompressPacket(packet, buf);
     }
     else                                                    // send small packets without compression
     {
         packet->append(buf);
         packet->SetOpcode(SMSG_UPDATE_OBJECT);
+        sUpdateCompressor->RecordUncompressed();
     }
 
     return true;
@@ -9,6 +9,7 @@
 
 #include "ByteBuffer.h"
 
+class UpdateCompressionBatch;
 class WorldPacket;
 
 enum OBJECT_UPDATE_TYPE
@@ -43,16 +44,18 @@ public:
 
     void AddOutOfRangeGUID(uint64 guid);
     void AddUpdateBlock(const ByteBuffer& block);
+    /// Appends the blocks and the out of range GUIDs of another UpdateData
     void AddUpdateBlock(const UpdateData& block);
-    bool BuildPacket(WorldPacket* packet);
+    /// With a batch, the compression of large packets may be left to the compression threads, see UpdateCompressor
+    bool BuildPacket(WorldPacket* packet, UpdateCompressionBatch* batch = nullptr);
     [[nodiscard]] bool HasData() const { return m_blockCount > 0 || !m_outOfRangeGUIDs.empty(); }
+    [[nodiscard]] uint32 GetBlockCount() const { return m_blockCount; }
+    [[nodiscard]] bool HasOutOfRangeGUIDs() const { return !m_outOfRangeGUIDs.empty(); }
     void Clear();
 
 protected:
     uint32 m_blockCount;
     std::vector<uint64> m_outOfRangeGUIDs;
     ByteBuffer m_data;
-
-    void Compress(void* dst, uint32* dst_size, void* src, int src_size);
 };
 #endif
@@ -1555,3 +1555,44 @@ uint32 CorpseUpdateFieldFlags[CORPSE_END] =
     UF_FLAG_DYNAMIC,                                        // CORPSE_FIELD_DYNAMIC_FLAGS
     UF_FLAG_NONE,                                           // CORPSE_FIELD_PAD
 };
+
+UpdateFieldFlagsMasks::UpdateFieldFlagsMasks(uint32 const* flags, uint32 count)
+{
+    for (uint32 bit = 0; bit < UF_FLAG_BITS; ++bit)
+    {
+        _fieldsByFlag[bit].SetCount(count);
+        for (uint32 index = 0; index < count; ++index)
+            if (flags[index] & (1 << bit))
+                _fieldsByFlag[bit].SetBit(index);
+    }
+}
+
+void UpdateFieldFlagsMasks::AddFields(uint32 flags, UpdateMask& mask) const
+{
+    for (uint32 bit = 0; bit < UF_FLAG_BITS; ++bit)
+        if (flags & (1 << bit))
+            mask |= _fieldsByFlag[bit];
+}
+
+UpdateFieldFlagsMasks const& UpdateFieldFlagsMasks::Get(uint32 const* flags)
+{
+    static UpdateFieldFlagsMasks const itemMasks(ItemUpdateFieldFlags, CONTAINER_END);
+    static UpdateFieldFlagsMasks const unitMasks(UnitUpdateFieldFlags, PLAYER_END);
+    static UpdateFieldFlagsMasks const gameObjectMasks(GameObjectUpdateFieldFlags, GAMEOBJECT_END);
+    static UpdateFieldFlagsMasks const dynamicObjectMasks(DynamicObjectUpdateFieldFlags, DYNAMICOBJECT_END);
+    static UpdateFieldFlagsMasks const corpseMasks(CorpseUpdateFieldFlags, CORPSE_END);
+    static UpdateFieldFlagsMasks const noMasks(nullptr, 0);
+
+    if (flags == ItemUpdateFieldFlags)
+        return itemMasks;
+    if (flags == UnitUpdateFieldFlags)
+        return unitMasks;
+    if (flags == GameObjectUpdateFieldFlags)
+        return gameObjectMasks;
+    if (flags == DynamicObjectUpdateFieldFlags)
+        return dynamicObjectMasks;
+    if (flags == CorpseUpdateFieldFlags)
+        return corpseMasks;
+
+    return noMasks;
+}
@@ -9,6 +9,7 @@
 
 #include "Define.h"
 #include "UpdateFields.h"
+#include "UpdateMask.h"
 
 enum UpdatefieldFlags
 {
@@ -22,6 +23,8 @@ enum UpdatefieldFlags
     UF_FLAG_PARTY_MEMBER = 0x040,
     UF_FLAG_UNUSED2      = 0x080,
     UF_FLAG_DYNAMIC      = 0x100,
+
+    UF_FLAG_BITS         = 9
 };
 
 extern uint32 ItemUpdateFieldFlags[CONTAINER_END];
@@ -30,4 +33,20 @@ extern uint32 GameObjectUpdateFieldFlags[GAMEOBJECT_END];
 extern uint32 DynamicObjectUpdateFieldFlags[DYNAMICOBJECT_END];
 extern uint32 CorpseUpdateFieldFlags[CORPSE_END];
 
+/// One of the tables above as a mask of fields per flag, so the fields visible to a player are found a mask block at a time
+class UpdateFieldFlagsMasks
+{
+public:
+    UpdateFieldFlagsMasks(uint32 const* flags, uint32 count);
+
+    /// Sets the bits of the fields having any of the flags
+    void AddFields(uint32 flags, UpdateMask& mask) const;
+
+    /// Masks of one of the tables above, nullptr gives masks without any field
+    static UpdateFieldFlagsMasks const& Get(uint32 const* flags);
+
+private:
+    UpdateMask _fieldsByFlag[UF_FLAG_BITS];
+};
+
 #endif // _UPDATEFIELDFLAGS_H
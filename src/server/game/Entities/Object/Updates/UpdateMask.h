@@ -11,6 +11,10 @@
 #include "Errors.h"
 #include "UpdateFields.h"
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 class UpdateMask
 {
 public:
@@ -20,32 +24,34 @@ public:
     enum UpdateMaskCount
     {
         CLIENT_UPDATE_MASK_BITS = sizeof(ClientUpdateMaskType) * 8,
+        // players have the most fields, the bits are kept in place instead of being allocated
+        MAX_BLOCK_COUNT = (PLAYER_END + CLIENT_UPDATE_MASK_BITS - 1) / CLIENT_UPDATE_MASK_BITS
     };
 
     UpdateMask()  { }
 
-    UpdateMask(UpdateMask const& right) : _bits(nullptr)
+    void SetBit(uint32 index) { _blocks[index / CLIENT_UPDATE_MASK_BITS] |= ClientUpdateMaskType(1) << (index % CLIENT_UPDATE_MASK_BITS); }
+    void UnsetBit(uint32 index) { _blocks[index / CLIENT_UPDATE_MASK_BITS] &= ~(ClientUpdateMaskType(1) << (index % CLIENT_UPDATE_MASK_BITS)); }
+    [[nodiscard]] bool GetBit(uint32 index) const { return (_blocks[index / CLIENT_UPDATE_MASK_BITS] >> (index % CLIENT_UPDATE_MASK_BITS)) & 1; }
+
+    void AppendToPacket(ByteBuffer* data) const
     {
-        SetCount(right.GetCount());
-        memcpy(_bits, right._bits, sizeof(uint8) * _blockCount * 32);
+        for (uint32 i = 0; i < GetBlockCount(); ++i)
+            *data << _blocks[i];
     }
 
-    ~UpdateMask() { delete[] _bits; }
-
-    void SetBit(uint32 index) { _bits[index] = 1; }
-    void UnsetBit(uint32 index) { _bits[index] = 0; }
-    [[nodiscard]] bool GetBit(uint32 index) const { return _bits[index] != 0; }
-
-    void AppendToPacket(ByteBuffer* data)
+    /// Calls f(index) for every set bit in increasing order, a block at a time, skipping empty blocks
+    template<class F>
+    void ForEachSetBit(F&& f) const
     {
-        for (uint32 i = 0; i < GetBlockCount(); ++i)
+        for (uint32 i = 0; i < _blockCount; ++i)
         {
-            ClientUpdateMaskType maskPart = 0;
-            for (uint32 j = 0; j < CLIENT_UPDATE_MASK_BITS; ++j)
-                if (_bits[CLIENT_UPDATE_MASK_BITS * i + j])
-                    maskPart |= 1 << j;
-
-            *data << maskPart;
+            ClientUpdateMaskType block = _blocks[i];
+            while (block)
+            {
+                f(i * CLIENT_UPDATE_MASK_BITS + CountTrailingZeros(block));
+                block &= block - 1;
+            }
         }
     }
 
@@ -54,50 +60,42 @@ public:
 
     void SetCount(uint32 valuesCount)
     {
-        delete[] _bits;
+        ASSERT(valuesCount <= MAX_BLOCK_COUNT * CLIENT_UPDATE_MASK_BITS);
 
         _fieldCount = valuesCount;
         _blockCount = (valuesCount + CLIENT_UPDATE_MASK_BITS - 1) / CLIENT_UPDATE_MASK_BITS;
 
-        _bits = new uint8[_blockCount * CLIENT_UPDATE_MASK_BITS];
-        memset(_bits, 0, sizeof(uint8) * _blockCount * CLIENT_UPDATE_MASK_BITS);
+        Clear();
     }
 
     void Clear()
     {
-        if (_bits)
-            memset(_bits, 0, sizeof(uint8) * _blockCount * CLIENT_UPDATE_MASK_BITS);
-    }
-
-    UpdateMask& operator=(UpdateMask const& right)
-    {
-        if (this == &right)
-            return *this;
-
-        SetCount(right.GetCount());
-        memcpy(_bits, right._bits, sizeof(uint8) * _blockCount * CLIENT_UPDATE_MASK_BITS);
-        return *this;
+        memset(_blocks, 0, sizeof(ClientUpdateMaskType) * _blockCount);
     }
 
+    /// right may have more fields, those are not taken over
     UpdateMask& operator&=(UpdateMask const& right)
     {
-        ASSERT(right.GetCount() <= GetCount());
-        for (uint32 i = 0; i < _fieldCount; ++i)
-            _bits[i] &= right._bits[i];
+        for (uint32 i = 0; i < _blockCount; ++i)
+            _blocks[i] &= i < right._blockCount ? right._blocks[i] : 0;
 
         return *this;
     }
 
+    /// right may have more fields, those are not taken over
     UpdateMask& operator|=(UpdateMask const& right)
     {
-        ASSERT(right.GetCount() <= GetCount());
-        for (uint32 i = 0; i < _fieldCount; ++i)
-            _bits[i] |= right._bits[i];
+        for (uint32 i = 0; i < _blockCount && i < right._blockCount; ++i)
+            _blocks[i] |= right._blocks[i];
+
+        if (uint32 tailBits = _fieldCount % CLIENT_UPDATE_MASK_BITS)
+            if (right._blockCount >= _blockCount)
+                _blocks[_blockCount - 1] &= (ClientUpdateMaskType(1) << tailBits) - 1;
 
         return *this;
     }
 
-    UpdateMask operator|(UpdateMask const& right)
+    UpdateMask operator|(UpdateMask const& right) const
     {
         UpdateMask ret(*this);
         ret |= right;
@@ -105,9 +103,20 @@ public:
     }
 
 private:
+    static uint32 CountTrailingZeros(ClientUpdateMaskType block)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, block);
+        return index;
+#else
+        return __builtin_ctz(block);
+#endif
+    }
+
     uint32 _fieldCount{0};
     uint32 _blockCount{0};
-    uint8* _bits{nullptr};
+    ClientUpdateMaskType _blocks[MAX_BLOCK_COUNT]{};
 };
 
 #endif
@@ -792,6 +792,8 @@ Player::Player(WorldSession* session): Unit(true), m_mover(this)
     m_DailyQuestChanged = false;
     m_lastDailyQuestTime = 0;
 
+    m_spellCooldownsSaved = false;
+
     for (uint8 i = 0; i < MAX_TIMERS; i++)
         m_MirrorTimer[i] = DISABLED_MIRROR_TIMER;
 
@@ -919,6 +921,8 @@ Player::Player(WorldSession* session): Unit(true), m_mover(this)
     m_lastFallTime = 0;
     m_lastFallZ = 0;
 
+    m_prefetchGridKey = 0xFFFFFFFF;
+
     m_grantableLevels = 0;
 
     m_ControlledByPlayer = true;
@@ -4457,16 +4461,13 @@ void Player::_LoadSpellCooldowns(PreparedQueryResult result)
 
 void Player::_SaveSpellCooldowns(SQLTransaction& trans, bool logout)
 {
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_SPELL_COOLDOWN);
-    stmt->setUInt32(0, GetGUIDLow());
-    trans->Append(stmt);
-
     time_t curTime = time(nullptr);
     uint32 curMSTime = World::GetGameTimeMS();
     uint32 infTime = curMSTime + infinityCooldownDelayCheck;
 
     bool first_round = true;
     std::ostringstream ss;
+    std::vector<std::tuple<uint32, uint32, uint32, bool>> savedCooldowns;
 
     // remove outdated and save active
     for (SpellCooldowns::iterator itr = m_spellCooldowns.begin(); itr != m_spellCooldowns.end();)
@@ -4493,14 +4494,27 @@ void Player::_SaveSpellCooldowns(SQLTransaction& trans, bool logout)
 
             uint64 cooldown = uint64(((itr->second.end - curMSTime) / IN_MILLISECONDS) + curTime);
             ss << '(' << GetGUIDLow() << ',' << itr->first << ',' << itr->second.itemid << ',' << cooldown << ',' << (itr->second.needSendToClient ? '1' : '0') << ')';
+            savedCooldowns.emplace_back(itr->first, itr->second.itemid, itr->second.end, bool(itr->second.needSendToClient));
             ++itr;
         }
         else
             ++itr;
     }
+
+    // the stored rows are still exact when the same cooldowns are saved again
+    if (m_spellCooldownsSaved && savedCooldowns == m_savedSpellCooldowns)
+        return;
+
+    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_SPELL_COOLDOWN);
+    stmt->setUInt32(0, GetGUIDLow());
+    trans->Append(stmt);
+
     // if something changed execute
     if (!first_round)
         trans->Append(ss.str().c_str());
+
+    m_savedSpellCooldowns.swap(savedCooldowns);
+    m_spellCooldownsSaved = true;
 }
 
 uint32 Player::resetTalentsCost() const
@@ -19824,6 +19838,7 @@ void Player::SaveToDB(bool create, bool logout)
     if (m_session->isLogingOut() || !sWorld->getBoolConfig(CONFIG_STATS_SAVE_ONLY_ON_LOGOUT))
         _SaveStats(trans);
 
+    SavingSystemMgr::RecordSave(trans->GetSize());
     CharacterDatabase.CommitTransaction(trans);
 
     // save pet (hunter pet level and experience and all type pets health/mana).
@@ -26421,6 +26436,24 @@ void Player::_SaveEntryPoint(SQLTransaction& trans)
     if (!mEntry)
         return;
 
+    std::ostringstream ss("");
+    if (m_entryPointData.HasTaxiPath())
+    {
+        for (size_t i = 0; i < m_entryPointData.taxiPath.size(); ++i)
+            ss << m_entryPointData.taxiPath[i] << ' '; // xinef: segment is stored as last point
+    }
+
+    std::ostringstream values;
+    values.precision(9); // round-trips a float
+    values << m_entryPointData.joinPos.GetPositionX() << ' ' << m_entryPointData.joinPos.GetPositionY() << ' ' << m_entryPointData.joinPos.GetPositionZ() << ' '
+           << m_entryPointData.joinPos.GetOrientation() << ' ' << m_entryPointData.joinPos.GetMapId() << ' ' << m_entryPointData.mountSpell << ' ' << ss.str();
+
+    // unchanged since the last save
+    if (values.str() == m_savedEntryPoint)
+        return;
+
+    m_savedEntryPoint = values.str();
+
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_PLAYER_ENTRY_POINT);
     stmt->setUInt32(0, GetGUIDLow());
     trans->Append(stmt);
@@ -26431,14 +26464,6 @@ void Player::_SaveEntryPoint(SQLTransaction& trans)
     stmt->setFloat (3, m_entryPointData.joinPos.GetPositionZ());
     stmt->setFloat (4, m_entryPointData.joinPos.GetOrientation());
     stmt->setUInt32(5, m_entryPointData.joinPos.GetMapId());
-
-    std::ostringstream ss("");
-    if (m_entryPointData.HasTaxiPath())
-    {
-        for (size_t i = 0; i < m_entryPointData.taxiPath.size(); ++i)
-            ss << m_entryPointData.taxiPath[i] << ' '; // xinef: segment is stored as last point
-    }
-
     stmt->setString(6, ss.str());
     stmt->setUInt32(7, m_entryPointData.mountSpell);
     trans->Append(stmt);
@@ -27573,6 +27598,8 @@ void Player::_LoadInstanceTimeRestrictions(PreparedQueryResult result)
         Field* fields = result->Fetch();
         _instanceResetTimes.insert(InstanceTimeMap::value_type(fields[0].GetUInt32(), fields[1].GetUInt64()));
     } while (result->NextRow());
+
+    _savedInstanceResetTimes = _instanceResetTimes;
 }
 
 void Player::_LoadBrewOfTheMonth(PreparedQueryResult result)
@@ -27618,9 +27645,11 @@ void Player::_LoadBrewOfTheMonth(PreparedQueryResult result)
 
 void Player::_SaveInstanceTimeRestrictions(SQLTransaction& trans)
 {
-    if (_instanceResetTimes.empty())
+    if (_instanceResetTimes == _savedInstanceResetTimes)
         return;
 
+    _savedInstanceResetTimes = _instanceResetTimes;
+
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_ACCOUNT_INSTANCE_LOCK_TIMES);
     stmt->setUInt32(0, GetSession()->GetAccountId());
     trans->Append(stmt);
@@ -21,6 +21,7 @@
 #include "Unit.h"
 #include "WorldSession.h"
 #include <string>
+#include <tuple>
 #include <vector>
 
 struct CreatureTemplate;
@@ -2354,6 +2355,10 @@ public:
     }
     void HandleFall(MovementInfo const& movementInfo);
 
+    // grid GridPrefetcher was last asked to load for this player
+    [[nodiscard]] uint32 GetPrefetchGridKey() const { return m_prefetchGridKey; }
+    void SetPrefetchGridKey(uint32 key) { m_prefetchGridKey = key; }
+
     [[nodiscard]] bool canFlyInZone(uint32 mapid, uint32 zone) const;
 
     void SetClientControl(Unit* target, bool allowMove, bool packetOnly = false);
@@ -2656,6 +2661,7 @@ protected:
     /*********************************************************/
 
     EntryPointData m_entryPointData;
+    std::string m_savedEntryPoint;                          // values of the last saved entry point, empty until the first save
 
     /*********************************************************/
     /***                    QUEST SYSTEM                   ***/
@@ -2928,6 +2934,8 @@ private:
     uint32 m_lastFallTime;
     float  m_lastFallZ;
 
+    uint32 m_prefetchGridKey;
+
     int32 m_MirrorTimer[MAX_TIMERS];
     uint8 m_MirrorTimerFlags;
     uint8 m_MirrorTimerFlagsLast;
@@ -2951,6 +2959,9 @@ private:
     ReputationMgr*  m_reputationMgr;
 
     SpellCooldowns m_spellCooldowns;
+    // cooldowns written by the last _SaveSpellCooldowns, as (spell, item, end, needSend)
+    std::vector<std::tuple<uint32, uint32, uint32, bool>> m_savedSpellCooldowns;
+    bool m_spellCooldownsSaved;
 
     uint32 m_ChampioningFaction;
 
@@ -2960,6 +2971,7 @@ private:
     uint32 m_timeSyncServer;
 
     InstanceTimeMap _instanceResetTimes;
+    InstanceTimeMap _savedInstanceResetTimes;               // as stored in the database
     uint32 _pendingBindId;
     uint32 _pendingBindTimer;
 
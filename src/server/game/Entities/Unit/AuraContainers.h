@@ -0,0 +1,261 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-GPL2
+ */
+
+#ifndef _AURA_CONTAINERS_H
+#define _AURA_CONTAINERS_H
+
+#include "Define.h"
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+/// Contiguous list of aura pointers with the iteration guarantees of the std::list it replaces in Unit.
+/// Iterators are positions in the list, so they stay valid when items are added while iterating, and
+/// removed items only leave an empty position that iteration skips. Positions are given back by Compact(),
+/// which must only be called when nothing iterates the list (Unit does it with its removed auras).
+/// Copies hold only the current items.
+template <class T>
+class FlatAuraList
+{
+public:
+    typedef T* value_type;
+    typedef T* const& const_reference;
+
+    class const_iterator
+    {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef T* value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef T* const* pointer;
+        typedef T* const& reference;
+
+        const_iterator() : _list(nullptr), _index(0) { }
+        const_iterator(FlatAuraList const* list, uint32 index) : _list(list), _index(index) { }
+
+        reference operator*() const { return _list->_items[_index]; }
+        pointer operator->() const { return &_list->_items[_index]; }
+
+        const_iterator& operator++()
+        {
+            ++_index;
+            _index = _list->Skip(_index);
+            return *this;
+        }
+
+        const_iterator operator++(int) { const_iterator tmp = *this; ++*this; return tmp; }
+
+        const_iterator& operator--()
+        {
+            do
+                --_index;
+            while (_index > 0 && !_list->_items[_index]);
+            return *this;
+        }
+
+        const_iterator operator--(int) { const_iterator tmp = *this; --*this; return tmp; }
+
+        bool operator==(const_iterator const& right) const { return _index == right._index; }
+        bool operator!=(const_iterator const& right) const { return _index != right._index; }
+
+    private:
+        FlatAuraList const* _list;
+        uint32 _index;
+    };
+
+    // items are only read through iterators, the list is changed with push_back() and remove()
+    typedef const_iterator iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef const_reverse_iterator reverse_iterator;
+
+    FlatAuraList() : _count(0) { }
+    FlatAuraList(FlatAuraList const& right) : _count(0) { *this = right; }
+    FlatAuraList(FlatAuraList&& right) noexcept : _items(std::move(right._items)), _count(right._count) { right._count = 0; }
+
+    FlatAuraList& operator=(FlatAuraList const& right)
+    {
+        if (this == &right)
+            return *this;
+
+        _items.clear();
+        _items.reserve(right._count);
+        for (T* item : right._items)
+            if (item)
+                _items.push_back(item);
+        _count = right._count;
+        return *this;
+    }
+
+    FlatAuraList& operator=(FlatAuraList&& right) noexcept
+    {
+        _items = std::move(right._items);
+        _count = right._count;
+        right._items.clear();
+        right._count = 0;
+        return *this;
+    }
+
+    const_iterator begin() const { return const_iterator(this, Skip(0)); }
+    const_iterator end() const { return const_iterator(this, uint32(_items.size())); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    [[nodiscard]] bool empty() const { return _count == 0; }
+    [[nodiscard]] size_t size() const { return _count; }
+    T* front() const { return *begin(); }
+    T* back() const { return *rbegin(); }
+
+    void push_back(T* item)
+    {
+        _items.push_back(item);
+        ++_count;
+    }
+
+    /// Empties the position of every occurrence of item
+    void remove(T* item)
+    {
+        for (T*& listItem : _items)
+        {
+            if (listItem == item)
+            {
+                listItem = nullptr;
+                --_count;
+            }
+        }
+    }
+
+    void clear()
+    {
+        _items.clear();
+        _count = 0;
+    }
+
+    /// Stable sort like std::list::sort, the list must not be iterated meanwhile
+    template <class Compare>
+    void sort(Compare compare)
+    {
+        Compact();
+        std::stable_sort(_items.begin(), _items.end(), compare);
+    }
+
+    /// True if removed items still take a position
+    [[nodiscard]] bool NeedsCompact() const { return _items.size() != _count; }
+
+    void Compact()
+    {
+        uint32 used = 0;
+        for (T* item : _items)
+            if (item)
+                _items[used++] = item;
+        _items.resize(used);
+    }
+
+private:
+    uint32 Skip(uint32 index) const
+    {
+        while (index < _items.size() && !_items[index])
+            ++index;
+        return index;
+    }
+
+    std::vector<T*> _items;
+    uint32 _count;
+};
+
+/// Counts of the applied auras per spell id, in an open addressing table.
+/// Lets spell id lookups of auras that are not on the unit, the most common result, skip the aura map.
+class AuraSpellIdTable
+{
+public:
+    AuraSpellIdTable() : _used(0) { }
+
+    void Add(uint32 spellId)
+    {
+        if ((_used + 1) * 4 > _slots.size() * 3)
+            Grow();
+
+        Slot& slot = _slots[Find(spellId)];
+        if (!slot.Count)
+        {
+            slot.SpellId = spellId;
+            ++_used;
+        }
+        ++slot.Count;
+    }
+
+    void Remove(uint32 spellId)
+    {
+        if (_slots.empty())
+            return;
+
+        uint32 index = Find(spellId);
+        Slot& slot = _slots[index];
+        if (!slot.Count || --slot.Count)
+            return;
+
+        --_used;
+
+        // backward shift deletion, keeps every spell id reachable from its home slot without tombstones
+        uint32 mask = uint32(_slots.size() - 1);
+        uint32 hole = index;
+        for (uint32 next = (hole + 1) & mask; _slots[next].Count; next = (next + 1) & mask)
+        {
+            uint32 home = Hash(_slots[next].SpellId) & mask;
+            // move the entry into the hole if the hole lies between its home slot and its current one
+            if (((next - home) & mask) >= ((next - hole) & mask))
+            {
+                _slots[hole] = _slots[next];
+                hole = next;
+            }
+        }
+
+        _slots[hole] = Slot();
+    }
+
+    [[nodiscard]] bool Contains(uint32 spellId) const
+    {
+        return !_slots.empty() && _slots[Find(spellId)].Count != 0;
+    }
+
+private:
+    struct Slot
+    {
+        Slot() : SpellId(0), Count(0) { }
+
+        uint32 SpellId;
+        uint32 Count;                                       // 0 for a free slot
+    };
+
+    static uint32 Hash(uint32 spellId)
+    {
+        uint32 hash = spellId * 2654435761u;
+        return hash ^ (hash >> 16);
+    }
+
+    /// Returns the slot of the spell id, or the free slot where it would be inserted
+    uint32 Find(uint32 spellId) const
+    {
+        uint32 mask = uint32(_slots.size() - 1);
+        uint32 index = Hash(spellId) & mask;
+        while (_slots[index].Count && _slots[index].SpellId != spellId)
+            index = (index + 1) & mask;
+        return index;
+    }
+
+    void Grow()
+    {
+        std::vector<Slot> old;
+        old.swap(_slots);
+        _slots.resize(old.empty() ? 16 : old.size() * 2);
+
+        for (Slot const& slot : old)
+            if (slot.Count)
+                _slots[Find(slot.SpellId)] = slot;
+    }
+
+    std::vector<Slot> _slots;                               // size is a power of two
+    uint32 _used;
+};
+
+#endif
@@ -7,12 +7,14 @@
 #ifndef __UNIT_H
 #define __UNIT_H
 
+#include "AuraContainers.h"
 #include "EventProcessor.h"
 #include "FollowerReference.h"
 #include "FollowerRefManager.h"
 #include "HostileRefManager.h"
 #include "MotionMaster.h"
 #include "Object.h"
+#include "SpatialHash.h"
 #include "SpellAuraDefines.h"
 #include "ThreatManager.h"
 
@@ -1394,7 +1396,7 @@ public:
     typedef std::multimap<AuraStateType,  AuraApplication*> AuraStateAurasMap;
     typedef std::pair<AuraStateAurasMap::const_iterator, AuraStateAurasMap::const_iterator> AuraStateAurasMapBounds;
 
-    typedef std::list<AuraEffect*> AuraEffectList;
+    typedef FlatAuraList<AuraEffect> AuraEffectList;
     typedef std::list<Aura*> AuraList;
     typedef std::list<AuraApplication*> AuraApplicationList;
     typedef std::list<DiminishingReturn> Diminishing;
@@ -1951,6 +1953,8 @@ public:
     void _RemoveNoStackAurasDueToAura(Aura* aura);
     bool _IsNoStackAuraDueToAura(Aura* appliedAura, Aura* existingAura) const;
     void _RegisterAuraEffect(AuraEffect* aurEff, bool apply);
+    void _RegisterProcAura(AuraApplication* aurApp, bool apply);
+    void _RebuildProcAuras();
 
     // m_ownedAuras container management
     AuraMap&       GetOwnedAuras()       { return m_ownedAuras; }
@@ -2415,6 +2419,7 @@ public:
     void OutDebugInfo() const;
     [[nodiscard]] virtual bool isBeingLoaded() const { return false;}
     [[nodiscard]] bool IsDuringRemoveFromWorld() const {return m_duringRemoveFromWorld;}
+    SpatialHashSlot& GetSpatialHashSlot() { return m_spatialHashSlot; }
 
     Pet* ToPet() { if (IsPet()) return reinterpret_cast<Pet*>(this); else return nullptr; }
     Totem* ToTotem() { if (IsTotem()) return reinterpret_cast<Totem*>(this); else return nullptr; }
@@ -2486,7 +2491,9 @@ public:
 protected:
     explicit Unit (bool isWorldObject);
 
-    void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const override;
+    void AddForcedUpdateFields(uint32 visibleFlag, UpdateMask& updateMask) const override;
+    uint32 GetUpdateFieldValue(uint16 index, Player* target) const override;
+    [[nodiscard]] bool IsUpdateFieldTargetDependent(uint16 index) const override;
 
     UnitAI* i_AI, *i_disabledAI;
 
@@ -2527,6 +2534,19 @@ protected:
     uint32 m_removedAurasCount;
 
     AuraEffectList m_modAuras[TOTAL_AURAS];
+    std::vector<AuraType> m_modAurasToCompact;            // lists with positions of removed effects
+    AuraSpellIdTable m_appliedAuraSpellIds;              // spell ids of m_appliedAuras
+
+    // applied auras that can proc, with their proc flags, in m_appliedAuras order
+    struct ProcAuraEntry
+    {
+        uint32 SpellId;
+        uint32 ProcFlags;
+        AuraApplication* Application;
+    };
+    std::vector<ProcAuraEntry> m_procAuras;
+    uint32 m_procAuraFlags;                               // all proc flags of m_procAuras
+    uint32 m_procAurasVersion;                            // proc data version of SpellMgr m_procAuras was built with
     AuraList m_scAuras;                        // casted singlecast auras
     AuraApplicationList m_interruptableAuras;             // auras which have interrupt mask applied on unit
     AuraStateAurasMap m_auraStateAuras;        // Used for improve performance of aura state checks on aura apply/remove
@@ -2606,6 +2626,7 @@ private:
 
     bool m_cleanupDone; // lock made to not add stuff after cleanup before delete
     bool m_duringRemoveFromWorld; // lock made to not add stuff after begining removing from world
+    SpatialHashSlot m_spatialHashSlot; // place in the unit index of the map, see Map::GetUnitIndex()
 
     uint32 _oldFactionId;           ///< faction before charm
     bool m_petCatchUp;
@@ -21,6 +21,7 @@
 #include "Opcodes.h"
 #include "Pet.h"
 #include "Player.h"
+#include "UpdateCompressor.h"
 #include "Vehicle.h"
 #include "World.h"
 #include "WorldPacket.h"
@@ -509,6 +510,27 @@ void Map::BuildAndSendUpdateForObjects()
         obj->BuildUpdate(update_players, player_set);
     }
 
+    if (sUpdateCompressor->IsActive() && update_players.size() > 1)
+    {
+        // large packets are compressed by the compression threads while the others are built, all are sent once they are done
+        std::vector<WorldPacket> packets(update_players.size());
+        UpdateCompressionBatch batch;
+        size_t index = 0;
+        for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
+            iter->second.BuildPacket(&packets[index++], &batch);
+
+        batch.Wait();
+
+        index = 0;
+        for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
+        {
+            WorldPacket& packet = packets[index++];
+            if (!packet.empty())
+                iter->first->GetSession()->SendPacket(&packet);
+        }
+        return;
+    }
+
     WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
     for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
     {
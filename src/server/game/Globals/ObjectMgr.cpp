@@ -292,7 +292,8 @@ ObjectMgr::ObjectMgr():
     _hiDoGuid(1),
     _hiCorpseGuid(1),
     _hiMoTransGuid(1),
-    DBCLocaleIndex(LOCALE_enUS)
+    DBCLocaleIndex(LOCALE_enUS),
+    _itemNameLocaleMask(0)
 {
     for (uint8 i = 0; i < MAX_CLASSES; ++i)
     {
@@ -2283,6 +2284,7 @@ void ObjectMgr::LoadItemLocales()
     uint32 oldMSTime = getMSTime();
 
     _itemLocaleStore.clear();                                 // need for reload case
+    _itemNameLocaleMask = 0;
 
     QueryResult result = WorldDatabase.Query("SELECT ID, locale, Name, Description FROM item_template_locale");
     if (!result)
@@ -2304,6 +2306,8 @@ void ObjectMgr::LoadItemLocales()
 
         AddLocaleString(Name, locale, data.Name);
         AddLocaleString(Description, locale, data.Description);
+        if (!Name.empty())
+            _itemNameLocaleMask |= 1 << locale;
     } while (result->NextRow());
 
     sLog->outString(">> Loaded %u Item Locale strings in %u ms", (uint32)_itemLocaleStore.size(), GetMSTimeDiffToNow(oldMSTime));
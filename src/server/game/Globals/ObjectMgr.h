@@ -1166,6 +1166,8 @@ public:
         if (itr == _itemLocaleStore.end()) return nullptr;
         return &itr->second;
     }
+    /// Whether any item has a name in the locale, items of other locales are listed with their default name
+    [[nodiscard]] bool HasItemNameLocale(LocaleConstant locale) const { return (_itemNameLocaleMask & (1 << locale)) != 0; }
     [[nodiscard]] ItemSetNameLocale const* GetItemSetNameLocale(uint32 entry) const
     {
         ItemSetNameLocaleContainer::const_iterator itr = _itemSetNameLocaleStore.find(entry);
@@ -1483,6 +1485,7 @@ private:
     ItemTemplateContainer _itemTemplateStore;
     std::vector<ItemTemplate*> _itemTemplateStoreFast; // pussywizard
     ItemLocaleContainer _itemLocaleStore;
+    uint32 _itemNameLocaleMask;                             // locales with item names in _itemLocaleStore
     ItemSetNameLocaleContainer _itemSetNameLocaleStore;
     QuestLocaleContainer _questLocaleStore;
     QuestOfferRewardLocaleContainer _questOfferRewardLocaleStore;
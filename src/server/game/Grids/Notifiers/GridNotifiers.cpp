@@ -24,24 +24,26 @@ void VisibleNotifier::Visit(GameObjectMapType& m)
     {
         if (i_largeOnly != iter->GetSource()->IsVisibilityOverridden())
             continue;
-        vis_guids.erase(iter->GetSource()->GetGUID());
+        vis_guids.Visit(iter->GetSource()->GetGUID());
         i_player.UpdateVisibilityOf(iter->GetSource(), i_data, i_visibleNow);
     }
 }
 
 void VisibleNotifier::SendToSelf()
 {
-    // at this moment i_clientGUIDs have guids that not iterate at grid level checks
+    // at this moment notVisited has guids that not iterate at grid level checks
     // but exist one case when this possible and object not out of range: transports
+    std::vector<uint64> notVisited = vis_guids.GetNotVisited();
     if (Transport* transport = i_player.GetTransport())
         for (Transport::PassengerSet::const_iterator itr = transport->GetPassengers().begin(); itr != transport->GetPassengers().end(); ++itr)
         {
             if (i_largeOnly != (*itr)->IsVisibilityOverridden())
                 continue;
 
-            if (vis_guids.find((*itr)->GetGUID()) != vis_guids.end())
+            std::vector<uint64>::iterator notVisitedItr = std::lower_bound(notVisited.begin(), notVisited.end(), (*itr)->GetGUID());
+            if (notVisitedItr != notVisited.end() && *notVisitedItr == (*itr)->GetGUID())
             {
-                vis_guids.erase((*itr)->GetGUID());
+                notVisited.erase(notVisitedItr);
 
                 switch ((*itr)->GetTypeId())
                 {
@@ -50,7 +52,7 @@ void VisibleNotifier::SendToSelf()
                         break;
                     case TYPEID_PLAYER:
                         i_player.UpdateVisibilityOf((*itr)->ToPlayer(), i_data, i_visibleNow);
-                        (*itr)->ToPlayer()->UpdateVisibilityOf(&i_player);
+                        i_player.GetMap()->UpdatePlayerVisibilityOf((*itr)->ToPlayer(), &i_player);
                         break;
                     case TYPEID_UNIT:
                         i_player.UpdateVisibilityOf((*itr)->ToCreature(), i_data, i_visibleNow);
@@ -61,42 +63,44 @@ void VisibleNotifier::SendToSelf()
             }
         }
 
-    for (Player::ClientGUIDs::const_iterator it = vis_guids.begin(); it != vis_guids.end(); ++it)
+    for (uint64 guid : notVisited)
     {
-        if (WorldObject* obj = ObjectAccessor::GetWorldObject(i_player, *it))
+        if (WorldObject* obj = ObjectAccessor::GetWorldObject(i_player, guid))
             if (i_largeOnly != obj->IsVisibilityOverridden())
                 continue;
 
         // pussywizard: static transports are removed only in RemovePlayerFromMap and here if can no longer detect (eg. phase changed)
-        if (IS_TRANSPORT_GUID(*it))
-            if (GameObject* staticTrans = i_player.GetMap()->GetGameObject(*it))
+        if (IS_TRANSPORT_GUID(guid))
+            if (GameObject* staticTrans = i_player.GetMap()->GetGameObject(guid))
                 if (i_player.CanSeeOrDetect(staticTrans, false, true))
                     continue;
 
-        i_player.m_clientGUIDs.erase(*it);
-        i_data.AddOutOfRangeGUID(*it);
+        i_player.m_clientGUIDs.erase(guid);
+        i_data.AddOutOfRangeGUID(guid);
 
-        if (IS_PLAYER_GUID(*it))
+        if (IS_PLAYER_GUID(guid))
         {
-            Player* player = ObjectAccessor::FindPlayer(*it);
+            Player* player = ObjectAccessor::FindPlayer(guid);
             if (player && player->IsInMap(&i_player))
-                player->UpdateVisibilityOf(&i_player);
+                i_player.GetMap()->UpdatePlayerVisibilityOf(player, &i_player);
         }
     }
 
     if (!i_data.HasData())
         return;
 
+    i_visibleNow.erase(std::remove_if(i_visibleNow.begin(), i_visibleNow.end(), [this](Unit* unit) { return i_largeOnly != unit->IsVisibilityOverridden(); }), i_visibleNow.end());
+
+    // queued changes other units moving caused for this player are sent first
+    if (i_player.GetMap()->AddDelayedVisibilityUpdate(&i_player, i_data, i_visibleNow))
+        return;
+
     WorldPacket packet;
     i_data.BuildPacket(&packet);
     i_player.GetSession()->SendPacket(&packet);
 
     for (std::vector<Unit*>::const_iterator it = i_visibleNow.begin(); it != i_visibleNow.end(); ++it)
-    {
-        if (i_largeOnly != (*it)->IsVisibilityOverridden())
-            continue;
         i_player.GetInitialVisiblePackets(*it);
-    }
 }
 
 void VisibleChangesNotifier::Visit(PlayerMapType& m)
@@ -158,9 +162,17 @@ void PlayerRelocationNotifier::Visit(PlayerMapType& m)
     for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         Player* player = iter->GetSource();
-        vis_guids.erase(player->GetGUID());
+        // players are not large, visited once by the notifier of the default distance
+        if (i_largeOnly != player->IsVisibilityOverridden())
+            continue;
+
+        vis_guids.Visit(player->GetGUID());
+        // both ways were already updated when the notifier of the other player found this one in the same pass
+        if (!i_player.GetMap()->MarkVisibilityPair(&i_player, player))
+            continue;
+
         i_player.UpdateVisibilityOf(player, i_data, i_visibleNow);
-        player->UpdateVisibilityOf(&i_player); // this notifier with different Visit(PlayerMapType&) than VisibleNotifier is needed to update visibility of self for other players when we move (eg. stealth detection changes)
+        i_player.GetMap()->UpdatePlayerVisibilityOf(player, &i_player); // this notifier with different Visit(PlayerMapType&) than VisibleNotifier is needed to update visibility of self for other players when we move (eg. stealth detection changes)
     }
 }
 
@@ -172,7 +184,7 @@ void CreatureRelocationNotifier::Visit(PlayerMapType& m)
 
         // NOTIFY_VISIBILITY_CHANGED does not guarantee that player will do it himself (because distance is also checked), but screw it, it's not that important
         if (!player->m_seer->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
-            player->UpdateVisibilityOf(&i_creature);
+            i_creature.GetMap()->UpdatePlayerVisibilityOf(player, &i_creature);
 
         // NOTIFY_AI_RELOCATION does not guarantee that player will do it himself (because distance is also checked), but screw it, it's not that important
         if (!player->m_seer->isNeedNotify(NOTIFY_AI_RELOCATION) && !i_creature.IsMoveInLineOfSightStrictlyDisabled())
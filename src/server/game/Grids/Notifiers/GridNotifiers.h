@@ -17,6 +17,7 @@
 #include "Spell.h"
 #include "Unit.h"
 #include "UpdateData.h"
+#include "VisibilityPass.h"
 #include "WorldSession.h"
 #include <iostream>
 
@@ -28,7 +29,7 @@ namespace acore
     struct VisibleNotifier
     {
         Player& i_player;
-        Player::ClientGUIDs vis_guids;
+        VisibleGuidDiff vis_guids;
         std::vector<Unit*>& i_visibleNow;
         bool i_gobjOnly;
         bool i_largeOnly;
@@ -207,6 +208,8 @@ namespace acore
         void Visit(CorpseMapType& m);
         void Visit(GameObjectMapType& m);
         void Visit(DynamicObjectMapType& m);
+        /// Offers a single object, for searches that don't walk the grid cells, like the unit index of a map
+        void Visit(WorldObject* object);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
     };
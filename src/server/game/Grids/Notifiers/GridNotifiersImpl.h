@@ -27,7 +27,7 @@ inline void acore::VisibleNotifier::Visit(GridRefManager<T>& m)
     {
         if (i_largeOnly != iter->GetSource()->IsVisibilityOverridden())
             continue;
-        vis_guids.erase(iter->GetSource()->GetGUID());
+        vis_guids.Visit(iter->GetSource()->GetGUID());
         i_player.UpdateVisibilityOf(iter->GetSource(), i_data, i_visibleNow);
     }
 }
@@ -238,8 +238,13 @@ void acore::WorldObjectListSearcher<Check>::Visit(PlayerMapType& m)
         return;
 
     for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    {
+        if (!itr->GetSource()->InSamePhase(i_phaseMask))
+            continue;
+
         if (i_check(itr->GetSource()))
             i_objects.push_back(itr->GetSource());
+    }
 }
 
 template<class Check>
@@ -249,8 +254,13 @@ void acore::WorldObjectListSearcher<Check>::Visit(CreatureMapType& m)
         return;
 
     for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    {
+        if (!itr->GetSource()->InSamePhase(i_phaseMask))
+            continue;
+
         if (i_check(itr->GetSource()))
             i_objects.push_back(itr->GetSource());
+    }
 }
 
 template<class Check>
@@ -260,8 +270,13 @@ void acore::WorldObjectListSearcher<Check>::Visit(CorpseMapType& m)
         return;
 
     for (CorpseMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    {
+        if (!itr->GetSource()->InSamePhase(i_phaseMask))
+            continue;
+
         if (i_check(itr->GetSource()))
             i_objects.push_back(itr->GetSource());
+    }
 }
 
 template<class Check>
@@ -271,8 +286,13 @@ void acore::WorldObjectListSearcher<Check>::Visit(GameObjectMapType& m)
         return;
 
     for (GameObjectMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    {
+        if (!itr->GetSource()->InSamePhase(i_phaseMask))
+            continue;
+
         if (i_check(itr->GetSource()))
             i_objects.push_back(itr->GetSource());
+    }
 }
 
 template<class Check>
@@ -282,8 +302,45 @@ void acore::WorldObjectListSearcher<Check>::Visit(DynamicObjectMapType& m)
         return;
 
     for (DynamicObjectMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    {
+        if (!itr->GetSource()->InSamePhase(i_phaseMask))
+            continue;
+
         if (i_check(itr->GetSource()))
             i_objects.push_back(itr->GetSource());
+    }
+}
+
+template<class Check>
+void acore::WorldObjectListSearcher<Check>::Visit(WorldObject* object)
+{
+    uint32 typeMask;
+    switch (object->GetTypeId())
+    {
+        case TYPEID_PLAYER:
+            typeMask = GRID_MAP_TYPE_MASK_PLAYER;
+            break;
+        case TYPEID_UNIT:
+            typeMask = GRID_MAP_TYPE_MASK_CREATURE;
+            break;
+        case TYPEID_CORPSE:
+            typeMask = GRID_MAP_TYPE_MASK_CORPSE;
+            break;
+        case TYPEID_GAMEOBJECT:
+            typeMask = GRID_MAP_TYPE_MASK_GAMEOBJECT;
+            break;
+        case TYPEID_DYNAMICOBJECT:
+            typeMask = GRID_MAP_TYPE_MASK_DYNAMICOBJECT;
+            break;
+        default:
+            return;
+    }
+
+    if (!(i_mapTypeMask & typeMask) || !object->InSamePhase(i_phaseMask))
+        return;
+
+    if (i_check(object))
+        i_objects.push_back(object);
 }
 
 // Gameobject searchers
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-GPL2
+ */
+
+#ifndef ACORE_VISIBILITYPASS_H
+#define ACORE_VISIBILITYPASS_H
+
+#include "Define.h"
+#include <algorithm>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+
+/// GUIDs a client knew when a visibility notifier started, as a sorted flat copy, and those the notifier visited.
+/// The known ones that were not visited went out of sight, a sorted difference finds them once the visit is done,
+/// instead of copying the player's hash set node by node and erasing every visited object from the copy.
+class VisibleGuidDiff
+{
+public:
+    template<class Container>
+    explicit VisibleGuidDiff(Container const& known) : _known(known.begin(), known.end())
+    {
+        std::sort(_known.begin(), _known.end());
+    }
+
+    void Visit(uint64 guid) { _visited.push_back(guid); }
+
+    /// Known GUIDs that were not visited, sorted
+    std::vector<uint64> GetNotVisited()
+    {
+        std::sort(_visited.begin(), _visited.end());
+
+        std::vector<uint64> notVisited;
+        std::set_difference(_known.begin(), _known.end(), _visited.begin(), _visited.end(), std::back_inserter(notVisited));
+        return notVisited;
+    }
+
+private:
+    std::vector<uint64> _known;
+    std::vector<uint64> _visited;
+};
+
+/// Pairs of units that moved in the same visibility pass and whose visibility of each other was already updated.
+/// Nothing moves during the pass, so when the notifier of one mover finds the other, the notifier of the other
+/// would only repeat the checks for both of them: each pair of movers is checked once instead of twice.
+/// Pairs with a unit that did not move are always offered, only the notifier of the mover finds them.
+template<class T>
+class VisibilityPairs
+{
+public:
+    void AddMover(T const* mover)
+    {
+        _movers.emplace(mover, uint32(_movers.size()));
+    }
+
+    /// True the first time a pair is offered during the pass, or when one of them did not move
+    bool MarkPair(T const* first, T const* second)
+    {
+        if (first == second || _movers.empty())
+            return true;
+
+        auto firstItr = _movers.find(first);
+        if (firstItr == _movers.end())
+            return true;
+
+        auto secondItr = _movers.find(second);
+        if (secondItr == _movers.end())
+            return true;
+
+        // one bit per pair, in a triangle of the mover indices
+        if (_done.empty())
+            _done.resize(_movers.size() * (_movers.size() - 1) / 2);
+
+        uint32 high = std::max(firstItr->second, secondItr->second);
+        uint32 low = std::min(firstItr->second, secondItr->second);
+        std::vector<bool>::reference done = _done[size_t(high) * (high - 1) / 2 + low];
+        if (done)
+            return false;
+
+        done = true;
+        return true;
+    }
+
+    void Clear()
+    {
+        _movers.clear();
+        _done.clear();
+    }
+
+private:
+    std::unordered_map<T const*, uint32> _movers;
+    std::vector<bool> _done;
+};
+
+#endif
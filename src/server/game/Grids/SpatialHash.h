@@ -0,0 +1,229 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-GPL2
+ */
+
+#ifndef ACORE_SPATIALHASH_H
+#define ACORE_SPATIALHASH_H
+
+#include "Define.h"
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+/// Where an object is kept in a SpatialHash, stored in the object itself
+struct SpatialHashSlot
+{
+    SpatialHashSlot() : Owner(nullptr), Bucket(0), Index(0) { }
+
+    void const* Owner;                                      // the hash the object is in, nullptr if none
+    uint64 Bucket;
+    uint32 Index;
+};
+
+/// Uniform hash of square buckets over the map plane, finer than the 66 yard cells of the grid, for range searches
+/// over few objects among many. Each bucket keeps the positions of its objects in separate arrays, so the distance
+/// test runs over plain float arrays the compiler vectorizes before any object is touched.
+/// Objects bigger than a bucket are kept apart and offered to every search, a search only has to look at the
+/// buckets within its radius plus one bucket size for the others.
+/// Positions are only as current as the last Insert() or Update(): callers test the objects offered to them again.
+/// Search radii are limited to maxRadius, like Cell::Visit() limits them to a grid.
+/// T provides SpatialHashSlot& GetSpatialHashSlot().
+template<class T>
+class SpatialHash
+{
+public:
+    SpatialHash(float bucketSize, float maxRadius) : _bucketSize(bucketSize), _maxRadius(maxRadius), _count(0) { }
+
+    SpatialHash(SpatialHash const&) = delete;
+    SpatialHash& operator=(SpatialHash const&) = delete;
+
+    void Insert(T* object, float x, float y, float objectSize)
+    {
+        SpatialHashSlot& slot = object->GetSpatialHashSlot();
+        if (slot.Owner)
+            return;
+
+        uint64 key = objectSize > _bucketSize ? LARGE_BUCKET : MakeKey(x, y);
+        Bucket& bucket = _buckets[key];
+        slot.Bucket = key;
+        slot.Index = uint32(bucket.Objects.size());
+        slot.Owner = this;
+
+        bucket.X.push_back(x);
+        bucket.Y.push_back(y);
+        bucket.Objects.push_back(object);
+        ++_count;
+    }
+
+    void Remove(T* object)
+    {
+        SpatialHashSlot& slot = object->GetSpatialHashSlot();
+        if (slot.Owner != this)
+            return;
+
+        auto itr = _buckets.find(slot.Bucket);
+        Bucket& bucket = itr->second;
+        uint32 last = uint32(bucket.Objects.size()) - 1;
+        if (slot.Index != last)
+        {
+            bucket.X[slot.Index] = bucket.X[last];
+            bucket.Y[slot.Index] = bucket.Y[last];
+            bucket.Objects[slot.Index] = bucket.Objects[last];
+            bucket.Objects[slot.Index]->GetSpatialHashSlot().Index = slot.Index;
+        }
+
+        bucket.X.pop_back();
+        bucket.Y.pop_back();
+        bucket.Objects.pop_back();
+        if (bucket.Objects.empty())
+            _buckets.erase(itr);
+
+        slot.Owner = nullptr;
+        --_count;
+    }
+
+    void Update(T* object, float x, float y, float objectSize)
+    {
+        SpatialHashSlot& slot = object->GetSpatialHashSlot();
+        if (slot.Owner != this)
+            return;
+
+        uint64 key = objectSize > _bucketSize ? LARGE_BUCKET : MakeKey(x, y);
+        if (key != slot.Bucket)
+        {
+            Remove(object);
+            Insert(object, x, y, objectSize);
+            return;
+        }
+
+        Bucket& bucket = _buckets.find(key)->second;
+        bucket.X[slot.Index] = x;
+        bucket.Y[slot.Index] = y;
+    }
+
+    /// Calls visitor(T*) for the objects that may reach into the circle, including every object bigger than a bucket
+    template<class Visitor>
+    void VisitInCircle(float x, float y, float radius, Visitor&& visitor) const
+    {
+        Collect(x, y, radius, visitor);
+    }
+
+    /// Like VisitInCircle(), only objects whose center is within arc (centered on orientation) seen from the center,
+    /// or close enough to the center for their size to reach into the arc
+    template<class Visitor>
+    void VisitInCone(float x, float y, float radius, float orientation, float arc, Visitor&& visitor) const
+    {
+        // a little wider than asked, callers test the arc again with their own angle math
+        float halfArc = std::min(arc * 0.5f + 0.01f, 3.14159265f);
+        float cosHalfArc = std::cos(halfArc);
+        float dirX = std::cos(orientation);
+        float dirY = std::sin(orientation);
+        float nearSq = _bucketSize * _bucketSize;
+
+        Collect(x, y, radius, [&](T* object)
+        {
+            SpatialHashSlot const& slot = object->GetSpatialHashSlot();
+            if (slot.Bucket != LARGE_BUCKET)
+            {
+                Bucket const& bucket = _buckets.find(slot.Bucket)->second;
+                float dx = bucket.X[slot.Index] - x;
+                float dy = bucket.Y[slot.Index] - y;
+                float distSq = dx * dx + dy * dy;
+                if (distSq > nearSq && dx * dirX + dy * dirY < cosHalfArc * std::sqrt(distSq))
+                    return;
+            }
+
+            visitor(object);
+        });
+    }
+
+    [[nodiscard]] uint32 GetCount() const { return _count; }
+    [[nodiscard]] uint32 GetBucketCount() const { return uint32(_buckets.size()); }
+
+private:
+    struct Bucket
+    {
+        std::vector<float> X;
+        std::vector<float> Y;
+        std::vector<T*> Objects;
+    };
+
+    // bucket coordinates are offset to stay positive for any map coordinate
+    static constexpr int32 COORD_OFFSET = 1 << 20;
+    static constexpr uint64 LARGE_BUCKET = ~uint64(0);
+
+    [[nodiscard]] int32 Coord(float value) const { return int32(std::floor(value / _bucketSize)) + COORD_OFFSET; }
+    [[nodiscard]] static uint64 MakeKey(int32 x, int32 y) { return (uint64(uint32(x)) << 32) | uint32(y); }
+    [[nodiscard]] uint64 MakeKey(float x, float y) const { return MakeKey(Coord(x), Coord(y)); }
+
+    template<class Visitor>
+    void Collect(float x, float y, float radius, Visitor&& visitor) const
+    {
+        // objects in buckets are not bigger than a bucket
+        float range = std::min(radius, _maxRadius) + _bucketSize;
+        float rangeSq = range * range;
+
+        auto large = _buckets.find(LARGE_BUCKET);
+        if (large != _buckets.end())
+            for (T* object : large->second.Objects)
+                visitor(object);
+
+        int32 minX = Coord(x - range), maxX = Coord(x + range);
+        int32 minY = Coord(y - range), maxY = Coord(y + range);
+
+        // a search covering more buckets than there are in use walks those in use instead of looking up each one
+        if (uint64(maxX - minX + 1) * uint64(maxY - minY + 1) > _buckets.size())
+        {
+            for (auto const& [key, bucket] : _buckets)
+            {
+                int32 bx = int32(key >> 32), by = int32(uint32(key));
+                if (key != LARGE_BUCKET && bx >= minX && bx <= maxX && by >= minY && by <= maxY)
+                    CollectInBucket(bucket, x, y, rangeSq, visitor);
+            }
+            return;
+        }
+
+        for (int32 bx = minX; bx <= maxX; ++bx)
+        {
+            for (int32 by = minY; by <= maxY; ++by)
+            {
+                auto itr = _buckets.find(MakeKey(bx, by));
+                if (itr != _buckets.end())
+                    CollectInBucket(itr->second, x, y, rangeSq, visitor);
+            }
+        }
+    }
+
+    template<class Visitor>
+    static void CollectInBucket(Bucket const& bucket, float x, float y, float rangeSq, Visitor& visitor)
+    {
+        float const* posX = bucket.X.data();
+        float const* posY = bucket.Y.data();
+        uint32 count = uint32(bucket.Objects.size());
+
+        // distances of a block of objects first, without branches, then the objects within range
+        uint8 inRange[64];
+        for (uint32 first = 0; first < count; first += 64)
+        {
+            uint32 size = std::min<uint32>(64, count - first);
+            for (uint32 i = 0; i < size; ++i)
+            {
+                float dx = posX[first + i] - x;
+                float dy = posY[first + i] - y;
+                inRange[i] = dx * dx + dy * dy <= rangeSq;
+            }
+
+            for (uint32 i = 0; i < size; ++i)
+                if (inRange[i])
+                    visitor(bucket.Objects[first + i]);
+        }
+    }
+
+    float const _bucketSize;
+    float const _maxRadius;
+    std::unordered_map<uint64, Bucket> _buckets;
+    uint32 _count;
+};
+
+#endif
@@ -619,8 +619,8 @@ void WorldSession::HandleMirrorImageDataRequest(WorldPacket& recvData)
     uint64 guid;
     recvData >> guid;
 
-    // Get unit for which data is needed by client
-    Unit* unit = ObjectAccessor::GetObjectInWorld(guid, (Unit*)nullptr);
+    // Get unit for which data is needed by client, only on the player's own map as this may run inside its map update
+    Unit* unit = ObjectAccessor::GetUnit(*_player, guid);
     if (!unit)
         return;
 
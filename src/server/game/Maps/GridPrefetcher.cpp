@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-GPL2
+ */
+
+#include "GridPrefetcher.h"
+#include "Map.h"
+#include "MapTree.h"
+#include "MMapFactory.h"
+#include "Player.h"
+#include "World.h"
+#include <cmath>
+
+namespace
+{
+    // prepared grids nobody took are dropped, oldest first, above this count
+    constexpr size_t MAX_READY_GRIDS = 32;
+}
+
+GridPrefetcher::GridPrefetcher() : _cancelationToken(false), _requestCount(0), _usedCount(0)
+{
+}
+
+GridPrefetcher::~GridPrefetcher()
+{
+    Deactivate();
+}
+
+GridPrefetcher* GridPrefetcher::instance()
+{
+    static GridPrefetcher instance;
+    return &instance;
+}
+
+void GridPrefetcher::Initialize()
+{
+    if (IsActive() || !sWorld->getBoolConfig(CONFIG_GRID_PREFETCH))
+        return;
+
+    _cancelationToken = false;
+    _thread = std::thread(&GridPrefetcher::WorkerThread, this);
+}
+
+void GridPrefetcher::Deactivate()
+{
+    if (!IsActive())
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _cancelationToken = true;
+        _condition.notify_all();
+    }
+
+    _thread.join();
+
+    _requests.clear();
+    _requestedKeys.clear();
+    for (auto const& itr : _ready)
+        delete itr.second;
+    _ready.clear();
+    _readyOrder.clear();
+}
+
+void GridPrefetcher::PredictGrid(Map* map, Player* player, float x, float y)
+{
+    // instances are small and take their terrain from the base map
+    if (map->Instanceable())
+        return;
+
+    float dx = x - player->GetPositionX();
+    float dy = y - player->GetPositionY();
+    float moved = std::sqrt(dx * dx + dy * dy);
+    if (moved < 0.1f)
+        return;
+
+    // grids within visibility range are loaded by the visibility update, look beyond it
+    float speed = player->GetSpeed((player->IsFlying() || player->IsInFlight()) ? MOVE_FLIGHT : MOVE_RUN);
+    float distance = map->GetVisibilityRange() + speed * sWorld->getIntConfig(CONFIG_GRID_PREFETCH_LOOKAHEAD);
+    float predictedX = x + dx / moved * distance;
+    float predictedY = y + dy / moved * distance;
+
+    if (!acore::IsValidMapCoord(predictedX, predictedY) || !map->IsRemovalGrid(predictedX, predictedY))
+        return;
+
+    // a player keeps predicting the same grid for many relocations, only a new one is worth taking the lock for
+    GridCoord p = acore::ComputeGridCoord(predictedX, predictedY);
+    uint32 key = MakeKey(map->GetId(), (MAX_NUMBER_OF_GRIDS - 1) - p.x_coord, (MAX_NUMBER_OF_GRIDS - 1) - p.y_coord);
+    if (player->GetPrefetchGridKey() == key)
+        return;
+
+    player->SetPrefetchGridKey(key);
+    Request(key, MMAP::MMapFactory::IsPathfindingEnabled(map));
+}
+
+void GridPrefetcher::Request(uint32 key, bool collision)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+
+    if (_requestedKeys.count(key) || _ready.count(key))
+        return;
+
+    _requestedKeys.insert(key);
+    _requests.push_back({ key, collision });
+    ++_requestCount;
+
+    _condition.notify_one();
+}
+
+GridMap* GridPrefetcher::TakeGridMap(uint32 mapId, uint32 gx, uint32 gy)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+
+    auto itr = _ready.find(MakeKey(mapId, gx, gy));
+    if (itr == _ready.end())
+        return nullptr;
+
+    GridMap* gridMap = itr->second;
+    _ready.erase(itr);
+    ++_usedCount;
+    return gridMap;
+}
+
+void GridPrefetcher::WorkerThread()
+{
+    while (1)
+    {
+        PrefetchRequest request;
+
+        {
+            std::unique_lock<std::mutex> guard(_lock);
+
+            while (_requests.empty() && !_cancelationToken)
+                _condition.wait(guard);
+
+            if (_cancelationToken)
+                return;
+
+            request = _requests.front();
+            _requests.pop_front();
+        }
+
+        uint32 mapId = request.Key >> 12;
+        uint32 gx = (request.Key >> 6) & 0x3F;
+        uint32 gy = request.Key & 0x3F;
+
+        // same file name as Map::LoadMap
+        char fileName[32];
+        snprintf(fileName, sizeof(fileName), "maps/%03u%02u%02u.map", mapId, gx, gy);
+        std::string path = sWorld->GetDataPath() + fileName;
+
+        GridMap* gridMap = new GridMap();
+        if (!gridMap->loadData(const_cast<char*>(path.c_str())))
+        {
+            // leave the error report to the map thread
+            delete gridMap;
+            gridMap = nullptr;
+        }
+
+        if (request.Collision)
+        {
+            ReadAhead(sWorld->GetDataPath() + "vmaps/" + VMAP::StaticMapTree::getTileFileName(mapId, gx, gy));
+            snprintf(fileName, sizeof(fileName), "mmaps/%03u%02u%02u.mmtile", mapId, gx, gy);
+            ReadAhead(sWorld->GetDataPath() + fileName);
+        }
+
+        std::lock_guard<std::mutex> guard(_lock);
+
+        _requestedKeys.erase(request.Key);
+        if (!gridMap)
+            continue;
+
+        _ready[request.Key] = gridMap;
+        _readyOrder.push_back(request.Key);
+
+        while (_ready.size() > MAX_READY_GRIDS && !_readyOrder.empty())
+        {
+            auto itr = _ready.find(_readyOrder.front());
+            _readyOrder.pop_front();
+            if (itr == _ready.end())
+                continue;
+
+            delete itr->second;
+            _ready.erase(itr);
+        }
+
+        // keep the order list bounded when most prepared grids are taken
+        if (_readyOrder.size() > MAX_READY_GRIDS * 4)
+        {
+            std::deque<uint32> order;
+            for (uint32 key : _readyOrder)
+                if (_ready.count(key))
+                    order.push_back(key);
+            _readyOrder.swap(order);
+        }
+    }
+}
+
+void GridPrefetcher::ReadAhead(std::string const& filename)
+{
+    FILE* file = fopen(filename.c_str(), "rb");
+    if (!file)
+        return;
+
+    // the data itself is not kept, reading it brings the file into the cache for the map thread
+    char buffer[64 * 1024];
+    size_t count;
+    do
+        count = fread(buffer, 1, sizeof(buffer), file);
+    while (count == sizeof(buffer) && !_cancelationToken);
+
+    fclose(file);
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-GPL2
+ */
+
+#ifndef _GRID_PREFETCHER_H_INCLUDED
+#define _GRID_PREFETCHER_H_INCLUDED
+
+#include "Define.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+class GridMap;
+class Map;
+class Player;
+
+/// Loads the terrain of grids players are heading to on a background thread, before the map needs them.
+/// The map thread takes the prepared GridMap in Map::LoadMap instead of reading the tile itself.
+/// VMap and MMap tiles are only read ahead into the file cache: their managers are not safe to modify
+/// while the map thread queries them, so they are still attached by the map thread.
+class GridPrefetcher
+{
+public:
+    GridPrefetcher();
+    ~GridPrefetcher();
+
+    static GridPrefetcher* instance();
+
+    void Initialize();
+    void Deactivate();
+    bool IsActive() const { return _thread.joinable(); }
+
+    /// Called on player relocation, requests the grid at the player's predicted position if it is not created yet.
+    void PredictGrid(Map* map, Player* player, float oldX, float oldY);
+
+    /// Returns the prefetched terrain of the grid, the caller owns it. nullptr if it was not prefetched.
+    GridMap* TakeGridMap(uint32 mapId, uint32 gx, uint32 gy);
+
+    uint32 GetRequestCount() const { return _requestCount; }
+    uint32 GetUsedCount() const { return _usedCount; }
+
+private:
+    static uint32 MakeKey(uint32 mapId, uint32 gx, uint32 gy) { return (mapId << 12) | (gx << 6) | gy; }
+
+    void Request(uint32 key, bool collision);
+    void WorkerThread();
+    void ReadAhead(std::string const& filename);
+
+    struct PrefetchRequest
+    {
+        uint32 Key;
+        bool Collision;
+    };
+
+    std::thread _thread;
+    std::atomic<bool> _cancelationToken;
+
+    std::mutex _lock;
+    std::condition_variable _condition;
+    std::deque<PrefetchRequest> _requests;
+    std::unordered_set<uint32> _requestedKeys;               // queued or being loaded
+    std::unordered_map<uint32, GridMap*> _ready;
+    std::deque<uint32> _readyOrder;                         // oldest first, entries already taken are skipped
+
+    std::atomic<uint32> _requestCount;
+    std::atomic<uint32> _usedCount;
+};
+
+#define sGridPrefetcher GridPrefetcher::instance()
+
+#endif //_GRID_PREFETCHER_H_INCLUDED
@@ -11,6 +11,7 @@
 #include "Geometry.h"
 #include "GridNotifiers.h"
 #include "GridNotifiersImpl.h"
+#include "GridPrefetcher.h"
 #include "Group.h"
 #include "InstanceScript.h"
 #include "LFGMgr.h"
@@ -24,6 +25,7 @@
 #include "Transport.h"
 #include "Vehicle.h"
 #include "VMapFactory.h"
+#include <ace/Mem_Map.h>
 
 #ifdef ELUNA
 #include "LuaEngine.h"
@@ -196,11 +198,15 @@ void Map::LoadMap(int gx, int gy, bool reload)
 #if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
     sLog->outDetail("Loading map %s", tmp);
 #endif
-    // loading data
-    GridMaps[gx][gy] = new GridMap();
-    if (!GridMaps[gx][gy]->loadData(tmp))
+    // loading data, unless the terrain was already prepared by the grid prefetcher
+    GridMaps[gx][gy] = reload ? nullptr : sGridPrefetcher->TakeGridMap(GetId(), gx, gy);
+    if (!GridMaps[gx][gy])
     {
-        sLog->outError("Error loading map file: \n %s\n", tmp);
+        GridMaps[gx][gy] = new GridMap();
+        if (!GridMaps[gx][gy]->loadData(tmp))
+        {
+            sLog->outError("Error loading map file: \n %s\n", tmp);
+        }
     }
     delete [] tmp;
 
@@ -220,9 +226,13 @@ void Map::LoadMapAndVMap(int gx, int gy)
 Map::Map(uint32 id, uint32 InstanceId, uint8 SpawnMode, Map* _parent) :
     i_mapEntry(sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode), i_InstanceId(InstanceId),
     m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
-    _instanceResetPeriod(0), m_activeNonPlayersIter(m_activeNonPlayers.end()),
-    _transportsUpdateIter(_transports.end()), i_scriptLock(false), _defaultLight(GetDefaultMapLight(id))
+    _batchDelayedVisibility(false), _instanceResetPeriod(0), m_activeNonPlayersIter(m_activeNonPlayers.end()),
+    _transportsUpdateIter(_transports.end()), i_scriptLock(false), _defaultLight(GetDefaultMapLight(id)),
+    _lastUpdateCost(0), _maxUpdateCost(0)
 {
+    _updateCost[0] = 0;
+    _updateCost[1] = 0;
+
     m_parentMap = (_parent ? _parent : this);
     for (unsigned int idx = 0; idx < MAX_NUMBER_OF_GRIDS; ++idx)
     {
@@ -237,6 +247,9 @@ Map::Map(uint32 id, uint32 InstanceId, uint8 SpawnMode, Map* _parent) :
     //lets initialize visibility distance for map
     Map::InitVisibilityDistance();
 
+    if (sWorld->getBoolConfig(CONFIG_SPATIAL_INDEX))
+        _unitIndex = std::make_unique<SpatialHash<Unit>>(float(sWorld->getIntConfig(CONFIG_SPATIAL_INDEX_CELL_SIZE)), SIZE_OF_GRIDS);
+
     sScriptMgr->OnCreateMap(this);
 }
 
@@ -705,6 +718,16 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<acore::Objec
     }
 }
 
+void Map::RecordUpdateCost(bool fullUpdate, uint32 cost)
+{
+    uint32& average = _updateCost[fullUpdate ? 1 : 0];
+    average = average ? (average * 7 + cost) / 8 : cost;
+
+    _lastUpdateCost = cost;
+    if (cost > _maxUpdateCost)
+        _maxUpdateCost = cost;
+}
+
 void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
 {
     if (t_diff)
@@ -842,7 +865,9 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
     MoveAllGameObjectsInMoveList();
     MoveAllDynamicObjectsInMoveList();
 
+    uint32 movers = uint32(i_objectsForDelayedVisibility.size());
     HandleDelayedVisibility();
+    _visibilityThrottle.Update(t_diff, GetUpdateCost(true), movers);
 
     sScriptMgr->OnMapUpdate(this, t_diff);
 
@@ -853,11 +878,82 @@ void Map::HandleDelayedVisibility()
 {
     if (i_objectsForDelayedVisibility.empty())
         return;
+
+    // arena clients are told separately of every unit going out of sight, see Object::DestroyForPlayer
+    _batchDelayedVisibility = !IsBattleArena();
+    for (Unit* unit : i_objectsForDelayedVisibility)
+        if (Player* player = unit->ToPlayer())
+            _visibilityPairs.AddMover(player);
+
     for (std::unordered_set<Unit*>::iterator itr = i_objectsForDelayedVisibility.begin(); itr != i_objectsForDelayedVisibility.end(); ++itr)
         (*itr)->ExecuteDelayedUnitRelocationEvent();
     i_objectsForDelayedVisibility.clear();
+    _visibilityPairs.Clear();
+    _batchDelayedVisibility = false;
+
+    WorldPacket packet;
+    for (auto& itr : _delayedVisibilityUpdates)
+    {
+        Player* player = itr.first;
+        if (itr.second.Packets.empty())
+            continue;
+
+        for (UpdateData& data : itr.second.Packets)
+        {
+            data.BuildPacket(&packet);
+            player->GetSession()->SendPacket(&packet);
+            packet.clear();
+        }
+
+        for (Unit* unit : itr.second.VisibleNow)
+            if (unit->IsInWorld())
+                player->GetInitialVisiblePackets(unit);
+    }
+    _delayedVisibilityUpdates.clear();
+}
+
+template<class T>
+void Map::UpdatePlayerVisibilityOf(Player* player, T* target)
+{
+    if (!_batchDelayedVisibility)
+    {
+        player->UpdateVisibilityOf(target);
+        return;
+    }
+
+    DelayedVisibilityUpdate& update = _delayedVisibilityUpdates[player];
+    player->UpdateVisibilityOf(target, _delayedVisibilityData, update.VisibleNow);
+    if (_delayedVisibilityData.HasData())
+    {
+        AppendDelayedVisibility(update, _delayedVisibilityData);
+        _delayedVisibilityData.Clear();
+    }
 }
 
+bool Map::AddDelayedVisibilityUpdate(Player* player, UpdateData const& data, std::vector<Unit*> const& visibleNow)
+{
+    if (!_batchDelayedVisibility)
+        return false;
+
+    DelayedVisibilityUpdate& update = _delayedVisibilityUpdates[player];
+    AppendDelayedVisibility(update, data);
+    update.VisibleNow.insert(update.VisibleNow.end(), visibleNow.begin(), visibleNow.end());
+    return true;
+}
+
+void Map::AppendDelayedVisibility(DelayedVisibilityUpdate& update, UpdateData const& data)
+{
+    // the client removes the objects of a packet before it creates any, so removals following creations go into
+    // a packet of their own, or an object created and then removed again would be left visible
+    if (update.Packets.empty() || (data.HasOutOfRangeGUIDs() && update.Packets.back().GetBlockCount()))
+        update.Packets.emplace_back();
+
+    update.Packets.back().AddUpdateBlock(data);
+}
+
+template void Map::UpdatePlayerVisibilityOf(Player* player, Player* target);
+template void Map::UpdatePlayerVisibilityOf(Player* player, Creature* target);
+
 struct ResetNotifier
 {
     template<class T>inline void resetNotify(GridRefManager<T>& m)
@@ -961,6 +1057,9 @@ void Map::RemoveFromMap(MotionTransport* obj, bool remove)
 
 void Map::PlayerRelocation(Player* player, float x, float y, float z, float o)
 {
+    if (sGridPrefetcher->IsActive())
+        sGridPrefetcher->PredictGrid(this, player, x, y);
+
     Cell old_cell(player->GetPositionX(), player->GetPositionY());
     Cell new_cell(x, y);
 
@@ -975,6 +1074,8 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float o)
     }
 
     player->Relocate(x, y, z, o);
+    if (_unitIndex)
+        _unitIndex->Update(player, x, y, player->GetObjectSize());
     if (player->IsVehicle())
         player->GetVehicleKit()->RelocatePassengers();
 
@@ -997,6 +1098,8 @@ void Map::CreatureRelocation(Creature* creature, float x, float y, float z, floa
         RemoveCreatureFromMoveList(creature);
 
     creature->Relocate(x, y, z, o);
+    if (_unitIndex)
+        _unitIndex->Update(creature, x, y, creature->GetObjectSize());
     if (creature->IsVehicle())
         creature->GetVehicleKit()->RelocatePassengers();
 
@@ -1292,6 +1395,9 @@ GridMap::GridMap()
     _liquidEntry = nullptr;
     _liquidFlags = nullptr;
     _liquidMap  = nullptr;
+    // Storage
+    _fileMapping = nullptr;
+    _heapSize = 0;
 }
 
 GridMap::~GridMap()
@@ -1299,64 +1405,242 @@ GridMap::~GridMap()
     unloadData();
 }
 
+GridMapStats& GridMap::GetStats()
+{
+    static GridMapStats stats;
+    return stats;
+}
+
 bool GridMap::loadData(char* filename)
 {
     // Unload old data if exist
     unloadData();
 
-    map_fileheader header;
-    // Not return error if file not found
-    FILE* in = fopen(filename, "rb");
-    if (!in)
-        return true;
+    auto startTime = std::chrono::steady_clock::now();
+    bool result = true;
 
-    if (fread(&header, sizeof(header), 1, in) != 1)
+    if (sWorld->getBoolConfig(CONFIG_MAP_FILES_MEMORY_MAPPED) && loadMappedData(filename))
+        ++GetStats().MappedCount;
+    else
     {
-        fclose(in);
-        return false;
-    }
+        // the tile could not be used in place (missing, misaligned or damaged), read it the regular way
+        unloadData();
 
-    if (header.mapMagic == MapMagic.asUInt && header.versionMagic == MapVersionMagic.asUInt)
-    {
-        // loadup area data
-        if (header.areaMapOffset && !loadAreaData(in, header.areaMapOffset, header.areaMapSize))
+        map_fileheader header;
+        // Not return error if file not found
+        FILE* in = fopen(filename, "rb");
+        if (!in)
+            return true;
+
+        if (fread(&header, sizeof(header), 1, in) != 1)
         {
-            sLog->outError("Error loading map area data\n");
             fclose(in);
             return false;
         }
-        // loadup height data
-        if (header.heightMapOffset && !loadHeightData(in, header.heightMapOffset, header.heightMapSize))
+
+        if (header.mapMagic == MapMagic.asUInt && header.versionMagic == MapVersionMagic.asUInt)
         {
-            sLog->outError("Error loading map height data\n");
-            fclose(in);
+            // loadup area data
+            if (header.areaMapOffset && !loadAreaData(in, header.areaMapOffset, header.areaMapSize))
+            {
+                sLog->outError("Error loading map area data\n");
+                result = false;
+            }
+            // loadup height data
+            else if (header.heightMapOffset && !loadHeightData(in, header.heightMapOffset, header.heightMapSize))
+            {
+                sLog->outError("Error loading map height data\n");
+                result = false;
+            }
+            // loadup liquid data
+            else if (header.liquidMapOffset && !loadLiquidData(in, header.liquidMapOffset, header.liquidMapSize))
+            {
+                sLog->outError("Error loading map liquids data\n");
+                result = false;
+            }
+        }
+        else
+        {
+            sLog->outError("Map file '%s' is from an incompatible clientversion. Please recreate using the mapextractor.", filename);
+            result = false;
+        }
+
+        fclose(in);
+    }
+
+    ++GetStats().LoadCount;
+    GetStats().LoadTime += std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - startTime).count();
+    return result;
+}
+
+bool GridMap::loadMappedData(char const* filename)
+{
+    _fileMapping = new ACE_Mem_Map();
+    if (_fileMapping->map(filename, static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ, ACE_MAP_SHARED) == -1)
+    {
+        delete _fileMapping;
+        _fileMapping = nullptr;
+        return false;
+    }
+
+    // the mapping stays valid without the descriptor, which would otherwise be held by every loaded tile
+    _fileMapping->close_handle();
+    GetStats().MappedBytes += _fileMapping->size();
+
+    // The tile layout is used in place: every array directly follows its section header,
+    // so the pointers reference the mapping and nothing is parsed or copied
+    map_fileheader header;
+    uint8 const* raw = mappedArray<uint8>(0, sizeof(header));
+    if (!raw)
+        return false;
+
+    memcpy(&header, raw, sizeof(header));
+    if (header.mapMagic != MapMagic.asUInt || header.versionMagic != MapVersionMagic.asUInt)
+        return false;
+
+    if (header.areaMapOffset)
+    {
+        map_areaHeader areaHeader;
+        if (!(raw = mappedArray<uint8>(header.areaMapOffset, sizeof(areaHeader))))
+            return false;
+
+        memcpy(&areaHeader, raw, sizeof(areaHeader));
+        if (areaHeader.fourcc != MapAreaMagic.asUInt)
+            return false;
+
+        _gridArea = areaHeader.gridArea;
+        if (!(areaHeader.flags & MAP_AREA_NO_AREA) && !(_areaMap = mappedArray<uint16>(header.areaMapOffset + sizeof(areaHeader), 16 * 16)))
             return false;
+    }
+
+    if (header.heightMapOffset)
+    {
+        map_heightHeader heightHeader;
+        if (!(raw = mappedArray<uint8>(header.heightMapOffset, sizeof(heightHeader))))
+            return false;
+
+        memcpy(&heightHeader, raw, sizeof(heightHeader));
+        if (heightHeader.fourcc != MapHeightMagic.asUInt)
+            return false;
+
+        uint32 offset = header.heightMapOffset + sizeof(heightHeader);
+        _gridHeight = heightHeader.gridHeight;
+        if (!(heightHeader.flags & MAP_HEIGHT_NO_HEIGHT))
+        {
+            if ((heightHeader.flags & MAP_HEIGHT_AS_INT16))
+            {
+                m_uint16_V9 = mappedArray<uint16>(offset, 129 * 129);
+                m_uint16_V8 = mappedArray<uint16>(offset + sizeof(uint16) * 129 * 129, 128 * 128);
+                offset += sizeof(uint16) * (129 * 129 + 128 * 128);
+                _gridIntHeightMultiplier = (heightHeader.gridMaxHeight - heightHeader.gridHeight) / 65535;
+                _gridGetHeight = &GridMap::getHeightFromUint16;
+            }
+            else if ((heightHeader.flags & MAP_HEIGHT_AS_INT8))
+            {
+                m_uint8_V9 = mappedArray<uint8>(offset, 129 * 129);
+                m_uint8_V8 = mappedArray<uint8>(offset + sizeof(uint8) * 129 * 129, 128 * 128);
+                offset += sizeof(uint8) * (129 * 129 + 128 * 128);
+                _gridIntHeightMultiplier = (heightHeader.gridMaxHeight - heightHeader.gridHeight) / 255;
+                _gridGetHeight = &GridMap::getHeightFromUint8;
+            }
+            else
+            {
+                m_V9 = mappedArray<float>(offset, 129 * 129);
+                m_V8 = mappedArray<float>(offset + sizeof(float) * 129 * 129, 128 * 128);
+                offset += sizeof(float) * (129 * 129 + 128 * 128);
+                _gridGetHeight = &GridMap::getHeightFromFloat;
+            }
+
+            if (!m_V9 || !m_V8)
+                return false;
         }
-        // loadup liquid data
-        if (header.liquidMapOffset && !loadLiquidData(in, header.liquidMapOffset, header.liquidMapSize))
+
+        if (heightHeader.flags & MAP_HEIGHT_HAS_FLIGHT_BOUNDS)
         {
-            sLog->outError("Error loading map liquids data\n");
-            fclose(in);
+            _maxHeight = mappedArray<int16>(offset, 3 * 3);
+            _minHeight = mappedArray<int16>(offset + sizeof(int16) * 3 * 3, 3 * 3);
+            if (!_maxHeight || !_minHeight)
+                return false;
+        }
+    }
+
+    if (header.liquidMapOffset)
+    {
+        map_liquidHeader liquidHeader;
+        if (!(raw = mappedArray<uint8>(header.liquidMapOffset, sizeof(liquidHeader))))
+            return false;
+
+        memcpy(&liquidHeader, raw, sizeof(liquidHeader));
+        if (liquidHeader.fourcc != MapLiquidMagic.asUInt)
             return false;
+
+        _liquidType   = liquidHeader.liquidType;
+        _liquidOffX  = liquidHeader.offsetX;
+        _liquidOffY  = liquidHeader.offsetY;
+        _liquidWidth = liquidHeader.width;
+        _liquidHeight = liquidHeader.height;
+        _liquidLevel  = liquidHeader.liquidLevel;
+
+        uint32 offset = header.liquidMapOffset + sizeof(liquidHeader);
+        if (!(liquidHeader.flags & MAP_LIQUID_NO_TYPE))
+        {
+            _liquidEntry = mappedArray<uint16>(offset, 16 * 16);
+            _liquidFlags = mappedArray<uint8>(offset + sizeof(uint16) * 16 * 16, 16 * 16);
+            offset += (sizeof(uint16) + sizeof(uint8)) * 16 * 16;
+            if (!_liquidEntry || !_liquidFlags)
+                return false;
         }
-        fclose(in);
-        return true;
+        if (!(liquidHeader.flags & MAP_LIQUID_NO_HEIGHT) && !(_liquidMap = mappedArray<float>(offset, uint32(_liquidWidth) * uint32(_liquidHeight))))
+            return false;
     }
-    sLog->outError("Map file '%s' is from an incompatible clientversion. Please recreate using the mapextractor.", filename);
-    fclose(in);
-    return false;
+
+    return true;
+}
+
+template<class T>
+T* GridMap::allocArray(uint32 count)
+{
+    _heapSize += sizeof(T) * count;
+    GetStats().HeapBytes += sizeof(T) * count;
+    return new T[count];
+}
+
+template<class T>
+T* GridMap::mappedArray(uint32 offset, uint32 count) const
+{
+    // out of the file or not aligned for T, the caller falls back to reading the tile
+    uint64 end = uint64(offset) + uint64(sizeof(T)) * count;
+    if (end > _fileMapping->size())
+        return nullptr;
+
+    uint8* data = static_cast<uint8*>(_fileMapping->addr()) + offset;
+    if (reinterpret_cast<uintptr_t>(data) % alignof(T))
+        return nullptr;
+
+    return reinterpret_cast<T*>(data);
 }
 
 void GridMap::unloadData()
 {
-    delete[] _areaMap;
-    delete[] m_V9;
-    delete[] m_V8;
-    delete[] _maxHeight;
-    delete[] _minHeight;
-    delete[] _liquidEntry;
-    delete[] _liquidFlags;
-    delete[] _liquidMap;
+    if (_fileMapping)
+    {
+        GetStats().MappedBytes -= _fileMapping->size();
+        delete _fileMapping;
+        _fileMapping = nullptr;
+    }
+    else
+    {
+        delete[] _areaMap;
+        delete[] m_V9;
+        delete[] m_V8;
+        delete[] _maxHeight;
+        delete[] _minHeight;
+        delete[] _liquidEntry;
+        delete[] _liquidFlags;
+        delete[] _liquidMap;
+    }
+    GetStats().HeapBytes -= _heapSize;
+    _heapSize = 0;
     _areaMap = nullptr;
     m_V9 = nullptr;
     m_V8 = nullptr;
@@ -1379,7 +1663,7 @@ bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
     _gridArea = header.gridArea;
     if (!(header.flags & MAP_AREA_NO_AREA))
     {
-        _areaMap = new uint16 [16 * 16];
+        _areaMap = allocArray<uint16>(16 * 16);
         if (fread(_areaMap, sizeof(uint16), 16 * 16, in) != 16 * 16)
             return false;
     }
@@ -1399,8 +1683,8 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     {
         if ((header.flags & MAP_HEIGHT_AS_INT16))
         {
-            m_uint16_V9 = new uint16 [129 * 129];
-            m_uint16_V8 = new uint16 [128 * 128];
+            m_uint16_V9 = allocArray<uint16>(129 * 129);
+            m_uint16_V8 = allocArray<uint16>(128 * 128);
             if (fread(m_uint16_V9, sizeof(uint16), 129 * 129, in) != 129 * 129 ||
                     fread(m_uint16_V8, sizeof(uint16), 128 * 128, in) != 128 * 128)
                 return false;
@@ -1409,8 +1693,8 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
         }
         else if ((header.flags & MAP_HEIGHT_AS_INT8))
         {
-            m_uint8_V9 = new uint8 [129 * 129];
-            m_uint8_V8 = new uint8 [128 * 128];
+            m_uint8_V9 = allocArray<uint8>(129 * 129);
+            m_uint8_V8 = allocArray<uint8>(128 * 128);
             if (fread(m_uint8_V9, sizeof(uint8), 129 * 129, in) != 129 * 129 ||
                     fread(m_uint8_V8, sizeof(uint8), 128 * 128, in) != 128 * 128)
                 return false;
@@ -1419,8 +1703,8 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
         }
         else
         {
-            m_V9 = new float [129 * 129];
-            m_V8 = new float [128 * 128];
+            m_V9 = allocArray<float>(129 * 129);
+            m_V8 = allocArray<float>(128 * 128);
             if (fread(m_V9, sizeof(float), 129 * 129, in) != 129 * 129 ||
                     fread(m_V8, sizeof(float), 128 * 128, in) != 128 * 128)
                 return false;
@@ -1432,8 +1716,8 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
 
     if (header.flags & MAP_HEIGHT_HAS_FLIGHT_BOUNDS)
     {
-        _maxHeight = new int16[3 * 3];
-        _minHeight = new int16[3 * 3];
+        _maxHeight = allocArray<int16>(3 * 3);
+        _minHeight = allocArray<int16>(3 * 3);
         if (fread(_maxHeight, sizeof(int16), 3 * 3, in) != 3 * 3 ||
                 fread(_minHeight, sizeof(int16), 3 * 3, in) != 3 * 3)
             return false;
@@ -1459,17 +1743,17 @@ bool GridMap::loadLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
 
     if (!(header.flags & MAP_LIQUID_NO_TYPE))
     {
-        _liquidEntry = new uint16[16 * 16];
+        _liquidEntry = allocArray<uint16>(16 * 16);
         if (fread(_liquidEntry, sizeof(uint16), 16 * 16, in) != 16 * 16)
             return false;
 
-        _liquidFlags = new uint8[16 * 16];
+        _liquidFlags = allocArray<uint8>(16 * 16);
         if (fread(_liquidFlags, sizeof(uint8), 16 * 16, in) != 16 * 16)
             return false;
     }
     if (!(header.flags & MAP_LIQUID_NO_HEIGHT))
     {
-        _liquidMap = new float[uint32(_liquidWidth) * uint32(_liquidHeight)];
+        _liquidMap = allocArray<float>(uint32(_liquidWidth) * uint32(_liquidHeight));
         if (fread(_liquidMap, sizeof(float), _liquidWidth * _liquidHeight, in) != (uint32(_liquidWidth) * uint32(_liquidHeight)))
             return false;
     }
@@ -12,6 +12,7 @@
 #include "DBCStructure.h"
 #include "Define.h"
 #include "DynamicTree.h"
+#include "DynamicVisibility.h"
 #include "GameObjectModel.h"
 #include "GridDefines.h"
 #include "GridRefManager.h"
@@ -19,11 +20,16 @@
 #include "ObjectDefines.h"
 #include "PathGenerator.h"
 #include "SharedDefines.h"
+#include "SpatialHash.h"
 #include "Timer.h"
+#include "UpdateData.h"
+#include "VisibilityPass.h"
 #include <ace/RW_Thread_Mutex.h>
 #include <ace/Thread_Mutex.h>
+#include <atomic>
 #include <bitset>
 #include <list>
+#include <memory>
 
 class Unit;
 class WorldPacket;
@@ -149,6 +155,17 @@ enum LineOfSightChecks
     LINEOFSIGHT_ALL_CHECKS      = (LINEOFSIGHT_CHECK_VMAP | LINEOFSIGHT_CHECK_GOBJECT)
 };
 
+struct GridMapStats
+{
+    std::atomic<uint32> LoadCount{0};
+    std::atomic<uint32> MappedCount{0};
+    std::atomic<uint64> LoadTime{0};                        // microseconds, sum of all loads
+    std::atomic<uint64> HeapBytes{0};                       // currently allocated by loaded tiles
+    std::atomic<uint64> MappedBytes{0};                     // currently mapped by loaded tiles, shared with the page cache
+};
+
+class ACE_Mem_Map;
+
 class GridMap
 {
     uint32  _flags;
@@ -185,9 +202,17 @@ class GridMap
     uint8 _liquidWidth;
     uint8 _liquidHeight;
 
+    // Set when the data pointers reference a read-only mapping of the tile file instead of heap arrays
+    ACE_Mem_Map* _fileMapping;
+    uint32 _heapSize;
+
     bool loadAreaData(FILE* in, uint32 offset, uint32 size);
     bool loadHeightData(FILE* in, uint32 offset, uint32 size);
     bool loadLiquidData(FILE* in, uint32 offset, uint32 size);
+    bool loadMappedData(char const* filename);
+
+    template<class T> T* allocArray(uint32 count);
+    template<class T> T* mappedArray(uint32 offset, uint32 count) const;
 
     // Get height functions and pointers
     typedef float (GridMap::*GetHeightPtr) (float x, float y) const;
@@ -203,6 +228,8 @@ public:
     bool loadData(char* filaname);
     void unloadData();
 
+    static GridMapStats& GetStats();
+
     [[nodiscard]] uint16 getArea(float x, float y) const;
     [[nodiscard]] inline float getHeight(float x, float y) const {return (this->*_gridGetHeight)(x, y);}
     [[nodiscard]] float getMinHeight(float x, float y) const;
@@ -302,6 +329,14 @@ public:
 
     virtual void Update(const uint32, const uint32, bool thread = true);
 
+    // update cost statistics in microseconds, MapUpdater starts the most expensive maps first
+    void RecordUpdateCost(bool fullUpdate, uint32 cost);
+    [[nodiscard]] uint32 GetUpdateCost(bool fullUpdate) const { return _updateCost[fullUpdate ? 1 : 0]; }
+    [[nodiscard]] uint32 GetLastUpdateCost() const { return _lastUpdateCost; }
+    [[nodiscard]] uint32 GetMaxUpdateCost() const { return _maxUpdateCost; }
+    // cost MapUpdater orders the update request of the map by
+    [[nodiscard]] virtual uint32 GetScheduleCost(bool fullUpdate) const { return GetUpdateCost(fullUpdate); }
+
     [[nodiscard]] float GetVisibilityRange() const { return m_VisibleDistance; }
     void SetVisibilityRange(float range) { m_VisibleDistance = range; }
     //function for setting up visibility distance for maps on per-type/per-Id basis
@@ -339,11 +374,26 @@ public:
 
     // pussywizard: movemaps, mmaps
     [[nodiscard]] ACE_RW_Thread_Mutex& GetMMapLock() const { return *(const_cast<ACE_RW_Thread_Mutex*>(&MMapLock)); }
+
+    // players and creatures in world by position, nullptr unless MapUpdate.SpatialIndex is enabled
+    [[nodiscard]] SpatialHash<Unit>* GetUnitIndex() const { return _unitIndex.get(); }
+
+    // visibility settings picked from the load of this map, used with Visibility.Adaptive, see DynamicVisibilityMgr
+    [[nodiscard]] MapVisibilityThrottle const& GetVisibilityThrottle() const { return _visibilityThrottle; }
     // pussywizard:
     std::unordered_set<Object*> i_objectsToUpdate;
     void BuildAndSendUpdateForObjects(); // definition in ObjectAccessor.cpp, below ObjectAccessor::Update, because it does the same for a map
     std::unordered_set<Unit*> i_objectsForDelayedVisibility;
     void HandleDelayedVisibility();
+    /// Player::UpdateVisibilityOf(target), only during HandleDelayedVisibility() the changes are collected and sent
+    /// to the player in one packet with those caused by the other units moving, instead of a packet each
+    template<class T> void UpdatePlayerVisibilityOf(Player* player, T* target);
+    /// During HandleDelayedVisibility() takes the changes a VisibleNotifier collected for its player, to be sent after
+    /// those collected before them, returns false otherwise
+    bool AddDelayedVisibilityUpdate(Player* player, UpdateData const& data, std::vector<Unit*> const& visibleNow);
+    /// False when the visibility of two players moved in the running HandleDelayedVisibility() pass was already
+    /// updated both ways, marks it done otherwise
+    bool MarkVisibilityPair(Player const* first, Player const* second) { return _visibilityPairs.MarkPair(first, second); }
 
     // some calls like isInWater should not use vmaps due to processor power
     // can return INVALID_HEIGHT if under z+2 z coord not found height
@@ -590,6 +640,21 @@ protected:
     uint32 m_unloadTimer;
     float m_VisibleDistance;
     DynamicMapTree _dynamicTree;
+    std::unique_ptr<SpatialHash<Unit>> _unitIndex;
+
+    struct DelayedVisibilityUpdate
+    {
+        std::vector<UpdateData> Packets;
+        std::vector<Unit*> VisibleNow;
+    };
+
+    static void AppendDelayedVisibility(DelayedVisibilityUpdate& update, UpdateData const& data);
+
+    std::unordered_map<Player*, DelayedVisibilityUpdate> _delayedVisibilityUpdates;
+    UpdateData _delayedVisibilityData;
+    bool _batchDelayedVisibility;
+    VisibilityPairs<Player> _visibilityPairs;
+    MapVisibilityThrottle _visibilityThrottle;
     time_t _instanceResetPeriod; // pussywizard
 
     MapRefManager m_mapRefManager;
@@ -663,6 +728,10 @@ private:
 
     ZoneDynamicInfoMap _zoneDynamicInfo;
     uint32 _defaultLight;
+
+    uint32 _updateCost[2]; // moving average of session-only and full updates
+    uint32 _lastUpdateCost;
+    uint32 _maxUpdateCost;
 };
 
 enum InstanceResetMethod
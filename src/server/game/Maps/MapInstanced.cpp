@@ -65,6 +65,15 @@ void MapInstanced::Update(const uint32 t, const uint32 s_diff, bool /*thread*/)
     }
 }
 
+uint32 MapInstanced::GetScheduleCost(bool fullUpdate) const
+{
+    uint32 cost = GetUpdateCost(fullUpdate);
+    for (InstancedMaps::const_iterator i = m_InstancedMaps.begin(); i != m_InstancedMaps.end(); ++i)
+        cost += i->second->GetUpdateCost(fullUpdate);
+
+    return cost;
+}
+
 void MapInstanced::DelayedUpdate(const uint32 diff)
 {
     for (InstancedMaps::iterator i = m_InstancedMaps.begin(); i != m_InstancedMaps.end(); ++i)
@@ -23,6 +23,8 @@ public:
     // functions overwrite Map versions
     void Update(const uint32, const uint32, bool thread = true) override;
     void DelayedUpdate(const uint32 diff) override;
+    // the instances are scheduled by the update of this map, which has to start before theirs
+    [[nodiscard]] uint32 GetScheduleCost(bool fullUpdate) const override;
     //void RelocationNotify();
     void UnloadAll() override;
     bool CanEnter(Player* player, bool loginCheck = false) override;
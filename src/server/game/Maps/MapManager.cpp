@@ -11,6 +11,7 @@
 #include "Corpse.h"
 #include "DatabaseEnv.h"
 #include "GridDefines.h"
+#include "GridPrefetcher.h"
 #include "Group.h"
 #include "InstanceSaveMgr.h"
 #include "InstanceScript.h"
@@ -22,8 +23,10 @@
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
 #include "Opcodes.h"
+#include "PathRequestQueue.h"
 #include "Player.h"
 #include "Transport.h"
+#include "UpdateCompressor.h"
 #include "World.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
@@ -56,6 +59,10 @@ void MapManager::Initialize()
     // Start mtmaps if needed
     if (num_threads > 0)
         m_updater.activate(num_threads);
+
+    sGridPrefetcher->Initialize();
+    sUpdateCompressor->Initialize();
+    sPathRequestQueue->Initialize();
 }
 
 void MapManager::InitializeVisibilityDistanceInfo()
@@ -265,17 +272,35 @@ void MapManager::Update(uint32 diff)
     }
 
     MapMapType::iterator iter = i_maps.begin();
-    for (; iter != i_maps.end(); ++iter)
+    if (m_updater.activated())
     {
-        bool full = mapUpdateStep < 3 && ((mapUpdateStep == 0 && !iter->second->IsBattlegroundOrArena() && !iter->second->IsDungeon()) || (mapUpdateStep == 1 && iter->second->IsBattlegroundOrArena()) || (mapUpdateStep == 2 && iter->second->IsDungeon()));
-        if (m_updater.activated())
-            m_updater.schedule_update(*iter->second, uint32(full ? i_timer[mapUpdateStep].GetCurrent() : 0), diff);
-        else
-            iter->second->Update(uint32(full ? i_timer[mapUpdateStep].GetCurrent() : 0), diff);
-    }
+        // schedule the most expensive maps first, so a crowded continent does not start last and prolong the whole tick
+        std::vector<std::pair<Map*, uint32>> scheduledMaps;
+        scheduledMaps.reserve(i_maps.size());
+        for (; iter != i_maps.end(); ++iter)
+        {
+            bool full = mapUpdateStep < 3 && ((mapUpdateStep == 0 && !iter->second->IsBattlegroundOrArena() && !iter->second->IsDungeon()) || (mapUpdateStep == 1 && iter->second->IsBattlegroundOrArena()) || (mapUpdateStep == 2 && iter->second->IsDungeon()));
+            scheduledMaps.emplace_back(iter->second, uint32(full ? i_timer[mapUpdateStep].GetCurrent() : 0));
+        }
+
+        std::stable_sort(scheduledMaps.begin(), scheduledMaps.end(), [](std::pair<Map*, uint32> const& left, std::pair<Map*, uint32> const& right)
+        {
+            return left.first->GetScheduleCost(left.second != 0) > right.first->GetScheduleCost(right.second != 0);
+        });
+
+        for (std::pair<Map*, uint32> const& scheduled : scheduledMaps)
+            m_updater.schedule_update(*scheduled.first, scheduled.second, diff);
 
-    if (m_updater.activated())
         m_updater.wait();
+    }
+    else
+    {
+        for (; iter != i_maps.end(); ++iter)
+        {
+            bool full = mapUpdateStep < 3 && ((mapUpdateStep == 0 && !iter->second->IsBattlegroundOrArena() && !iter->second->IsDungeon()) || (mapUpdateStep == 1 && iter->second->IsBattlegroundOrArena()) || (mapUpdateStep == 2 && iter->second->IsDungeon()));
+            iter->second->Update(uint32(full ? i_timer[mapUpdateStep].GetCurrent() : 0), diff);
+        }
+    }
 
     sObjectAccessor->ProcessDelayedCorpseActions();
 
@@ -338,6 +363,10 @@ void MapManager::UnloadAll()
 
     if (m_updater.activated())
         m_updater.deactivate();
+
+    sGridPrefetcher->Deactivate();
+    sUpdateCompressor->Deactivate();
+    sPathRequestQueue->Deactivate();
 }
 
 void MapManager::GetNumInstances(uint32& dungeons, uint32& battlegrounds, uint32& arenas)
@@ -357,6 +386,25 @@ void MapManager::GetNumInstances(uint32& dungeons, uint32& battlegrounds, uint32
     }
 }
 
+void MapManager::GetMapsByUpdateCost(std::vector<Map*>& maps)
+{
+    for (MapMapType::iterator itr = i_maps.begin(); itr != i_maps.end(); ++itr)
+    {
+        Map* map = itr->second;
+        maps.push_back(map);
+        if (!map->Instanceable())
+            continue;
+        MapInstanced::InstancedMaps& instances = ((MapInstanced*)map)->GetInstancedMaps();
+        for (MapInstanced::InstancedMaps::iterator mitr = instances.begin(); mitr != instances.end(); ++mitr)
+            maps.push_back(mitr->second);
+    }
+
+    std::sort(maps.begin(), maps.end(), [](Map const* left, Map const* right)
+    {
+        return left->GetUpdateCost(true) > right->GetUpdateCost(true);
+    });
+}
+
 void MapManager::GetNumPlayersInInstances(uint32& dungeons, uint32& battlegrounds, uint32& arenas, uint32& spectators)
 {
     for (MapMapType::iterator itr = i_maps.begin(); itr != i_maps.end(); ++itr)
@@ -8,29 +8,43 @@
 #include "LFGMgr.h"
 #include "Map.h"
 #include "MapUpdater.h"
+#include <chrono>
+#include <limits>
 
 class UpdateRequest
 {
 public:
-    UpdateRequest() = default;
+    // estimated cost is in microseconds, used to start the most expensive requests first
+    explicit UpdateRequest(uint32 estimatedCost) : m_estimatedCost(estimatedCost), m_sequence(0) { }
     virtual ~UpdateRequest() = default;
 
     virtual void call() = 0;
+
+    [[nodiscard]] uint32 GetEstimatedCost() const { return m_estimatedCost; }
+    [[nodiscard]] uint64 GetSequence() const { return m_sequence; }
+    void SetSequence(uint64 sequence) { m_sequence = sequence; }
+
+private:
+    uint32 m_estimatedCost;
+    uint64 m_sequence;
 };
 
 class MapUpdateRequest : public UpdateRequest
 {
 public:
     MapUpdateRequest(Map& m, MapUpdater& u, uint32 d, uint32 sd)
-        : m_map(m), m_updater(u), m_diff(d), s_diff(sd)
+        : UpdateRequest(m.GetScheduleCost(d != 0)), m_map(m), m_updater(u), m_diff(d), s_diff(sd)
     {
     }
 
     void call() override
     {
+        std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
         m_map.Update(m_diff, s_diff);
+        m_map.RecordUpdateCost(m_diff != 0, uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count()));
         m_updater.update_finished();
     }
+
 private:
     Map& m_map;
     MapUpdater& m_updater;
@@ -41,7 +55,8 @@ private:
 class LFGUpdateRequest : public UpdateRequest
 {
 public:
-    LFGUpdateRequest(MapUpdater& u, uint32 d) : m_updater(u), m_diff(d) {}
+    // pussywizard: lfg compatibles update must be processed from the very beginning
+    LFGUpdateRequest(MapUpdater& u, uint32 d) : UpdateRequest(std::numeric_limits<uint32>::max()), m_updater(u), m_diff(d) {}
 
     void call() override
     {
@@ -51,12 +66,23 @@ public:
         lfgDiffTracker.Update(totalTime);
         m_updater.update_finished();
     }
+
 private:
     MapUpdater& m_updater;
     uint32 m_diff;
 };
 
-MapUpdater::MapUpdater(): pending_requests(0)
+bool MapUpdater::RequestCostCompare::operator()(UpdateRequest const* left, UpdateRequest const* right) const
+{
+    uint32 leftCost = left->GetEstimatedCost();
+    uint32 rightCost = right->GetEstimatedCost();
+    if (leftCost != rightCost)
+        return leftCost < rightCost;
+
+    return left->GetSequence() > right->GetSequence();
+}
+
+MapUpdater::MapUpdater(): _requestSequence(0), _cancelationToken(false), pending_requests(0)
 {
 }
 
@@ -79,7 +105,17 @@ void MapUpdater::deactivate()
 
     wait();
 
-    _queue.Cancel();
+    {
+        std::lock_guard<std::mutex> guard(_queueLock);
+
+        while (!_queue.empty())
+        {
+            delete _queue.top();
+            _queue.pop();
+        }
+
+        _queueCondition.notify_all();
+    }
 
     for (auto& thread : _workerThreads)
     {
@@ -103,7 +139,7 @@ void MapUpdater::schedule_update(Map& map, uint32 diff, uint32 s_diff)
 
     ++pending_requests;
 
-    _queue.Push(new MapUpdateRequest(map, *this, diff, s_diff));
+    QueueRequest(new MapUpdateRequest(map, *this, diff, s_diff));
 }
 
 void MapUpdater::schedule_lfg_update(uint32 diff)
@@ -112,7 +148,17 @@ void MapUpdater::schedule_lfg_update(uint32 diff)
 
     ++pending_requests;
 
-    _queue.Push(new LFGUpdateRequest(*this, diff));
+    QueueRequest(new LFGUpdateRequest(*this, diff));
+}
+
+void MapUpdater::QueueRequest(UpdateRequest* request)
+{
+    std::lock_guard<std::mutex> guard(_queueLock);
+
+    request->SetSequence(_requestSequence++);
+    _queue.push(request);
+
+    _queueCondition.notify_one();
 }
 
 bool MapUpdater::activated()
@@ -135,9 +181,18 @@ void MapUpdater::WorkerThread()
     {
         UpdateRequest* request = nullptr;
 
-        _queue.WaitAndPop(request);
-        if (_cancelationToken)
-            return;
+        {
+            std::unique_lock<std::mutex> guard(_queueLock);
+
+            while (_queue.empty() && !_cancelationToken)
+                _queueCondition.wait(guard);
+
+            if (_cancelationToken)
+                return;
+
+            request = _queue.top();
+            _queue.pop();
+        }
 
         request->call();
 
@@ -2,10 +2,12 @@
 #define _MAP_UPDATER_H_INCLUDED
 
 #include "Define.h"
-#include "PCQueue.h"
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
+#include <queue>
 #include <thread>
+#include <vector>
 
 class Map;
 class UpdateRequest;
@@ -25,9 +27,19 @@ public:
     void update_finished();
 
 private:
+    // requests with the highest estimated cost are picked first, equal costs keep scheduling order
+    struct RequestCostCompare
+    {
+        bool operator()(UpdateRequest const* left, UpdateRequest const* right) const;
+    };
+
     void WorkerThread();
+    void QueueRequest(UpdateRequest* request);
 
-    ProducerConsumerQueue<UpdateRequest*> _queue;
+    std::priority_queue<UpdateRequest*, std::vector<UpdateRequest*>, RequestCostCompare> _queue;
+    std::mutex _queueLock;
+    std::condition_variable _queueCondition;
+    uint64 _requestSequence;
 
     std::vector<std::thread> _workerThreads;
     std::atomic<bool> _cancelationToken;
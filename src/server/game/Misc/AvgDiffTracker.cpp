@@ -3,3 +3,6 @@
 AvgDiffTracker avgDiffTracker;
 AvgDiffTracker lfgDiffTracker;
 AvgDiffTracker devDiffTracker;
+AvgDiffTracker sessionDiffTracker;
+DiffHistogram worldDiffHistogram;
+DiffHistogram sessionDiffHistogram;
@@ -2,6 +2,7 @@
 #define __AVGDIFFTRACKER_H
 
 #include "Common.h"
+#include <string>
 
 #define AVG_DIFF_COUNT 500
 
@@ -66,8 +67,57 @@ private:
     uint32 average;
 };
 
+#define DIFF_HISTOGRAM_BUCKETS 9
+
+// Counts update times by range, so that runs with different settings can be compared by their spread and not only the average
+class DiffHistogram
+{
+public:
+    DiffHistogram() { Reset(); }
+
+    void Update(uint32 diff)
+    {
+        uint32 bucket = 0;
+        while (bucket < DIFF_HISTOGRAM_BUCKETS - 1 && diff > GetBucketLimit(bucket))
+            ++bucket;
+        ++counts[bucket];
+    }
+
+    uint32 getCount(uint32 bucket) const { return counts[bucket]; }
+
+    // upper limit of a bucket in ms, the last one has none
+    static uint32 GetBucketLimit(uint32 bucket)
+    {
+        static uint32 const limits[DIFF_HISTOGRAM_BUCKETS - 1] = { 5, 10, 25, 50, 100, 150, 250, 500 };
+        return limits[bucket];
+    }
+
+    std::string ToString() const
+    {
+        std::string result;
+        for (uint32 i = 0; i < DIFF_HISTOGRAM_BUCKETS; ++i)
+        {
+            char buf[32];
+            if (i < DIFF_HISTOGRAM_BUCKETS - 1)
+                snprintf(buf, sizeof(buf), "%s<=%u: %u", i ? ", " : "", GetBucketLimit(i), counts[i]);
+            else
+                snprintf(buf, sizeof(buf), ", >%u: %u", GetBucketLimit(i - 1), counts[i]);
+            result += buf;
+        }
+        return result;
+    }
+
+    void Reset() { memset(&counts, 0, sizeof(counts)); }
+
+private:
+    uint32 counts[DIFF_HISTOGRAM_BUCKETS];
+};
+
 extern AvgDiffTracker avgDiffTracker;
 extern AvgDiffTracker lfgDiffTracker;
 extern AvgDiffTracker devDiffTracker;
+extern AvgDiffTracker sessionDiffTracker;
+extern DiffHistogram worldDiffHistogram;
+extern DiffHistogram sessionDiffHistogram;
 
 #endif
@@ -1,4 +1,6 @@
 #include "DynamicVisibility.h"
+#include "Map.h"
+#include "World.h"
 
 uint8 DynamicVisibilityMgr::visibilitySettingsIndex = 0;
 
@@ -9,3 +11,34 @@ void DynamicVisibilityMgr::Update(uint32 sessionCount)
     else if (visibilitySettingsIndex && sessionCount < visibilitySettingsIndex * ((uint32)VISIBILITY_SETTINGS_PLAYER_INTERVAL) - 100)
         --visibilitySettingsIndex;
 }
+
+VisibilitySettingData const& DynamicVisibilityMgr::GetSettings(Map const* map)
+{
+    uint8 index = sWorld->getBoolConfig(CONFIG_VISIBILITY_ADAPTIVE) ? map->GetVisibilityThrottle().GetLevel() : visibilitySettingsIndex;
+    return VisibilitySettings[index][map->GetEntry()->map_type];
+}
+
+void MapVisibilityThrottle::Update(uint32 diff, uint32 updateCost, uint32 movers)
+{
+    _maxMovers = std::max(_maxMovers, movers);
+    _timer += diff;
+    if (_timer < VISIBILITY_THROTTLE_STEP_INTERVAL)
+        return;
+
+    uint32 targetCost = sWorld->getIntConfig(CONFIG_VISIBILITY_ADAPTIVE_TARGET_COST);
+    uint32 moverLimit = sWorld->getIntConfig(CONFIG_VISIBILITY_ADAPTIVE_MOVERS);
+    uint8 minLevel = uint8(sWorld->getIntConfig(CONFIG_VISIBILITY_ADAPTIVE_MIN_LEVEL));
+    uint8 maxLevel = uint8(sWorld->getIntConfig(CONFIG_VISIBILITY_ADAPTIVE_MAX_LEVEL));
+
+    // one row per step, a map too busy for the row it has gets the next one a second later
+    if (updateCost > targetCost || _maxMovers > moverLimit)
+        ++_level;
+    else if (_level && updateCost < targetCost / 2 && _maxMovers < moverLimit / 2)
+        --_level;
+
+    _level = std::min(std::max(_level, minLevel), maxLevel);
+    _lastMovers = _maxMovers;
+    _lastCost = updateCost;
+    _maxMovers = 0;
+    _timer = 0;
+}
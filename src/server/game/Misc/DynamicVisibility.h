@@ -16,6 +16,7 @@ struct VisibilitySettingData
 // feel free to add more intervals, change existing ones or move to conf file :P
 #define VISIBILITY_SETTINGS_PLAYER_INTERVAL 500
 #define VISIBILITY_SETTINGS_MAX_INTERVAL_NUM 7
+#define VISIBILITY_THROTTLE_STEP_INTERVAL 1000 // ms between two changes of the row of a MapVisibilityThrottle
 const VisibilitySettingData VisibilitySettings[VISIBILITY_SETTINGS_MAX_INTERVAL_NUM][5] =
 {
     { {300, 150, 1.0f}, {300, 150, 1.0f}, {300, 150, 1.0f}, {300, 150, 1.0f}, {300, 150, 1.0f} }, // 0-499
@@ -27,14 +28,43 @@ const VisibilitySettingData VisibilitySettings[VISIBILITY_SETTINGS_MAX_INTERVAL_
     { {1200, 550, 20.0f}, {1200, 550, 25.0f}, {1200, 550, 25.0f}, {1100, 550, 16.0f}, {300, 350, 1.0f} } // 3000+
 };
 
+class Map;
+
+// Row of VisibilitySettings used by a single map, picked from the load of that map instead of the session count
+// of the whole server. It goes up while the update of the map takes longer than Visibility.Adaptive.TargetCost
+// or more of its units than Visibility.Adaptive.Movers wait for a visibility update at once, and down again
+// once both stay below half of that.
+class MapVisibilityThrottle
+{
+public:
+    MapVisibilityThrottle() : _level(0), _timer(0), _maxMovers(0), _lastMovers(0), _lastCost(0) { }
+
+    void Update(uint32 diff, uint32 updateCost, uint32 movers);
+
+    uint8 GetLevel() const { return _level; }
+    // load the level was last chosen from
+    uint32 GetLastMovers() const { return _lastMovers; }
+    uint32 GetLastCost() const { return _lastCost; }
+
+private:
+    uint8 _level;
+    uint32 _timer;
+    uint32 _maxMovers;                                      // most units waiting for a visibility update in one update since the last step
+    uint32 _lastMovers;
+    uint32 _lastCost;
+};
+
 class DynamicVisibilityMgr
 {
 public:
     static void Update(uint32 sessionCount);
-    static uint32 GetVisibilityNotifyDelay(uint32 map_type) { return VisibilitySettings[visibilitySettingsIndex][map_type].visibilityNotifyDelay; }
-    static uint32 GetAINotifyDelay(uint32 map_type) { return VisibilitySettings[visibilitySettingsIndex][map_type].aiNotifyDelay; }
-    static float GetReqMoveDistSq(uint32 map_type) { return VisibilitySettings[visibilitySettingsIndex][map_type].requiredMoveDistanceSq; }
+    // settings of the map, its own row with Visibility.Adaptive
+    static uint32 GetVisibilityNotifyDelay(Map const* map) { return GetSettings(map).visibilityNotifyDelay; }
+    static uint32 GetAINotifyDelay(Map const* map) { return GetSettings(map).aiNotifyDelay; }
+    static float GetReqMoveDistSq(Map const* map) { return GetSettings(map).requiredMoveDistanceSq; }
 protected:
+    static VisibilitySettingData const& GetSettings(Map const* map);
+
     static uint8 visibilitySettingsIndex;
 };
 
@@ -6,6 +6,8 @@ uint32 SavingSystemMgr::m_savingMaxValueAssigned = 0;
 uint32 SavingSystemMgr::m_savingDiffSum = 0;
 std::list<uint32> SavingSystemMgr::m_savingSkipList;
 ACE_Thread_Mutex SavingSystemMgr::_savingLock;
+std::atomic<uint32> SavingSystemMgr::m_savedPlayers(0);
+std::atomic<uint64> SavingSystemMgr::m_savedStatements(0);
 
 void SavingSystemMgr::Update(uint32 diff)
 {
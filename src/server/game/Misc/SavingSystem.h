@@ -2,6 +2,7 @@
 #define __SAVINGSYSTEM_H
 
 #include "Common.h"
+#include <atomic>
 
 // to evenly distribute saving players to db
 
@@ -16,12 +17,19 @@ public:
     static uint32 IncreaseSavingMaxValue(uint32 inc)            { ACORE_GUARD(ACE_Thread_Mutex, _savingLock); return (m_savingMaxValueAssigned += inc); }
     static void InsertToSavingSkipListIfNeeded(uint32 id)       { if (id > m_savingCurrentValue) { ACORE_GUARD(ACE_Thread_Mutex, _savingLock); m_savingSkipList.push_back(id); } }
 
+    // statistics of Player::SaveToDB, saves happen in map update threads
+    static void RecordSave(uint32 statements)                   { ++m_savedPlayers; m_savedStatements += statements; }
+    static uint32 GetSavedPlayerCount()                         { return m_savedPlayers; }
+    static uint64 GetSavedStatementCount()                      { return m_savedStatements; }
+
 protected:
     static uint32 m_savingCurrentValue;
     static uint32 m_savingMaxValueAssigned;
     static uint32 m_savingDiffSum;
     static std::list<uint32> m_savingSkipList;
     static ACE_Thread_Mutex _savingLock;
+    static std::atomic<uint32> m_savedPlayers;
+    static std::atomic<uint64> m_savedStatements;
 };
 
 #endif
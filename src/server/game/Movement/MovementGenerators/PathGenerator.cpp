@@ -17,7 +17,7 @@
  ////////////////// PathGenerator //////////////////
 PathGenerator::PathGenerator(WorldObject const* owner) :
     _polyLength(0), _type(PATHFIND_BLANK), _useStraightPath(false), _forceDestination(false),
-    _slopeCheck(false), _pointPathLimit(MAX_POINT_PATH_LENGTH), _useRaycast(false),
+    _slopeCheck(false), _pointPathLimit(MAX_POINT_PATH_LENGTH), _useRaycast(false), _async(false),
     _endPosition(G3D::Vector3::zero()), _source(owner), _navMesh(nullptr),
     _navMeshQuery(nullptr)
 {
@@ -72,10 +72,71 @@ bool PathGenerator::CalculatePath(float x, float y, float z, float destX, float
 
     UpdateFilter();
 
+    if (_pendingRequest)
+    {
+        // still searched, the caller keeps its current movement
+        if (!_pendingRequest->Done.load(std::memory_order_acquire))
+            return true;
+
+        if (!TakePendingPolyPath())
+        {
+            // no path between the searched polygons, asking again would only queue the same search
+            BuildShortcut();
+            _type = PATHFIND_NOPATH;
+            return true;
+        }
+    }
+
     BuildPolyPath(start, dest);
     return true;
 }
 
+bool PathGenerator::TakeCachedPolyPath(dtPolyRef startPoly, dtPolyRef endPoly)
+{
+    std::vector<dtPolyRef> path;
+    if (!sPathRequestQueue->FindCached(_source->GetMapId(), startPoly, endPoly, _filter, path))
+        return false;
+
+    _polyLength = uint32(path.size());
+    if (_polyLength)
+        memcpy(_pathPolyRefs, path.data(), _polyLength * sizeof(dtPolyRef));
+    return true;
+}
+
+void PathGenerator::RequestPolyPath(dtPolyRef startPoly, dtPolyRef endPoly, float const* startPoint, float const* endPoint)
+{
+    PathRequestQueue::RequestPtr request = std::make_shared<PathRequestQueue::Request>();
+    request->MapId = _source->GetMapId();
+    request->NavMesh = _navMesh;
+    request->MMapLock = &MMAP::MMapFactory::createOrGetMMapManager()->GetMMapLock(request->MapId);
+    request->StartPoly = startPoly;
+    request->EndPoly = endPoly;
+    dtVcopy(request->StartPoint, startPoint);
+    dtVcopy(request->EndPoint, endPoint);
+    request->Filter = _filter;
+
+    _pendingRequest = sPathRequestQueue->Enqueue(request);
+}
+
+bool PathGenerator::TakePendingPolyPath()
+{
+    // the searched corridor becomes the current poly path, BuildPolyPath() cuts the part between
+    // the current start and end out of it, or searches only the end again when the target moved on.
+    // returns false if no corridor was found
+    std::vector<dtPolyRef> const& path = _pendingRequest->Path;
+    bool found = !path.empty();
+    if (found)
+    {
+        _polyLength = uint32(path.size());
+        memcpy(_pathPolyRefs, path.data(), _polyLength * sizeof(dtPolyRef));
+    }
+    else
+        Clear();
+
+    _pendingRequest = nullptr;
+    return found;
+}
+
 dtPolyRef PathGenerator::GetPathPolyByPosition(dtPolyRef const* polyPath, uint32 polyPathSize, float const* point, float* distance) const
 {
     if (!polyPath || !polyPathSize)
@@ -454,6 +515,17 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
                 return;
             }
         }
+        else if (_async && sPathRequestQueue->IsActive())
+        {
+            // searched on a worker thread, unless a unit asked for the same polygons shortly before
+            if (!TakeCachedPolyPath(startPoly, endPoly))
+            {
+                RequestPolyPath(startPoly, endPoly, startPoint, endPoint);
+                return;
+            }
+
+            dtResult = _polyLength ? DT_SUCCESS : DT_FAILURE;
+        }
         else
         {
             dtResult = _navMeshQuery->findPath(
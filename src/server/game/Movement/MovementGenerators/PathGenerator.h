@@ -12,6 +12,7 @@
 #include "MMapFactory.h"
 #include "MMapManager.h"
 #include "MoveSplineInitArgs.h"
+#include "PathRequestQueue.h"
 #include "SharedDefines.h"
 #include <G3D/Vector3.h>
 
@@ -70,6 +71,9 @@ class PathGenerator
         void SetUseStraightPath(bool useStraightPath) { _useStraightPath = useStraightPath; }
         void SetPathLengthLimit(float distance) { _pointPathLimit = std::min<uint32>(uint32(distance/SMOOTH_PATH_STEP_SIZE), MAX_POINT_PATH_LENGTH); }
         void SetUseRaycast(bool useRaycast) { _useRaycast = useRaycast; }
+        // when set, long paths are searched by the path request queue: CalculatePath() returns with IsPathPending()
+        // and the path is built by a CalculatePath() call on a later update
+        void SetAsync(bool async) { _async = async; }
 
         // result getters
         G3D::Vector3 const& GetStartPosition() const { return _startPosition; }
@@ -79,6 +83,7 @@ class PathGenerator
         Movement::PointsArray const& GetPath() const { return _pathPoints; }
 
         PathType GetPathType() const { return _type; }
+        bool IsPathPending() const { return _pendingRequest != nullptr; }
 
         // shortens the path until the destination is the specified distance from the target point
         void ShortenPathUntilDist(G3D::Vector3 const& point, float dist);
@@ -122,6 +127,9 @@ class PathGenerator
         bool _slopeCheck;       // when set, it skips paths with too high slopes (doesn't work with _useStraightPath)
         uint32 _pointPathLimit; // limit point path size; min(this, MAX_POINT_PATH_LENGTH)
         bool _useRaycast;       // use raycast if true for a straight line path
+        bool _async;            // search long paths on the path request queue
+
+        PathRequestQueue::RequestPtr _pendingRequest;   // poly path being searched for an earlier CalculatePath()
 
         G3D::Vector3 _startPosition;        // {x, y, z} of current location
         G3D::Vector3 _endPosition;          // {x, y, z} of the destination
@@ -156,6 +164,10 @@ class PathGenerator
         void BuildPointPath(float const* startPoint, float const* endPoint);
         void BuildShortcut();
 
+        bool TakeCachedPolyPath(dtPolyRef startPoly, dtPolyRef endPoly);
+        void RequestPolyPath(dtPolyRef startPoly, dtPolyRef endPoly, float const* startPoint, float const* endPoint);
+        bool TakePendingPolyPath();
+
         NavTerrain GetNavTerrain(float x, float y, float z) const;
         void CreateFilter();
         void UpdateFilter();
@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-GPL2
+ */
+
+#include "PathRequestQueue.h"
+#include "Common.h"
+#include "DetourNavMeshQuery.h"
+#include "PathGenerator.h"
+#include "Timer.h"
+#include "World.h"
+
+PathRequestQueue::PathRequestQueue() : _cancelationToken(false), _requestCount(0), _cacheHitCount(0)
+{
+}
+
+PathRequestQueue::~PathRequestQueue()
+{
+    Deactivate();
+}
+
+PathRequestQueue* PathRequestQueue::instance()
+{
+    static PathRequestQueue instance;
+    return &instance;
+}
+
+void PathRequestQueue::Initialize()
+{
+    uint32 threads = sWorld->getIntConfig(CONFIG_MMAPS_ASYNC_THREADS);
+    if (IsActive() || !threads || !sWorld->getBoolConfig(CONFIG_ENABLE_MMAPS))
+        return;
+
+    _cancelationToken = false;
+    for (uint32 i = 0; i < threads; ++i)
+        _threads.emplace_back(&PathRequestQueue::WorkerThread, this);
+}
+
+void PathRequestQueue::Deactivate()
+{
+    if (!IsActive())
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _cancelationToken = true;
+        _condition.notify_all();
+    }
+
+    for (std::thread& thread : _threads)
+        thread.join();
+    _threads.clear();
+
+    // generators still waiting fall back to no path
+    for (RequestPtr const& request : _requests)
+        request->Done = true;
+
+    _requests.clear();
+    _pending.clear();
+    _cache.clear();
+    _cacheOrder.clear();
+}
+
+PathRequestQueue::CacheKey PathRequestQueue::MakeKey(uint32 mapId, dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter)
+{
+    return { mapId, uint32(filter.getIncludeFlags()) << 16 | filter.getExcludeFlags(), startPoly, endPoly };
+}
+
+bool PathRequestQueue::FindCached(uint32 mapId, dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter, std::vector<dtPolyRef>& path)
+{
+    std::lock_guard<std::mutex> guard(_cacheLock);
+    auto itr = _cache.find(MakeKey(mapId, startPoly, endPoly, filter));
+    if (itr == _cache.end() || getMSTimeDiff(itr->second.Time, getMSTime()) > sWorld->getIntConfig(CONFIG_MMAPS_PATH_CACHE_TIME))
+        return false;
+
+    path = itr->second.Path;
+    ++_cacheHitCount;
+    return true;
+}
+
+void PathRequestQueue::AddToCache(CacheKey const& key, std::vector<dtPolyRef> const& path)
+{
+    uint32 now = getMSTime();
+    uint32 cacheTime = sWorld->getIntConfig(CONFIG_MMAPS_PATH_CACHE_TIME);
+
+    std::lock_guard<std::mutex> guard(_cacheLock);
+    while (!_cacheOrder.empty() && getMSTimeDiff(_cacheOrder.front().second, now) > cacheTime)
+    {
+        // the entry may have been searched again since, then it is dropped with its newer position in the order
+        auto itr = _cache.find(_cacheOrder.front().first);
+        if (itr != _cache.end() && itr->second.Time == _cacheOrder.front().second)
+            _cache.erase(itr);
+        _cacheOrder.pop_front();
+    }
+
+    if (!cacheTime)
+        return;
+
+    _cache[key] = { path, now };
+    _cacheOrder.emplace_back(key, now);
+}
+
+PathRequestQueue::RequestPtr PathRequestQueue::Enqueue(RequestPtr const& request)
+{
+    CacheKey key = MakeKey(request->MapId, request->StartPoly, request->EndPoly, request->Filter);
+
+    std::lock_guard<std::mutex> guard(_lock);
+    auto itr = _pending.find(key);
+    if (itr != _pending.end())
+        return itr->second;
+
+    request->Done = false;
+    _pending[key] = request;
+    _requests.push_back(request);
+    ++_requestCount;
+    _condition.notify_one();
+    return request;
+}
+
+void PathRequestQueue::WorkerThread()
+{
+    // nav mesh queries are not thread safe, each worker has its own, made on first use for each nav mesh
+    std::unordered_map<dtNavMesh const*, dtNavMeshQuery*> queries;
+
+    while (true)
+    {
+        RequestPtr request;
+        {
+            std::unique_lock<std::mutex> guard(_lock);
+            _condition.wait(guard, [this]() { return _cancelationToken || !_requests.empty(); });
+            if (_cancelationToken)
+                break;
+
+            request = _requests.front();
+            _requests.pop_front();
+        }
+
+        FindPath(*request, queries);
+
+        CacheKey key = MakeKey(request->MapId, request->StartPoly, request->EndPoly, request->Filter);
+        AddToCache(key, request->Path);
+
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            _pending.erase(key);
+        }
+
+        request->Done.store(true, std::memory_order_release);
+    }
+
+    for (auto const& itr : queries)
+        dtFreeNavMeshQuery(itr.second);
+}
+
+void PathRequestQueue::FindPath(Request& request, std::unordered_map<dtNavMesh const*, dtNavMeshQuery*>& queries)
+{
+    dtNavMeshQuery*& query = queries[request.NavMesh];
+    if (!query)
+    {
+        query = dtAllocNavMeshQuery();
+        if (!query || dtStatusFailed(query->init(request.NavMesh, 1024)))
+        {
+            dtFreeNavMeshQuery(query);
+            query = nullptr;
+            return;
+        }
+    }
+
+    dtPolyRef path[MAX_PATH_LENGTH];
+    int pathLength = 0;
+    dtStatus result;
+    {
+        // the map adds and removes tiles under this lock
+        ACORE_READ_GUARD(ACE_RW_Thread_Mutex, *request.MMapLock);
+        result = query->findPath(request.StartPoly, request.EndPoly, request.StartPoint, request.EndPoint, &request.Filter, path, &pathLength, MAX_PATH_LENGTH);
+    }
+
+    if (dtStatusSucceed(result) && pathLength > 0)
+        request.Path.assign(path, path + pathLength);
+}
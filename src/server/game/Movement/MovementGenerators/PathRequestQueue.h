@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-GPL2
+ */
+
+#ifndef _PATH_REQUEST_QUEUE_H
+#define _PATH_REQUEST_QUEUE_H
+
+#include "Define.h"
+#include "DetourExtended.h"
+#include "DetourNavMesh.h"
+#include <ace/RW_Thread_Mutex.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/// Searches the polygon corridors of paths on worker threads, for PathGenerators that would otherwise run the
+/// A* search of dtNavMeshQuery::findPath on the map thread. dtNavMeshQuery is not thread safe, so every worker
+/// has its own one for each nav mesh, and reads the mesh under the map's mmap lock that tile loading takes.
+/// The PathGenerator takes the corridor on a later update. Corridors are also kept for a short time in a cache
+/// shared by all generators, keyed by start and end polygon and filter, so units chasing the same target from
+/// the same spot reuse them.
+class PathRequestQueue
+{
+public:
+    struct Request
+    {
+        uint32 MapId;
+        dtNavMesh const* NavMesh;
+        ACE_RW_Thread_Mutex* MMapLock;
+        dtPolyRef StartPoly;
+        dtPolyRef EndPoly;
+        float StartPoint[3];
+        float EndPoint[3];
+        dtQueryFilterExt Filter;
+        std::vector<dtPolyRef> Path;                        // written by the worker before Done, empty if no path was found
+        std::atomic<bool> Done;
+    };
+
+    typedef std::shared_ptr<Request> RequestPtr;
+
+    PathRequestQueue();
+    ~PathRequestQueue();
+
+    static PathRequestQueue* instance();
+
+    void Initialize();
+    void Deactivate();
+    bool IsActive() const { return !_threads.empty(); }
+
+    /// Corridor searched recently between the same polygons with the same filter
+    bool FindCached(uint32 mapId, dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter, std::vector<dtPolyRef>& path);
+
+    /// Queues the search, returns the request already queued for the same polygons and filter if there is one
+    RequestPtr Enqueue(RequestPtr const& request);
+
+    uint32 GetRequestCount() const { return _requestCount; }
+    uint32 GetCacheHitCount() const { return _cacheHitCount; }
+
+private:
+    struct CacheKey
+    {
+        uint32 MapId;
+        uint32 Flags;                                       // include and exclude flags of the filter
+        dtPolyRef StartPoly;
+        dtPolyRef EndPoly;
+
+        bool operator==(CacheKey const& right) const
+        {
+            return MapId == right.MapId && Flags == right.Flags && StartPoly == right.StartPoly && EndPoly == right.EndPoly;
+        }
+    };
+
+    struct CacheKeyHash
+    {
+        size_t operator()(CacheKey const& key) const
+        {
+            return std::hash<uint64>()(key.StartPoly ^ (key.EndPoly * 0x9E3779B97F4A7C15ULL) ^ (uint64(key.MapId) << 32) ^ key.Flags);
+        }
+    };
+
+    struct CacheEntry
+    {
+        std::vector<dtPolyRef> Path;
+        uint32 Time;
+    };
+
+    static CacheKey MakeKey(uint32 mapId, dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter);
+
+    void WorkerThread();
+    void FindPath(Request& request, std::unordered_map<dtNavMesh const*, dtNavMeshQuery*>& queries);
+    void AddToCache(CacheKey const& key, std::vector<dtPolyRef> const& path);
+
+    std::vector<std::thread> _threads;
+    std::atomic<bool> _cancelationToken;
+
+    std::mutex _lock;
+    std::condition_variable _condition;
+    std::deque<RequestPtr> _requests;
+    std::unordered_map<CacheKey, RequestPtr, CacheKeyHash> _pending;    // queued or being searched
+
+    std::mutex _cacheLock;
+    std::unordered_map<CacheKey, CacheEntry, CacheKeyHash> _cache;
+    std::deque<std::pair<CacheKey, uint32>> _cacheOrder;    // oldest first, to drop expired entries
+
+    std::atomic<uint32> _requestCount;
+    std::atomic<uint32> _cacheHitCount;
+};
+
+#define sPathRequestQueue PathRequestQueue::instance()
+
+#endif
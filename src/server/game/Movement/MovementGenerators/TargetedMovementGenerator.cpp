@@ -131,7 +131,10 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
     }
 
     if (!i_path || moveToward != _movingTowards)
+    {
         i_path = new PathGenerator(owner);
+        i_path->SetAsync(true);
+    }
 
     float x, y, z;
     bool shortenPath;
@@ -153,6 +156,14 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
         owner->UpdateAllowedPositionZ(x, y, z);
 
     bool success = i_path->CalculatePath(x, y, z, forceDest);
+
+    // the path is searched on a path worker, ask again on the next update
+    if (i_path->IsPathPending())
+    {
+        _lastTargetPosition.reset();
+        return true;
+    }
+
     if (!success || i_path->GetPathType() & PATHFIND_NOPATH)
     {
         if (cOwner)
@@ -306,7 +317,10 @@ bool FollowMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
         return true;
 
     if (!i_path)
+    {
         i_path = new PathGenerator(owner);
+        i_path->SetAsync(true);
+    }
 
     float x, y, z;
     // select angle
@@ -335,6 +349,14 @@ bool FollowMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
     target->GetNearPoint(owner, x, y, z, _range, 0.f, target->ToAbsoluteAngle(tAngle));
 
     bool success = i_path->CalculatePath(x, y, z, forceDest);
+
+    // the path is searched on a path worker, ask again on the next update
+    if (i_path->IsPathPending())
+    {
+        _lastTargetPosition.reset();
+        return true;
+    }
+
     if (!success || i_path->GetPathType() & PATHFIND_NOPATH)
     {
         owner->StopMoving();
@@ -104,7 +104,7 @@ OpcodeHandler opcodeTable[NUM_MSG_TYPES] =
     /*0x057*/ { "CMSG_ITEM_QUERY_MULTIPLE",                                STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_NULL                              },
     /*0x058*/ { "SMSG_ITEM_QUERY_SINGLE_RESPONSE",                         STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x059*/ { "SMSG_ITEM_QUERY_MULTIPLE_RESPONSE",                       STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
-    /*0x05A*/ { "CMSG_PAGE_TEXT_QUERY",                                    STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandlePageTextQueryOpcode                },
+    /*0x05A*/ { "CMSG_PAGE_TEXT_QUERY",                                    STATUS_LOGGEDIN,   PROCESS_MAPLOCAL,       &WorldSession::HandlePageTextQueryOpcode                },
     /*0x05B*/ { "SMSG_PAGE_TEXT_QUERY_RESPONSE",                           STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x05C*/ { "CMSG_QUEST_QUERY",                                        STATUS_LOGGEDIN,   PROCESS_THREADSAFE,     &WorldSession::HandleQuestQueryOpcode                   },
     /*0x05D*/ { "SMSG_QUEST_QUERY_RESPONSE",                               STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
@@ -265,13 +265,13 @@ OpcodeHandler opcodeTable[NUM_MSG_TYPES] =
     /*0x0F8*/ { "CMSG_TRIGGER_CINEMATIC_CHEAT",                            STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_NULL                              },
     /*0x0F9*/ { "CMSG_OPENING_CINEMATIC",                                  STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_NULL                              },
     /*0x0FA*/ { "SMSG_TRIGGER_CINEMATIC",                                  STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
-    /*0x0FB*/ { "CMSG_NEXT_CINEMATIC_CAMERA",                              STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleNextCinematicCamera                },
-    /*0x0FC*/ { "CMSG_COMPLETE_CINEMATIC",                                 STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleCompleteCinematic                  },
+    /*0x0FB*/ { "CMSG_NEXT_CINEMATIC_CAMERA",                              STATUS_LOGGEDIN,   PROCESS_MAPLOCAL,       &WorldSession::HandleNextCinematicCamera                },
+    /*0x0FC*/ { "CMSG_COMPLETE_CINEMATIC",                                 STATUS_LOGGEDIN,   PROCESS_MAPLOCAL,       &WorldSession::HandleCompleteCinematic                  },
     /*0x0FD*/ { "SMSG_TUTORIAL_FLAGS",                                     STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
-    /*0x0FE*/ { "CMSG_TUTORIAL_FLAG",                                      STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleTutorialFlag                       },
-    /*0x0FF*/ { "CMSG_TUTORIAL_CLEAR",                                     STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleTutorialClear                      },
-    /*0x100*/ { "CMSG_TUTORIAL_RESET",                                     STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleTutorialReset                      },
-    /*0x101*/ { "CMSG_STANDSTATECHANGE",                                   STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleStandStateChangeOpcode             },
+    /*0x0FE*/ { "CMSG_TUTORIAL_FLAG",                                      STATUS_LOGGEDIN,   PROCESS_MAPLOCAL,       &WorldSession::HandleTutorialFlag                       },
+    /*0x0FF*/ { "CMSG_TUTORIAL_CLEAR",                                     STATUS_LOGGEDIN,   PROCESS_MAPLOCAL,       &WorldSession::HandleTutorialClear                      },
+    /*0x100*/ { "CMSG_TUTORIAL_RESET",                                     STATUS_LOGGEDIN,   PROCESS_MAPLOCAL,       &WorldSession::HandleTutorialReset                      },
+    /*0x101*/ { "CMSG_STANDSTATECHANGE",                                   STATUS_LOGGEDIN,   PROCESS_MAPLOCAL,       &WorldSession::HandleStandStateChangeOpcode             },
     /*0x102*/ { "CMSG_EMOTE",                                              STATUS_LOGGEDIN,   PROCESS_THREADSAFE,     &WorldSession::HandleEmoteOpcode                        },
     /*0x103*/ { "SMSG_EMOTE",                                              STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x104*/ { "CMSG_TEXT_EMOTE",                                         STATUS_LOGGEDIN,   PROCESS_THREADSAFE,     &WorldSession::HandleTextEmoteOpcode                    },
@@ -307,10 +307,10 @@ OpcodeHandler opcodeTable[NUM_MSG_TYPES] =
     /*0x122*/ { "SMSG_INITIALIZE_FACTIONS",                                STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x123*/ { "SMSG_SET_FACTION_VISIBLE",                                STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x124*/ { "SMSG_SET_FACTION_STANDING",                               STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
-    /*0x125*/ { "CMSG_SET_FACTION_ATWAR",                                  STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleSetFactionAtWar                    },
+    /*0x125*/ { "CMSG_SET_FACTION_ATWAR",                                  STATUS_LOGGEDIN,   PROCESS_MAPLOCAL,       &WorldSession::HandleSetFactionAtWar                    },
     /*0x126*/ { "CMSG_SET_FACTION_CHEAT",                                  STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleSetFactionCheat                    },
     /*0x127*/ { "SMSG_SET_PROFICIENCY",                                    STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
-    /*0x128*/ { "CMSG_SET_ACTION_BUTTON",                                  STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleSetActionButtonOpcode              },
+    /*0x128*/ { "CMSG_SET_ACTION_BUTTON",                                  STATUS_LOGGEDIN,   PROCESS_MAPLOCAL,       &WorldSession::HandleSetActionButtonOpcode              },
     /*0x129*/ { "SMSG_ACTION_BUTTONS",                                     STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x12A*/ { "SMSG_INITIAL_SPELLS",                                     STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x12B*/ { "SMSG_LEARNED_SPELL",                                      STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
@@ -332,7 +332,7 @@ OpcodeHandler opcodeTable[NUM_MSG_TYPES] =
     /*0x13B*/ { "CMSG_CANCEL_CHANNELLING",                                 STATUS_LOGGEDIN,   PROCESS_THREADSAFE,     &WorldSession::HandleCancelChanneling                   },
     /*0x13C*/ { "SMSG_AI_REACTION",                                        STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x13D*/ { "CMSG_SET_SELECTION",                                      STATUS_LOGGEDIN,   PROCESS_THREADSAFE,     &WorldSession::HandleSetSelectionOpcode                 },
-    /*0x13E*/ { "CMSG_DELETEEQUIPMENT_SET",                                STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleEquipmentSetDelete                 },
+    /*0x13E*/ { "CMSG_DELETEEQUIPMENT_SET",                                STATUS_LOGGEDIN,   PROCESS_MAPLOCAL,       &WorldSession::HandleEquipmentSetDelete                 },
     /*0x13F*/ { "CMSG_INSTANCE_LOCK_RESPONSE",                             STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleInstanceLockResponse               },
     /*0x140*/ { "CMSG_DEBUG_PASSIVE_AURA",                                 STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_NULL                              },
     /*0x141*/ { "CMSG_ATTACKSWING",                                        STATUS_LOGGEDIN,   PROCESS_THREADSAFE,     &WorldSession::HandleAttackSwingOpcode                  },
@@ -383,10 +383,10 @@ OpcodeHandler opcodeTable[NUM_MSG_TYPES] =
     /*0x16E*/ { "SMSG_MOUNTRESULT",                                        STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x16F*/ { "SMSG_DISMOUNTRESULT",                                     STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x170*/ { "SMSG_REMOVED_FROM_PVP_QUEUE",                             STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
-    /*0x171*/ { "CMSG_MOUNTSPECIAL_ANIM",                                  STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleMountSpecialAnimOpcode             },
+    /*0x171*/ { "CMSG_MOUNTSPECIAL_ANIM",                                  STATUS_LOGGEDIN,   PROCESS_MAPLOCAL,       &WorldSession::HandleMountSpecialAnimOpcode             },
     /*0x172*/ { "SMSG_MOUNTSPECIAL_ANIM",                                  STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x173*/ { "SMSG_PET_TAME_FAILURE",                                   STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
-    /*0x174*/ { "CMSG_PET_SET_ACTION",                                     STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandlePetSetAction                       },
+    /*0x174*/ { "CMSG_PET_SET_ACTION",                                     STATUS_LOGGEDIN,   PROCESS_MAPLOCAL,       &WorldSession::HandlePetSetAction                       },
     /*0x175*/ { "CMSG_PET_ACTION",                                         STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandlePetAction                          },
     /*0x176*/ { "CMSG_PET_ABANDON",                                        STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandlePetAbandon                         },
     /*0x177*/ { "CMSG_PET_RENAME",                                         STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandlePetRename                          },
@@ -474,9 +474,9 @@ OpcodeHandler opcodeTable[NUM_MSG_TYPES] =
     /*0x1C9*/ { "SMSG_FISH_ESCAPED",                                       STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x1CA*/ { "CMSG_BUG",                                                STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleBugOpcode                          },
     /*0x1CB*/ { "SMSG_NOTIFICATION",                                       STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
-    /*0x1CC*/ { "CMSG_PLAYED_TIME",                                        STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandlePlayedTime                         },
+    /*0x1CC*/ { "CMSG_PLAYED_TIME",                                        STATUS_LOGGEDIN,   PROCESS_MAPLOCAL,       &WorldSession::HandlePlayedTime                         },
     /*0x1CD*/ { "SMSG_PLAYED_TIME",                                        STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
-    /*0x1CE*/ { "CMSG_QUERY_TIME",                                         STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleQueryTimeOpcode                    },
+    /*0x1CE*/ { "CMSG_QUERY_TIME",                                         STATUS_LOGGEDIN,   PROCESS_MAPLOCAL,       &WorldSession::HandleQueryTimeOpcode                    },
     /*0x1CF*/ { "SMSG_QUERY_TIME_RESPONSE",                                STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x1D0*/ { "SMSG_LOG_XPGAIN",                                         STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x1D1*/ { "SMSG_AURACASTLOG",                                        STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
@@ -536,8 +536,8 @@ OpcodeHandler opcodeTable[NUM_MSG_TYPES] =
     /*0x207*/ { "CMSG_GMTICKET_UPDATETEXT",                                STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleGMTicketUpdateOpcode               },
     /*0x208*/ { "SMSG_GMTICKET_UPDATETEXT",                                STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x209*/ { "SMSG_ACCOUNT_DATA_TIMES",                                 STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
-    /*0x20A*/ { "CMSG_REQUEST_ACCOUNT_DATA",                               STATUS_AUTHED,     PROCESS_THREADUNSAFE,   &WorldSession::HandleRequestAccountData                 },
-    /*0x20B*/ { "CMSG_UPDATE_ACCOUNT_DATA",                                STATUS_AUTHED,     PROCESS_THREADUNSAFE,   &WorldSession::HandleUpdateAccountData                  },
+    /*0x20A*/ { "CMSG_REQUEST_ACCOUNT_DATA",                               STATUS_AUTHED,     PROCESS_MAPLOCAL,       &WorldSession::HandleRequestAccountData                 },
+    /*0x20B*/ { "CMSG_UPDATE_ACCOUNT_DATA",                                STATUS_AUTHED,     PROCESS_MAPLOCAL,       &WorldSession::HandleUpdateAccountData                  },
     /*0x20C*/ { "SMSG_UPDATE_ACCOUNT_DATA",                                STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x20D*/ { "SMSG_CLEAR_FAR_SIGHT_IMMEDIATE",                          STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x20E*/ { "SMSG_CHANGEPLAYER_DIFFICULTY_RESULT",                     STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
@@ -681,7 +681,7 @@ OpcodeHandler opcodeTable[NUM_MSG_TYPES] =
     /*0x298*/ { "SMSG_RESET_RANGED_COMBAT_TIMER",                          STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x299*/ { "SMSG_MEETINGSTONE_MEMBER_ADDED",                          STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x29A*/ { "SMSG_CHAT_NOT_IN_PARTY",                                  STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
-    /*0x29B*/ { "CMSG_CANCEL_GROWTH_AURA",                                 STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleCancelGrowthAuraOpcode             },
+    /*0x29B*/ { "CMSG_CANCEL_GROWTH_AURA",                                 STATUS_LOGGEDIN,   PROCESS_MAPLOCAL,       &WorldSession::HandleCancelGrowthAuraOpcode             },
     /*0x29C*/ { "SMSG_CANCEL_AUTO_REPEAT",                                 STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x29D*/ { "SMSG_STANDSTATE_UPDATE",                                  STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x29E*/ { "SMSG_LOOT_ALL_PASSED",                                    STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
@@ -711,13 +711,13 @@ OpcodeHandler opcodeTable[NUM_MSG_TYPES] =
     /*0x2B6*/ { "SMSG_SCRIPT_MESSAGE",                                     STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x2B7*/ { "SMSG_DUEL_COUNTDOWN",                                     STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x2B8*/ { "SMSG_AREA_TRIGGER_MESSAGE",                               STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
-    /*0x2B9*/ { "CMSG_SHOWING_HELM",                                       STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleShowingHelmOpcode                  },
-    /*0x2BA*/ { "CMSG_SHOWING_CLOAK",                                      STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleShowingCloakOpcode                 },
+    /*0x2B9*/ { "CMSG_SHOWING_HELM",                                       STATUS_LOGGEDIN,   PROCESS_MAPLOCAL,       &WorldSession::HandleShowingHelmOpcode                  },
+    /*0x2BA*/ { "CMSG_SHOWING_CLOAK",                                      STATUS_LOGGEDIN,   PROCESS_MAPLOCAL,       &WorldSession::HandleShowingCloakOpcode                 },
     /*0x2BB*/ { "SMSG_LFG_ROLE_CHOSEN",                                    STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x2BC*/ { "SMSG_PLAYER_SKINNED",                                     STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x2BD*/ { "SMSG_DURABILITY_DAMAGE_DEATH",                            STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x2BE*/ { "CMSG_SET_EXPLORATION",                                    STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_NULL                              },
-    /*0x2BF*/ { "CMSG_SET_ACTIONBAR_TOGGLES",                              STATUS_AUTHED,     PROCESS_THREADUNSAFE,   &WorldSession::HandleSetActionBarToggles                },
+    /*0x2BF*/ { "CMSG_SET_ACTIONBAR_TOGGLES",                              STATUS_AUTHED,     PROCESS_MAPLOCAL,       &WorldSession::HandleSetActionBarToggles                },
     /*0x2C0*/ { "UMSG_DELETE_GUILD_CHARTER",                               STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_NULL                              },
     /*0x2C1*/ { "MSG_PETITION_RENAME",                                     STATUS_LOGGEDIN,   PROCESS_THREADSAFE,     &WorldSession::HandlePetitionRenameOpcode               },
     /*0x2C2*/ { "SMSG_INIT_WORLD_STATES",                                  STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
@@ -805,8 +805,8 @@ OpcodeHandler opcodeTable[NUM_MSG_TYPES] =
     /*0x314*/ { "SMSG_GAMETIMEBIAS_SET",                                   STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x315*/ { "CMSG_DEBUG_ACTIONS_START",                                STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_NULL                              },
     /*0x316*/ { "CMSG_DEBUG_ACTIONS_STOP",                                 STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_NULL                              },
-    /*0x317*/ { "CMSG_SET_FACTION_INACTIVE",                               STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleSetFactionInactiveOpcode           },
-    /*0x318*/ { "CMSG_SET_WATCHED_FACTION",                                STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleSetWatchedFactionOpcode            },
+    /*0x317*/ { "CMSG_SET_FACTION_INACTIVE",                               STATUS_LOGGEDIN,   PROCESS_MAPLOCAL,       &WorldSession::HandleSetFactionInactiveOpcode           },
+    /*0x318*/ { "CMSG_SET_WATCHED_FACTION",                                STATUS_LOGGEDIN,   PROCESS_MAPLOCAL,       &WorldSession::HandleSetWatchedFactionOpcode            },
     /*0x319*/ { "MSG_MOVE_TIME_SKIPPED",                                   STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_NULL                              },
     /*0x31A*/ { "SMSG_SPLINE_MOVE_ROOT",                                   STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x31B*/ { "CMSG_SET_EXPLORATION_ALL",                                STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_NULL                              },
@@ -1039,7 +1039,7 @@ OpcodeHandler opcodeTable[NUM_MSG_TYPES] =
     /*0x3FE*/ { "MSG_GUILD_BANK_MONEY_WITHDRAWN",                          STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleGuildBankMoneyWithdrawn            },
     /*0x3FF*/ { "MSG_GUILD_EVENT_LOG_QUERY",                               STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleGuildEventLogQueryOpcode           },
     /*0x400*/ { "CMSG_MAELSTROM_RENAME_GUILD",                             STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_NULL                              },
-    /*0x401*/ { "CMSG_GET_MIRRORIMAGE_DATA",                               STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleMirrorImageDataRequest             },
+    /*0x401*/ { "CMSG_GET_MIRRORIMAGE_DATA",                               STATUS_LOGGEDIN,   PROCESS_MAPLOCAL,       &WorldSession::HandleMirrorImageDataRequest             },
     /*0x402*/ { "SMSG_MIRRORIMAGE_DATA",                                   STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x403*/ { "SMSG_FORCE_DISPLAY_UPDATE",                               STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x404*/ { "SMSG_SPELL_CHANCE_RESIST_PUSHBACK",                       STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
@@ -1061,7 +1061,7 @@ OpcodeHandler opcodeTable[NUM_MSG_TYPES] =
     /*0x414*/ { "CMSG_TOTEM_DESTROYED",                                    STATUS_LOGGEDIN,   PROCESS_THREADSAFE,     &WorldSession::HandleTotemDestroyed                     },
     /*0x415*/ { "CMSG_EXPIRE_RAID_INSTANCE",                               STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_NULL                              },
     /*0x416*/ { "CMSG_NO_SPELL_VARIANCE",                                  STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_NULL                              },
-    /*0x417*/ { "CMSG_QUESTGIVER_STATUS_MULTIPLE_QUERY",                   STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleQuestgiverStatusMultipleQuery      },
+    /*0x417*/ { "CMSG_QUESTGIVER_STATUS_MULTIPLE_QUERY",                   STATUS_LOGGEDIN,   PROCESS_MAPLOCAL,       &WorldSession::HandleQuestgiverStatusMultipleQuery      },
     /*0x418*/ { "SMSG_QUESTGIVER_STATUS_MULTIPLE",                         STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x419*/ { "CMSG_SET_PLAYER_DECLINED_NAMES",                          STATUS_AUTHED,     PROCESS_THREADUNSAFE,   &WorldSession::HandleSetPlayerDeclinedNames             },
     /*0x41A*/ { "SMSG_SET_PLAYER_DECLINED_NAMES_RESULT",                   STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
@@ -1136,7 +1136,7 @@ OpcodeHandler opcodeTable[NUM_MSG_TYPES] =
     /*0x45F*/ { "CMSG_CALENDAR_EVENT_INVITE_NOTES",                        STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_NULL                              },
     /*0x460*/ { "SMSG_CALENDAR_EVENT_INVITE_NOTES",                        STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x461*/ { "SMSG_CALENDAR_EVENT_INVITE_NOTES_ALERT",                  STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
-    /*0x462*/ { "CMSG_UPDATE_MISSILE_TRAJECTORY",                          STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleUpdateMissileTrajectory            },
+    /*0x462*/ { "CMSG_UPDATE_MISSILE_TRAJECTORY",                          STATUS_LOGGEDIN,   PROCESS_MAPLOCAL,       &WorldSession::HandleUpdateMissileTrajectory            },
     /*0x463*/ { "SMSG_UPDATE_ACCOUNT_DATA_COMPLETE",                       STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x464*/ { "SMSG_TRIGGER_MOVIE",                                      STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x465*/ { "CMSG_COMPLETE_MOVIE",                                     STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_NULL                              },
@@ -1179,7 +1179,7 @@ OpcodeHandler opcodeTable[NUM_MSG_TYPES] =
     /*0x48A*/ { "CMSG_REMOVE_GLYPH",                                       STATUS_LOGGEDIN,   PROCESS_THREADSAFE,     &WorldSession::HandleRemoveGlyph                        },
     /*0x48B*/ { "CMSG_DUMP_OBJECTS",                                       STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_NULL                              },
     /*0x48C*/ { "SMSG_DUMP_OBJECTS_DATA",                                  STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
-    /*0x48D*/ { "CMSG_DISMISS_CRITTER",                                    STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleDismissCritter                     },
+    /*0x48D*/ { "CMSG_DISMISS_CRITTER",                                    STATUS_LOGGEDIN,   PROCESS_MAPLOCAL,       &WorldSession::HandleDismissCritter                     },
     /*0x48E*/ { "SMSG_NOTIFY_DEST_LOC_SPELL_CAST",                         STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x48F*/ { "CMSG_AUCTION_LIST_PENDING_SALES",                         STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleAuctionListPendingSales            },
     /*0x490*/ { "SMSG_AUCTION_LIST_PENDING_SALES",                         STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
@@ -1228,7 +1228,7 @@ OpcodeHandler opcodeTable[NUM_MSG_TYPES] =
     /*0x4BB*/ { "SMSG_CALENDAR_CLEAR_PENDING_ACTION",                      STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x4BC*/ { "SMSG_EQUIPMENT_SET_LIST",                                 STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x4BD*/ { "CMSG_EQUIPMENT_SET_SAVE",                                 STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleEquipmentSetSave                   },
-    /*0x4BE*/ { "CMSG_UPDATE_PROJECTILE_POSITION",                         STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleUpdateProjectilePosition           },
+    /*0x4BE*/ { "CMSG_UPDATE_PROJECTILE_POSITION",                         STATUS_LOGGEDIN,   PROCESS_MAPLOCAL,       &WorldSession::HandleUpdateProjectilePosition           },
     /*0x4BF*/ { "SMSG_SET_PROJECTILE_POSITION",                            STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x4C0*/ { "SMSG_TALENTS_INFO",                                       STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_ServerSide                        },
     /*0x4C1*/ { "CMSG_LEARN_PREVIEW_TALENTS",                              STATUS_LOGGEDIN,   PROCESS_THREADSAFE,     &WorldSession::HandleLearnPreviewTalents                },
@@ -1344,7 +1344,8 @@ enum PacketProcessing
 {
     PROCESS_INPLACE = 0,                                    //process packet whenever we receive it - mostly for non-handled or non-implemented packets
     PROCESS_THREADUNSAFE,                                   //packet is not thread-safe - process it in World::UpdateSessions()
-    PROCESS_THREADSAFE                                      //packet is thread-safe - process it in Map::Update()
+    PROCESS_THREADSAFE,                                     //packet is thread-safe - process it in Map::Update()
+    PROCESS_MAPLOCAL                                        //packet touches only the player and their map - process it in Map::Update() if MapUpdate.ParallelSessions is enabled, in World::UpdateSessions() otherwise
 };
 
 class WorldSession;
@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-GPL2
+ */
+
+#ifndef ACORE_PACKETCAPTURE_H
+#define ACORE_PACKETCAPTURE_H
+
+#include "Define.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+/// Last packets of one direction of a socket, kept in a byte ring where new packets overwrite the oldest ones.
+/// Only one thread at a time adds packets, any thread can copy the ring without stopping it: the writer moves
+/// the oldest kept position past the packets it is about to overwrite, a copy checks it again after reading,
+/// like a seqlock, and keeps only the packets that were not overwritten meanwhile.
+class PacketCaptureRing
+{
+public:
+    struct Header
+    {
+        uint32 Size;                                        // bytes of the packet after the header
+        uint32 Opcode;
+        uint32 Time;
+        uint32 Order;                                       // orders the packets of both directions of a socket
+    };
+
+    /// capacity is rounded up to a power of two
+    explicit PacketCaptureRing(uint32 capacity) : _capacity(RoundUp(capacity)), _buffer(new uint8[_capacity]), _oldest(0), _end(0) { }
+
+    PacketCaptureRing(PacketCaptureRing const&) = delete;
+    PacketCaptureRing& operator=(PacketCaptureRing const&) = delete;
+
+    /// Packets bigger than a quarter of the ring are not kept, returns false for them
+    bool Add(Header const& header, uint8 const* data)
+    {
+        uint64 recordSize = sizeof(Header) + header.Size;
+        if (recordSize > _capacity / 4)
+            return false;
+
+        // only this thread changes the positions
+        uint64 end = _end.load(std::memory_order_relaxed);
+        uint64 oldest = _oldest.load(std::memory_order_relaxed);
+        if (end + recordSize - oldest > _capacity)
+        {
+            do
+            {
+                Header old;
+                Read(oldest, reinterpret_cast<uint8*>(&old), sizeof(Header));
+                oldest += sizeof(Header) + old.Size;
+            } while (end + recordSize - oldest > _capacity);
+
+            // readers see the new oldest position before any of the bytes overwritten below
+            _oldest.store(oldest, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+
+        Write(end, reinterpret_cast<uint8 const*>(&header), sizeof(Header));
+        if (header.Size)
+            Write(end + sizeof(Header), data, header.Size);
+
+        _end.store(end + recordSize, std::memory_order_release);
+        return true;
+    }
+
+    /// Calls visitor(Header const&, uint8 const* data) for every packet kept, from the oldest one
+    template <class Visitor>
+    void Visit(Visitor&& visitor) const
+    {
+        // end first: the writer only moves oldest forward, so an oldest position loaded after it is at most
+        // a ring away from it, an oldest loaded before could be further behind an end added to meanwhile
+        uint64 end = _end.load(std::memory_order_acquire);
+        uint64 oldest = _oldest.load(std::memory_order_acquire);
+        if (oldest >= end)
+            return;
+
+        uint32 size = uint32(std::min<uint64>(end - oldest, _capacity));
+        uint64 start = end - size;
+        std::unique_ptr<uint8[]> copy(new uint8[size]);
+        Read(start, copy.get(), size);
+
+        // packets the writer started to overwrite while copying are left out
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64 valid = _oldest.load(std::memory_order_relaxed);
+        if (valid >= end || valid < start)
+            return;
+
+        for (uint64 pos = valid; pos < end;)
+        {
+            Header header;
+            memcpy(&header, copy.get() + (pos - start), sizeof(Header));
+            visitor(header, copy.get() + (pos - start) + sizeof(Header));
+            pos += sizeof(Header) + header.Size;
+        }
+    }
+
+    [[nodiscard]] uint32 GetCapacity() const { return _capacity; }
+
+private:
+    static uint32 RoundUp(uint32 value)
+    {
+        uint32 result = 1024;
+        while (result < value)
+            result <<= 1;
+        return result;
+    }
+
+    void Write(uint64 pos, uint8 const* data, uint32 size)
+    {
+        uint32 offset = uint32(pos & (_capacity - 1));
+        uint32 first = std::min(size, _capacity - offset);
+        memcpy(_buffer.get() + offset, data, first);
+        memcpy(_buffer.get(), data + first, size - first);
+    }
+
+    void Read(uint64 pos, uint8* data, uint32 size) const
+    {
+        uint32 offset = uint32(pos & (_capacity - 1));
+        uint32 first = std::min(size, _capacity - offset);
+        memcpy(data, _buffer.get() + offset, first);
+        memcpy(data + first, _buffer.get(), size - first);
+    }
+
+    uint32 const _capacity;
+    std::unique_ptr<uint8[]> const _buffer;
+    std::atomic<uint64> _oldest;                            // position of the oldest packet kept
+    std::atomic<uint64> _end;                               // position after the newest complete packet
+};
+
+/// Recent traffic of one socket, one ring for each direction.
+/// Packets of both directions are added by the network thread of the socket, sent ones when it writes them.
+class PacketCapture
+{
+public:
+    struct Packet
+    {
+        uint32 Opcode;
+        uint32 Time;
+        uint8 Direction;
+        std::vector<uint8> Data;
+    };
+
+    /// bufferSize is the size of the ring of each direction
+    explicit PacketCapture(uint32 bufferSize) : _rings{ PacketCaptureRing(bufferSize), PacketCaptureRing(bufferSize) }, _order(0), _skippedPackets(0), _accountId(0),
+        _lastDump(0) { }
+
+    /// direction is 0 for received and 1 for sent packets, as in PacketLog
+    void Add(uint8 direction, uint32 opcode, uint32 time, uint8 const* data, uint32 size)
+    {
+        PacketCaptureRing::Header header;
+        header.Size = size;
+        header.Opcode = opcode;
+        header.Time = time;
+        header.Order = _order.fetch_add(1, std::memory_order_relaxed);
+
+        if (!_rings[direction].Add(header, data))
+            ++_skippedPackets;
+    }
+
+    /// Packets of both directions kept since the given time, in the order they were added
+    std::vector<Packet> GetPackets(uint32 since) const
+    {
+        std::vector<std::pair<uint32, Packet>> packets;
+        for (uint8 direction = 0; direction < 2; ++direction)
+        {
+            _rings[direction].Visit([&packets, direction, since](PacketCaptureRing::Header const& header, uint8 const* data)
+            {
+                if (header.Time >= since)
+                    packets.emplace_back(header.Order, Packet{ header.Opcode, header.Time, direction, std::vector<uint8>(data, data + header.Size) });
+            });
+        }
+
+        std::sort(packets.begin(), packets.end(), [](std::pair<uint32, Packet> const& left, std::pair<uint32, Packet> const& right)
+        {
+            return int32(left.first - right.first) < 0;
+        });
+
+        std::vector<Packet> result;
+        result.reserve(packets.size());
+        for (std::pair<uint32, Packet>& packet : packets)
+            result.push_back(std::move(packet.second));
+        return result;
+    }
+
+    /// Packets too big for the rings since the capture started
+    [[nodiscard]] uint32 GetSkippedPackets() const { return _skippedPackets; }
+
+    /// False if the last dump was less than minInterval seconds ago, records now as the time of the last dump otherwise
+    bool StartDump(uint32 now, uint32 minInterval)
+    {
+        uint32 lastDump = _lastDump.load(std::memory_order_relaxed);
+        if (lastDump && now - lastDump < minInterval)
+            return false;
+
+        return _lastDump.compare_exchange_strong(lastDump, now, std::memory_order_relaxed);
+    }
+
+    void SetAccountId(uint32 accountId) { _accountId = accountId; }
+    [[nodiscard]] uint32 GetAccountId() const { return _accountId; }
+
+private:
+    PacketCaptureRing _rings[2];
+    std::atomic<uint32> _order;
+    std::atomic<uint32> _skippedPackets;
+    std::atomic<uint32> _accountId;
+    std::atomic<uint32> _lastDump;
+};
+
+#endif
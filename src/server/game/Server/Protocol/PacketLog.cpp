@@ -6,16 +6,38 @@
 
 #include "ByteBuffer.h"
 #include "Config.h"
+#include "Log.h"
+#include "Opcodes.h"
+#include "PacketCapture.h"
 #include "PacketLog.h"
+#include "StringFormat.h"
+#include "Util.h"
 #include "WorldPacket.h"
 
-PacketLog::PacketLog() : _file(nullptr)
+namespace
+{
+    // dumps waiting for the dump thread, more are refused
+    constexpr size_t MAX_QUEUED_CAPTURE_DUMPS = 32;
+}
+
+PacketLog::PacketLog() : _file(nullptr), _captureBufferSize(0), _captureSeconds(0), _captureMinInterval(0), _captureDumps(0), _stopDumps(false)
 {
     Initialize();
 }
 
 PacketLog::~PacketLog()
 {
+    if (_dumpThread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> guard(_dumpLock);
+            _stopDumps = true;
+        }
+
+        _dumpCondition.notify_one();
+        _dumpThread.join();
+    }
+
     if (_file)
         fclose(_file);
 
@@ -39,6 +61,118 @@ void PacketLog::Initialize()
     std::string logname = sConfigMgr->GetOption<std::string>("PacketLogFile", "");
     if (!logname.empty())
         _file = fopen((logsDir + logname).c_str(), "wb");
+
+    _logsDir = logsDir;
+    _captureBufferSize = sConfigMgr->GetOption<int32>("PacketLog.Capture.BufferSize", 0);
+    _captureSeconds = sConfigMgr->GetOption<int32>("PacketLog.Capture.Seconds", 60);
+    _captureMinInterval = sConfigMgr->GetOption<int32>("PacketLog.Capture.MinInterval", 60);
+
+    _captureTriggerOpcodes.assign(NUM_MSG_TYPES, false);
+    Tokenizer opcodes(sConfigMgr->GetOption<std::string>("PacketLog.Capture.TriggerOpcodes", ""), ' ');
+    for (char const* token : opcodes)
+    {
+        uint32 opcode = strtoul(token, nullptr, 0);
+        if (opcode < NUM_MSG_TYPES)
+            _captureTriggerOpcodes[opcode] = true;
+        else
+            sLog->outError("PacketLog.Capture.TriggerOpcodes: %s is not an opcode, ignored.", token);
+    }
+
+    _captureTriggerReasons.clear();
+    Tokenizer reasons(sConfigMgr->GetOption<std::string>("PacketLog.Capture.TriggerReasons", ""), ';');
+    for (char const* token : reasons)
+        if (*token)
+            _captureTriggerReasons.push_back(token);
+
+    if (_captureBufferSize && !_dumpThread.joinable())
+        _dumpThread = std::thread(&PacketLog::DumpThread, this);
+}
+
+bool PacketLog::IsCaptureTriggerReason(std::string const& reason) const
+{
+    for (std::string const& trigger : _captureTriggerReasons)
+        if (reason.find(trigger) != std::string::npos)
+            return true;
+    return false;
+}
+
+std::string PacketLog::DumpCapture(std::shared_ptr<PacketCapture> const& capture, std::string const& reason, bool force)
+{
+    time_t now = time(nullptr);
+    if (!capture->StartDump(uint32(now), force ? 0 : _captureMinInterval))
+        return std::string();
+
+    CaptureDump dump;
+    dump.Capture = capture;
+    dump.Since = uint32(now) - _captureSeconds;
+    // several dumps of one account can be made in the same second
+    dump.FileName = acore::StringFormat("%sCapture_%u_%s_%u.bin", _logsDir.c_str(), capture->GetAccountId(), TimeToTimestampStr(now).c_str(), ++_captureDumps);
+    dump.Reason = reason;
+    std::string filename = dump.FileName;
+
+    {
+        std::lock_guard<std::mutex> guard(_dumpLock);
+        if (_dumps.size() >= MAX_QUEUED_CAPTURE_DUMPS)
+        {
+            sLog->outError("PacketLog: %u packet captures are waiting to be written, capture of account %u (%s) dropped",
+                uint32(_dumps.size()), capture->GetAccountId(), reason.c_str());
+            return std::string();
+        }
+
+        _dumps.push_back(std::move(dump));
+    }
+
+    _dumpCondition.notify_one();
+    return filename;
+}
+
+void PacketLog::DumpThread()
+{
+    std::unique_lock<std::mutex> guard(_dumpLock);
+    while (true)
+    {
+        _dumpCondition.wait(guard, [this]() { return _stopDumps || !_dumps.empty(); });
+        if (_dumps.empty())
+            return;
+
+        CaptureDump dump = std::move(_dumps.front());
+        _dumps.pop_front();
+
+        guard.unlock();
+        WriteCaptureDump(dump);
+        guard.lock();
+    }
+}
+
+void PacketLog::WriteCaptureDump(CaptureDump const& dump)
+{
+    // the rings are copied while the socket keeps adding packets, see PacketCaptureRing
+    std::vector<PacketCapture::Packet> packets = dump.Capture->GetPackets(dump.Since);
+
+    FILE* file = fopen(dump.FileName.c_str(), "wb");
+    if (!file)
+    {
+        sLog->outError("PacketLog: can't write packet capture file %s", dump.FileName.c_str());
+        return;
+    }
+
+    for (PacketCapture::Packet const& packet : packets)
+    {
+        ByteBuffer data(4 + 4 + 4 + 1 + packet.Data.size());
+        data << int32(packet.Opcode);
+        data << int32(packet.Data.size());
+        data << uint32(packet.Time);
+        data << uint8(packet.Direction);
+        if (!packet.Data.empty())
+            data.append(packet.Data.data(), packet.Data.size());
+
+        fwrite(data.contents(), 1, data.size(), file);
+    }
+
+    fclose(file);
+
+    sLog->outString("PacketLog: %u packets of account %u written to %s (%s), %u packets were too big to keep", uint32(packets.size()), dump.Capture->GetAccountId(),
+        dump.FileName.c_str(), dump.Reason.c_str(), dump.Capture->GetSkippedPackets());
 }
 
 void PacketLog::LogPacket(WorldPacket const& packet, Direction direction)
@@ -8,6 +8,12 @@
 #define ACORE_PACKETLOG_H
 
 #include "Common.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 enum Direction
 {
@@ -15,6 +21,7 @@ enum Direction
     SERVER_TO_CLIENT
 };
 
+class PacketCapture;
 class WorldPacket;
 
 class PacketLog
@@ -30,8 +37,45 @@ public:
     bool CanLogPacket() const { return (_file != nullptr); }
     void LogPacket(WorldPacket const& packet, Direction direction);
 
+    /// Sockets keep their recent traffic in a PacketCapture when this is set, and write it out on a trigger
+    bool CanCapturePackets() const { return _captureBufferSize != 0; }
+    uint32 GetCaptureBufferSize() const { return _captureBufferSize; }
+    bool IsCaptureTriggerOpcode(uint16 opcode) const { return opcode < _captureTriggerOpcodes.size() && _captureTriggerOpcodes[opcode]; }
+    bool IsCaptureTriggerReason(std::string const& reason) const;
+
+    /// Queues the packets of the last PacketLog.Capture.Seconds to be written in the format of PacketLogFile by the dump
+    /// thread, returns the file name or an empty string if nothing is written. Unless forced, a capture is dumped at most
+    /// once per PacketLog.Capture.MinInterval
+    std::string DumpCapture(std::shared_ptr<PacketCapture> const& capture, std::string const& reason, bool force = false);
+
 private:
+    struct CaptureDump
+    {
+        std::shared_ptr<PacketCapture> Capture;
+        uint32 Since;
+        std::string FileName;
+        std::string Reason;
+    };
+
+    void DumpThread();
+    void WriteCaptureDump(CaptureDump const& dump);
+
     FILE* _file;
+
+    std::string _logsDir;
+    uint32 _captureBufferSize;
+    uint32 _captureSeconds;
+    std::vector<bool> _captureTriggerOpcodes;
+    std::vector<std::string> _captureTriggerReasons;
+    uint32 _captureMinInterval;
+    std::atomic<uint32> _captureDumps;
+
+    // dumps are written on their own thread, sockets only queue them
+    std::thread _dumpThread;
+    std::mutex _dumpLock;
+    std::condition_variable _dumpCondition;
+    std::deque<CaptureDump> _dumps;
+    bool _stopDumps;
 };
 
 #define sPacketLog PacketLog::instance()
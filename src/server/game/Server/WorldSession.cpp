@@ -34,6 +34,7 @@
 #include "World.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
+#include "WorldSocketMgr.h"
 #include "zlib.h"
 
 #ifdef ELUNA
@@ -60,6 +61,9 @@ bool MapSessionFilter::Process(WorldPacket* packet)
     if (opHandle.packetProcessing == PROCESS_THREADUNSAFE)
         return false;
 
+    if (opHandle.packetProcessing == PROCESS_MAPLOCAL && !sWorld->getBoolConfig(CONFIG_MAP_UPDATE_PARALLEL_SESSIONS))
+        return false;
+
     Player* player = m_pSession->GetPlayer();
     if (!player)
         return false;
@@ -80,6 +84,9 @@ bool WorldSessionFilter::Process(WorldPacket* packet)
     if (opHandle.packetProcessing == PROCESS_THREADUNSAFE)
         return true;
 
+    if (opHandle.packetProcessing == PROCESS_MAPLOCAL && !sWorld->getBoolConfig(CONFIG_MAP_UPDATE_PARALLEL_SESSIONS))
+        return true;
+
     Player* player = m_pSession->GetPlayer();
     if (!player)
         return true;
@@ -114,6 +121,8 @@ WorldSession::WorldSession(uint32 id, WorldSocket* sock, AccountTypes sec, uint8
     m_TutorialsChanged(false),
     recruiterId(recruiter),
     isRecruiter(isARecruiter),
+    _recvQueue(sWorldSocketMgr->GetRecvQueueSize()),
+    _recvOverflowing(false),
     m_currentVendorEntry(0),
     m_currentBankerGUID(0),
     timeWhoCommandAllowed(0),
@@ -164,6 +173,8 @@ WorldSession::~WorldSession()
     WorldPacket* packet = nullptr;
     while (_recvQueue.next(packet))
         delete packet;
+    for (WorldPacket* overflowPacket : _recvOverflow)
+        delete overflowPacket;
 
     if (GetShouldSetOfflineInDB())
         LoginDatabase.PExecute("UPDATE account SET online = 0 WHERE id = %u;", GetAccountId());     // One-time query
@@ -247,7 +258,27 @@ void WorldSession::SendPacket(WorldPacket const* packet)
 /// Add an incoming packet to the queue
 void WorldSession::QueuePacket(WorldPacket* new_packet)
 {
-    _recvQueue.add(new_packet);
+    // once a packet overflowed, the following ones go after it until Update() moved them all into the queue
+    if (!_recvOverflowing.load(std::memory_order_acquire) && _recvQueue.add(new_packet))
+        return;
+
+    std::lock_guard<std::mutex> guard(_recvOverflowLock);
+    _recvOverflow.push_back(new_packet);
+    _recvOverflowing.store(true, std::memory_order_release);
+}
+
+/// Move overflowed packets into the queue as far as there is room
+void WorldSession::MoveRecvOverflow()
+{
+    if (!_recvOverflowing.load(std::memory_order_acquire))
+        return;
+
+    std::lock_guard<std::mutex> guard(_recvOverflowLock);
+    while (!_recvOverflow.empty() && _recvQueue.add(_recvOverflow.front()))
+        _recvOverflow.pop_front();
+
+    if (_recvOverflow.empty())
+        _recvOverflowing.store(false, std::memory_order_release);
 }
 
 /// Update the WorldSession (triggered by World update)
@@ -273,7 +304,9 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
     uint32 processedPackets = 0;
     time_t currentTime = time(nullptr);
 
-    while (m_Socket && !m_Socket->IsClosed() && !_recvQueue.empty() && _recvQueue.peek(true) != firstDelayedPacket && _recvQueue.next(packet, updater))
+    MoveRecvOverflow();
+
+    while (m_Socket && !m_Socket->IsClosed() && _recvQueue.peek(packet) && packet != firstDelayedPacket && _recvQueue.next(packet, updater))
     {
         if (packet->GetOpcode() >= NUM_MSG_TYPES)
         {
@@ -639,6 +672,14 @@ void WorldSession::KickPlayer(std::string const& reason, bool setKicked)
         SetKicked(true); // pussywizard: the session won't be left ingame for 60 seconds and to also kick offline session
 }
 
+std::string WorldSession::DumpPacketCapture(std::string const& reason)
+{
+    if (!m_Socket)
+        return std::string();
+
+    return m_Socket->DumpCapture(reason, true);
+}
+
 void WorldSession::SendNotification(const char* format, ...)
 {
     if (format)
@@ -22,6 +22,8 @@
 #include "SharedDefines.h"
 #include "World.h"
 #include "WorldPacket.h"
+#include <deque>
+#include <mutex>
 #include <utility>
 
 class Creature;
@@ -262,6 +264,9 @@ public:
     void LogoutPlayer(bool save);
     void KickPlayer(bool setKicked = true) { return this->KickPlayer("Unknown reason", setKicked); }
     void KickPlayer(std::string const& reason, bool setKicked = true);
+    /// Writes the recent traffic of the socket to a file when packet capture is enabled, returns the file name.
+    /// Not rate limited like the dumps of trigger opcodes and reasons
+    std::string DumpPacketCapture(std::string const& reason);
 
     void QueuePacket(WorldPacket* new_packet);
     bool Update(uint32 diff, PacketFilter& updater);
@@ -993,6 +998,8 @@ private:
 
     bool recoveryItem(Item* pItem);
 
+    void MoveRecvOverflow();
+
     // EnumData helpers
     bool IsLegitCharacterForAccount(uint32 lowGUID)
     {
@@ -1035,7 +1042,11 @@ private:
     AddonsList m_addonsList;
     uint32 recruiterId;
     bool isRecruiter;
-    ACE_Based::LockedQueue<WorldPacket*, ACE_Thread_Mutex> _recvQueue;
+    acore::MPSCQueue<WorldPacket*> _recvQueue;
+    // received packets that did not fit into _recvQueue, moved into it as it empties
+    std::deque<WorldPacket*> _recvOverflow;
+    std::mutex _recvOverflowLock;
+    std::atomic<bool> _recvOverflowing;
     uint32 m_currentVendorEntry;
     uint64 m_currentBankerGUID;
     time_t timeWhoCommandAllowed;
@@ -11,11 +11,13 @@
 #include "DatabaseEnv.h"
 #include "Log.h"
 #include "Opcodes.h"
+#include "PacketCapture.h"
 #include "PacketLog.h"
 #include "Player.h"
 #include "ScriptMgr.h"
 #include "SHA1.h"
 #include "SharedDefines.h"
+#include "StringFormat.h"
 #include "Util.h"
 #include "World.h"
 #include "WorldPacket.h"
@@ -28,9 +30,9 @@
 #include <ace/os_include/sys/os_socket.h>
 #include <ace/os_include/sys/os_types.h>
 #include <ace/OS_NS_string.h>
+#include <ace/OS_NS_sys_socket.h>
 #include <ace/OS_NS_unistd.h>
 #include <ace/Reactor.h>
-#include <thread>
 
 #ifdef ELUNA
 #include "LuaEngine.h"
@@ -92,21 +94,26 @@ struct ClientPktHeader
 WorldSocket::WorldSocket(void): WorldHandler(),
     m_LastPingTime(SystemTimePoint::min()), m_OverSpeedPings(0), m_Session(0),
     m_RecvWPct(0), m_RecvPct(), m_Header(sizeof (ClientPktHeader)),
-    m_OutBuffer(0), m_OutBufferSize(65536), m_OutActive(false),
-    m_Seed(static_cast<uint32> (rand32()))
+    m_SendQueue(sWorldSocketMgr->GetSendQueueSize()), m_SendOverflowing(false), m_OutActive(false), m_SendCalls(0), m_SentPackets(0),
+    m_PendingSession(nullptr), m_Seed(static_cast<uint32> (rand32()))
 {
     reference_counting_policy().value (ACE_Event_Handler::Reference_Counting_Policy::ENABLED);
 
-    msg_queue()->high_water_mark(8 * 1024 * 1024);
-    msg_queue()->low_water_mark(8 * 1024 * 1024);
+    if (sPacketLog->CanCapturePackets())
+        m_Capture = std::make_shared<PacketCapture>(sPacketLog->GetCaptureBufferSize());
 }
 
 WorldSocket::~WorldSocket(void)
 {
     delete m_RecvWPct;
 
-    if (m_OutBuffer)
-        m_OutBuffer->release();
+    WorldPacket* packet = nullptr;
+    while (m_SendQueue.next(packet))
+        delete packet;
+    for (WorldPacket* overflowPacket : m_SendOverflow)
+        delete overflowPacket;
+    for (OutgoingPacket const& outgoing : m_OutPackets)
+        delete outgoing.Packet;
 
     closing_ = true;
 
@@ -124,7 +131,7 @@ void WorldSocket::CloseSocket(std::string const& reason)
         sLog->outDebug(LOG_FILTER_CLOSE_SOCKET, "Socket closed because of: %s", reason.c_str());
 
     {
-        ACE_GUARD (LockType, Guard, m_OutBufferLock);
+        ACE_GUARD (LockType, Guard, m_OutLock);
 
         if (closing_)
             return;
@@ -133,6 +140,9 @@ void WorldSocket::CloseSocket(std::string const& reason)
         peer().close_writer();
     }
 
+    if (m_Capture && sPacketLog->IsCaptureTriggerReason(reason))
+        DumpCapture(reason);
+
     {
         ACE_GUARD (LockType, Guard, m_SessionLock);
 
@@ -145,51 +155,92 @@ const std::string& WorldSocket::GetRemoteAddress(void) const
     return m_Address;
 }
 
+std::string WorldSocket::DumpCapture(std::string const& reason, bool force)
+{
+    if (!m_Capture)
+        return std::string();
+
+    return sPacketLog->DumpCapture(m_Capture, reason, force);
+}
+
+void WorldSocket::CapturePacket(WorldPacket const& packet, Direction direction)
+{
+    m_Capture->Add(uint8(direction), packet.GetOpcode(), uint32(time(nullptr)), packet.contents(), uint32(packet.size()));
+
+    if (sPacketLog->IsCaptureTriggerOpcode(packet.GetOpcode()))
+        DumpCapture(acore::StringFormat("opcode %s", LookupOpcodeName(packet.GetOpcode())));
+}
+
 int WorldSocket::SendPacket(WorldPacket const& pct)
 {
-    ACE_GUARD_RETURN (LockType, Guard, m_OutBufferLock, -1);
+    if (closing_)
+        return -1;
 
+    return QueuePacket(new WorldPacket(pct));
+}
+
+int WorldSocket::SendPacket(WorldPacket&& pct)
+{
     if (closing_)
         return -1;
 
-    // Dump outgoing packet.
-    if (sPacketLog->CanLogPacket())
-        sPacketLog->LogPacket(pct, SERVER_TO_CLIENT);
+    return QueuePacket(new WorldPacket(std::move(pct)));
+}
 
-    ServerPktHeader header(pct.size() + 2, pct.GetOpcode());
-    m_Crypt.EncryptSend ((uint8*)header.header, header.getHeaderLength());
+int WorldSocket::QueuePacket(WorldPacket* pct)
+{
+    // once a packet overflowed, the following ones go after it until the network thread took them all
+    if (!m_SendOverflowing.load(std::memory_order_acquire) && m_SendQueue.add(pct))
+        return 0;
 
-    if (m_OutBuffer->space() >= pct.size() + header.getHeaderLength() && msg_queue()->is_empty())
-    {
-        // Put the packet on the buffer.
-        if (m_OutBuffer->copy((char*) header.header, header.getHeaderLength()) == -1)
-            ACE_ASSERT (false);
+    std::lock_guard<std::mutex> guard(m_SendOverflowLock);
+    m_SendOverflow.push_back(pct);
+    m_SendOverflowing.store(true, std::memory_order_release);
+    return 0;
+}
 
-        if (!pct.empty())
-            if (m_OutBuffer->copy((char*) pct.contents(), pct.size()) == -1)
-                ACE_ASSERT (false);
-    }
-    else
+void WorldSocket::TakeQueuedPackets()
+{
+    auto take = [this](WorldPacket* pct)
     {
-        // Enqueue the packet.
-        ACE_Message_Block* mb;
+        // Dump outgoing packet.
+        if (sPacketLog->CanLogPacket())
+            sPacketLog->LogPacket(*pct, SERVER_TO_CLIENT);
 
-        ACE_NEW_RETURN(mb, ACE_Message_Block(pct.size() + header.getHeaderLength()), -1);
+        if (m_Capture)
+            CapturePacket(*pct, SERVER_TO_CLIENT);
 
-        mb->copy((char*) header.header, header.getHeaderLength());
+        m_SentPackets.store(m_SentPackets.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
 
-        if (!pct.empty())
-            mb->copy((const char*)pct.contents(), pct.size());
+        // headers are encrypted in the order the packets were queued
+        ServerPktHeader header(pct->size() + 2, pct->GetOpcode());
+        m_Crypt.EncryptSend ((uint8*)header.header, header.getHeaderLength());
 
-        if (msg_queue()->enqueue_tail(mb, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
-        {
-            sLog->outError("WorldSocket::SendPacket enqueue_tail failed");
-            mb->release();
-            return -1;
-        }
-    }
+        OutgoingPacket outgoing;
+        outgoing.Packet = pct;
+        memcpy(outgoing.Header, header.header, header.getHeaderLength());
+        outgoing.HeaderSize = header.getHeaderLength();
+        outgoing.Written = 0;
+        m_OutPackets.push_back(outgoing);
+    };
 
-    return 0;
+    WorldPacket* pct = nullptr;
+    while (m_SendQueue.next(pct))
+        take(pct);
+
+    if (!m_SendOverflowing.load(std::memory_order_acquire))
+        return;
+
+    // producers add to the overflow while it is not empty, so it goes after everything in the queue
+    std::lock_guard<std::mutex> guard(m_SendOverflowLock);
+    while (m_SendQueue.next(pct))
+        take(pct);
+
+    for (WorldPacket* overflowPacket : m_SendOverflow)
+        take(overflowPacket);
+
+    m_SendOverflow.clear();
+    m_SendOverflowing.store(false, std::memory_order_release);
 }
 
 long WorldSocket::AddReference(void)
@@ -207,7 +258,7 @@ int WorldSocket::open(void* a)
     ACE_UNUSED_ARG (a);
 
     // Prevent double call to this func.
-    if (m_OutBuffer)
+    if (m_OutActive)
         return -1;
 
     // This will also prevent the socket from being Updated
@@ -218,9 +269,6 @@ int WorldSocket::open(void* a)
     if (sWorldSocketMgr->OnSocketOpen(this) == -1)
         return -1;
 
-    // Allocate the buffer.
-    ACE_NEW_RETURN (m_OutBuffer, ACE_Message_Block (m_OutBufferSize), -1);
-
     // Store peer address.
     ACE_INET_Addr remote_addr;
 
@@ -245,7 +293,7 @@ int WorldSocket::open(void* a)
     seed2.SetRand(16 * 8);
     packet.append(seed2.AsByteArray(16).get(), 16);               // new encryption seeds
 
-    if (SendPacket(packet) == -1)
+    if (SendPacket(std::move(packet)) == -1)
         return -1;
 
     // Register with ACE Reactor
@@ -314,116 +362,95 @@ int WorldSocket::handle_input(ACE_HANDLE)
 
 int WorldSocket::handle_output(ACE_HANDLE)
 {
-    ACE_GUARD_RETURN (LockType, Guard, m_OutBufferLock, -1);
+    ACE_GUARD_RETURN (LockType, Guard, m_OutLock, -1);
 
     if (closing_)
         return -1;
 
-    size_t send_len = m_OutBuffer->length();
-
-    if (send_len == 0)
-        return handle_output_queue(Guard);
-
-#ifdef MSG_NOSIGNAL
-    ssize_t n = peer().send (m_OutBuffer->rd_ptr(), send_len, MSG_NOSIGNAL);
-#else
-    ssize_t n = peer().send (m_OutBuffer->rd_ptr(), send_len);
-#endif // MSG_NOSIGNAL
-
-    if (n == 0)
-        return -1;
-    else if (n == -1)
-    {
-        if (errno == EWOULDBLOCK || errno == EAGAIN)
-            return schedule_wakeup_output (Guard);
-
-        return -1;
-    }
-    else if (n < (ssize_t)send_len) //now n > 0
-    {
-        m_OutBuffer->rd_ptr (static_cast<size_t> (n));
+    TakeQueuedPackets();
 
-        // move the data to the base of the buffer
-        m_OutBuffer->crunch();
+    // Gather the headers and contents of the waiting packets into a single send call.
+    iovec iov[MAX_SEND_IOV];
+    int iovcnt = 0;
+    size_t send_len = 0;
 
-        return schedule_wakeup_output (Guard);
-    }
-    else //now n == send_len
+    for (auto itr = m_OutPackets.begin(); itr != m_OutPackets.end() && iovcnt + 2 <= MAX_SEND_IOV; ++itr)
     {
-        m_OutBuffer->reset();
+        size_t written = itr->Written;
+        if (written < itr->HeaderSize)
+        {
+            iov[iovcnt].iov_base = itr->Header + written;
+            iov[iovcnt].iov_len = itr->HeaderSize - written;
+            send_len += iov[iovcnt++].iov_len;
+            written = 0;
+        }
+        else
+            written -= itr->HeaderSize;
 
-        return handle_output_queue (Guard);
+        if (itr->Packet->size() > written)
+        {
+            iov[iovcnt].iov_base = itr->Packet->contents() + written;
+            iov[iovcnt].iov_len = itr->Packet->size() - written;
+            send_len += iov[iovcnt++].iov_len;
+        }
     }
 
-    ACE_NOTREACHED (return 0);
-}
-
-int WorldSocket::handle_output_queue(GuardType& g)
-{
-    if (msg_queue()->is_empty())
-        return cancel_wakeup_output(g);
+    if (iovcnt == 0)
+        return cancel_wakeup_output(Guard);
 
-    ACE_Message_Block* mblk;
-
-    if (msg_queue()->dequeue_head(mblk, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
-    {
-        sLog->outError("WorldSocket::handle_output_queue dequeue_head");
-        return -1;
-    }
-
-    const size_t send_len = mblk->length();
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = iovcnt;
 
 #ifdef MSG_NOSIGNAL
-    ssize_t n = peer().send(mblk->rd_ptr(), send_len, MSG_NOSIGNAL);
+    ssize_t n = ACE_OS::sendmsg(get_handle(), &msg, MSG_NOSIGNAL);
 #else
-    ssize_t n = peer().send(mblk->rd_ptr(), send_len);
+    ssize_t n = ACE_OS::sendmsg(get_handle(), &msg, 0);
 #endif // MSG_NOSIGNAL
 
-    if (n == 0)
-    {
-        mblk->release();
+    m_SendCalls.store(m_SendCalls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
 
+    if (n == 0)
         return -1;
-    }
     else if (n == -1)
     {
         if (errno == EWOULDBLOCK || errno == EAGAIN)
-        {
-            msg_queue()->enqueue_head(mblk, (ACE_Time_Value*) &ACE_Time_Value::zero);
-            return schedule_wakeup_output (g);
-        }
+            return schedule_wakeup_output (Guard);
 
-        mblk->release();
         return -1;
     }
-    else if (n < (ssize_t)send_len) //now n > 0
-    {
-        mblk->rd_ptr(static_cast<size_t> (n));
 
-        if (msg_queue()->enqueue_head(mblk, (ACE_Time_Value*) &ACE_Time_Value::zero) == -1)
+    // now n > 0, drop the packets that were written
+    size_t sent = static_cast<size_t> (n);
+
+    while (sent > 0)
+    {
+        OutgoingPacket& outgoing = m_OutPackets.front();
+        size_t left = outgoing.HeaderSize + outgoing.Packet->size() - outgoing.Written;
+        if (sent < left)
         {
-            sLog->outError("WorldSocket::handle_output_queue enqueue_head");
-            mblk->release();
-            return -1;
+            outgoing.Written += sent;
+            break;
         }
 
-        return schedule_wakeup_output (g);
+        sent -= left;
+        delete outgoing.Packet;
+        m_OutPackets.pop_front();
     }
-    else //now n == send_len
-    {
-        mblk->release();
 
-        return msg_queue()->is_empty() ? cancel_wakeup_output(g) : ACE_Event_Handler::WRITE_MASK;
-    }
+    if (static_cast<size_t> (n) < send_len)
+        return schedule_wakeup_output (Guard);
 
-    ACE_NOTREACHED(return -1);
+    // everything gathered was sent, packets may be left if there were more than fit in one call
+    return m_OutPackets.empty() && m_SendQueue.empty() && !m_SendOverflowing.load(std::memory_order_acquire) ? cancel_wakeup_output(Guard) : ACE_Event_Handler::WRITE_MASK;
 }
 
 int WorldSocket::handle_close(ACE_HANDLE h, ACE_Reactor_Mask)
 {
     // Critical section
     {
-        ACE_GUARD_RETURN (LockType, Guard, m_OutBufferLock, -1);
+        ACE_GUARD_RETURN (LockType, Guard, m_OutLock, -1);
 
         closing_ = true;
 
@@ -442,6 +469,13 @@ int WorldSocket::handle_close(ACE_HANDLE h, ACE_Reactor_Mask)
     return 0;
 }
 
+WorldSession* WorldSocket::TakePendingSession()
+{
+    WorldSession* session = m_PendingSession;
+    m_PendingSession = nullptr;
+    return session;
+}
+
 int WorldSocket::Update(void)
 {
     if (closing_)
@@ -450,11 +484,8 @@ int WorldSocket::Update(void)
     if (m_OutActive)
         return 0;
 
-    {
-        ACE_GUARD_RETURN (LockType, Guard, m_OutBufferLock, 0);
-        if (m_OutBuffer->length() == 0 && msg_queue()->is_empty())
-            return 0;
-    }
+    if (m_OutPackets.empty() && m_SendQueue.empty() && !m_SendOverflowing.load(std::memory_order_acquire))
+        return 0;
 
     int ret;
     do
@@ -670,6 +701,9 @@ int WorldSocket::ProcessIncoming(WorldPacket* new_pct)
     if (sPacketLog->CanLogPacket())
         sPacketLog->LogPacket(*new_pct, CLIENT_TO_SERVER);
 
+    if (m_Capture)
+        CapturePacket(*new_pct, CLIENT_TO_SERVER);
+
     try
     {
         switch (opcode)
@@ -822,6 +856,9 @@ int WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
     // id has to be fetched at this point, so that first actual account response that fails can be logged
     id = fields[0].GetUInt32();
 
+    if (m_Capture)
+        m_Capture->SetAccountId(id);
+
     ///- Re-check ip locking (same check as in realmd).
     if (fields[3].GetUInt8() == 1) // if ip is locked
     {
@@ -982,6 +1019,8 @@ int WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
     // NOTE ATM the socket is single-threaded, have this in mind ...
     ACE_NEW_RETURN(m_Session, WorldSession(id, this, AccountTypes(security), expansion, mutetime, locale, recruiter, isRecruiter, skipQueue, TotalTime), -1);
 
+    // the packets queued so far are sent without encryption
+    TakeQueuedPackets();
     m_Crypt.Init(&k);
 
     // First reject the connection if packet contains invalid data or realm state doesn't allow logging in
@@ -1019,11 +1058,12 @@ int WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
     if (wardenActive)
         m_Session->InitWarden(&k, os);
 
-    // Sleep this Network thread for
-    uint32 sleepTime = sWorld->getIntConfig(CONFIG_SESSION_ADD_DELAY);
-    std::this_thread::sleep_for(Microseconds(sleepTime));
-
-    sWorld->AddSession(m_Session);
+    // With an add delay the session is handed to the world by ReactorRunnable, paced per network thread,
+    // instead of sleeping here and stalling every other socket served by this thread
+    if (sWorld->getIntConfig(CONFIG_SESSION_ADD_DELAY))
+        m_PendingSession = m_Session;
+    else
+        sWorld->AddSession(m_Session);
 
     return 0;
 }
@@ -16,18 +16,23 @@
 #include "AuthCrypt.h"
 #include "Common.h"
 #include "Duration.h"
+#include "PacketLog.h"
 #include <ace/Message_Block.h>
 #include <ace/SOCK_Stream.h>
 #include <ace/Svc_Handler.h>
 #include <ace/Synch_Traits.h>
 #include <ace/Thread_Mutex.h>
 #include <ace/Unbounded_Queue.h>
+#include <atomic>
+#include <deque>
+#include <mutex>
 
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
 #pragma once
 #endif /* ACE_LACKS_PRAGMA_ONCE */
 
 class ACE_Message_Block;
+class PacketCapture;
 class WorldPacket;
 class WorldSession;
 
@@ -42,14 +47,17 @@ typedef ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH> WorldHandler;
  * Most methods return -1 on failure.
  * The class uses reference counting.
  *
- * For output the class uses one buffer (64K usually) and
- * a queue where it stores packet if there is no place on
- * the queue. The reason this is done, is because the server
- * does really a lot of small-size writes to it, and it doesn't
- * scale well to allocate memory for every. When something is
- * written to the output buffer the socket is not immediately
- * activated for output (again for the same reason), there
- * is 10ms celling (thats why there is Update() method).
+ * For output the class uses a lock-free queue of packets,
+ * filled by the map and world threads without taking a lock,
+ * and a locked list for packets that do not fit in it.
+ * The network thread takes the queued packets in order,
+ * encrypts their headers and writes headers and contents
+ * straight from the packets with one gathering send call,
+ * so sending costs no lock and no copy into a buffer, and a
+ * backlog of packets does not cost a syscall per packet.
+ * When something is queued the socket is not immediately
+ * activated for output, there is 10ms celling (thats why
+ * there is Update() method).
  * This concept is similar to TCP_CORK, but TCP_CORK
  * uses 200ms celling. As result overhead generated by
  * sending packets from "producer" threads is minimal,
@@ -91,11 +99,18 @@ public:
     /// Get address of connected peer.
     const std::string& GetRemoteAddress (void) const;
 
+    /// Write the recent traffic to a file when packet capture is enabled, returns the file name.
+    /// Dumps not forced are rate limited, see PacketLog::DumpCapture.
+    std::string DumpCapture(std::string const& reason, bool force = false);
+
     /// Send A packet on the socket, this function is reentrant.
     /// @param pct packet to send
     /// @return -1 of failure
     int SendPacket(const WorldPacket& pct);
 
+    /// Send a packet the caller no longer needs, it is queued without copying its contents.
+    int SendPacket(WorldPacket&& pct);
+
     /// Add reference to this object.
     long AddReference (void);
 
@@ -123,20 +138,30 @@ public:
     /// Called by WorldSocketMgr/ReactorRunnable.
     int Update (void);
 
+    /// Called by ReactorRunnable, returns the authenticated session waiting to be added to the world, if any.
+    WorldSession* TakePendingSession();
+
+    /// Send calls issued and packets written by this socket, summed up by WorldSocketMgr for network statistics.
+    uint64 GetSendCallCount() const { return m_SendCalls.load(std::memory_order_relaxed); }
+    uint64 GetSentPacketCount() const { return m_SentPackets.load(std::memory_order_relaxed); }
+
 private:
     /// Helper functions for processing incoming data.
     int handle_input_header (void);
     int handle_input_payload (void);
     int handle_input_missing_data (void);
 
+    /// Queue a packet allocated for the socket, which deletes it once it is written.
+    int QueuePacket(WorldPacket* pct);
+
+    /// Move the packets queued by the other threads to m_OutPackets and encrypt their headers, network thread only.
+    void TakeQueuedPackets();
+
     /// Help functions to mark/unmark the socket for output.
-    /// @param g the guard is for m_OutBufferLock, the function will release it
+    /// @param g the guard is for m_OutLock, the function will release it
     int cancel_wakeup_output (GuardType& g);
     int schedule_wakeup_output (GuardType& g);
 
-    /// Drain the queue if its not empty.
-    int handle_output_queue (GuardType& g);
-
     /// process one incoming packet.
     /// @param new_pct received packet, note that you need to delete it.
     int ProcessIncoming (WorldPacket* new_pct);
@@ -147,6 +172,9 @@ private:
     /// Called by ProcessIncoming() on CMSG_PING.
     int HandlePing (WorldPacket& recvPacket);
 
+    /// Add a packet to m_Capture, dump it if the opcode is a trigger.
+    void CapturePacket(WorldPacket const& packet, Direction direction);
+
 private:
     /// Time in which the last ping was received
     SystemTimePoint m_LastPingTime;
@@ -177,18 +205,47 @@ private:
     /// Fragment of the received header.
     ACE_Message_Block m_Header;
 
-    /// Mutex for protecting output related data.
-    LockType m_OutBufferLock;
+    /// Mutex for protecting the closing state and output registration.
+    LockType m_OutLock;
+
+    /// Packets sent by any thread, taken by the network thread.
+    acore::MPSCQueue<WorldPacket*> m_SendQueue;
 
-    /// Buffer used for writing output.
-    ACE_Message_Block* m_OutBuffer;
+    /// Packets that did not fit into m_SendQueue, taken after it.
+    std::deque<WorldPacket*> m_SendOverflow;
+    std::mutex m_SendOverflowLock;
+    std::atomic<bool> m_SendOverflowing;
 
-    /// Size of the m_OutBuffer.
-    size_t m_OutBufferSize;
+    /// A taken packet with its encrypted header, waiting to be written.
+    struct OutgoingPacket
+    {
+        WorldPacket* Packet;
+        uint8 Header[5];
+        uint8 HeaderSize;
+        /// Bytes of the header and the contents already written
+        size_t Written;
+    };
+
+    /// Packets taken by the network thread and not yet fully written, only touched by the network thread.
+    std::deque<OutgoingPacket> m_OutPackets;
 
     /// True if the socket is registered with the reactor for output
     bool m_OutActive;
 
+    /// Only changed by the network thread, atomic so the network statistics can read them meanwhile
+    std::atomic<uint64> m_SendCalls;
+    std::atomic<uint64> m_SentPackets;
+
+    /// Authenticated session not yet handed to the world, only touched by the network thread
+    WorldSession* m_PendingSession;
+
+    /// Recent traffic, only allocated when packet capture is enabled.
+    /// Shared with the dump thread of PacketLog while a dump is written.
+    std::shared_ptr<PacketCapture> m_Capture;
+
+    /// Max number of buffers written by one send call.
+    static constexpr int MAX_SEND_IOV = 256;
+
     uint32 m_Seed;
 };
 
@@ -17,6 +17,7 @@
 #include "WorldSocket.h"
 #include "WorldSocketAcceptor.h"
 #include "WorldSocketMgr.h"
+#include "World.h"
 #include <ace/ACE.h>
 #include <ace/Dev_Poll_Reactor.h>
 #include <ace/Log_Msg.h>
@@ -28,6 +29,8 @@
 #include <ace/Reactor.h>
 #include <ace/TP_Reactor.h>
 #include <atomic>
+#include <chrono>
+#include <deque>
 #include <set>
 
 /**
@@ -41,7 +44,10 @@ public:
     ReactorRunnable() :
         m_Reactor(0),
         m_Connections(0),
-        m_ThreadId(-1)
+        m_ThreadId(-1),
+        m_ClosedSendCalls(0),
+        m_ClosedSentPackets(0),
+        m_NextSessionAddTime(std::chrono::steady_clock::now())
     {
         ACE_Reactor_Impl* imp;
 
@@ -109,6 +115,20 @@ public:
         return m_Reactor;
     }
 
+    /// Adds the send calls and packets of the sockets of this thread, closed ones included
+    void AddSendCounts(uint64& sendCalls, uint64& sentPackets)
+    {
+        ACORE_GUARD(ACE_Thread_Mutex, m_Sockets_Lock);
+
+        sendCalls += m_ClosedSendCalls;
+        sentPackets += m_ClosedSentPackets;
+        for (WorldSocket* sock : m_Sockets)
+        {
+            sendCalls += sock->GetSendCallCount();
+            sentPackets += sock->GetSentPacketCount();
+        }
+    }
+
 protected:
     void AddNewSockets()
     {
@@ -117,14 +137,21 @@ protected:
         if (m_NewSockets.empty())
             return;
 
+        ACE_Guard<ACE_Thread_Mutex> socketsGuard(m_Sockets_Lock);
+
         for (SocketSet::const_iterator i = m_NewSockets.begin(); i != m_NewSockets.end(); ++i)
         {
             WorldSocket* sock = (*i);
 
+            if (WorldSession* session = sock->TakePendingSession())
+                m_PendingSessions.push_back(session);
+
             if (sock->IsClosed())
             {
                 sScriptMgr->OnSocketClose(sock, true);
 
+                m_ClosedSendCalls += sock->GetSendCallCount();
+                m_ClosedSentPackets += sock->GetSentPacketCount();
                 sock->RemoveReference();
                 --m_Connections;
             }
@@ -135,6 +162,25 @@ protected:
         m_NewSockets.clear();
     }
 
+    /// Hands authenticated sessions to the world, at most one per SessionAddDelay.
+    /// Pacing here rather than sleeping in WorldSocket::HandleAuthSession keeps the other
+    /// sockets of this thread served during login storms.
+    void AddPendingSessions(bool flush)
+    {
+        if (m_PendingSessions.empty())
+            return;
+
+        auto now = std::chrono::steady_clock::now();
+        Microseconds delay(sWorld->getIntConfig(CONFIG_SESSION_ADD_DELAY));
+
+        while (!m_PendingSessions.empty() && (flush || now >= m_NextSessionAddTime))
+        {
+            sWorld->AddSession(m_PendingSessions.front());
+            m_PendingSessions.pop_front();
+            m_NextSessionAddTime = now + delay;
+        }
+    }
+
     int svc() override
     {
 #if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
@@ -158,6 +204,10 @@ protected:
 
             for (i = m_Sockets.begin(); i != m_Sockets.end();)
             {
+                // the session owns a reference to the socket, so it is queued even if the socket closes meanwhile
+                if (WorldSession* session = (*i)->TakePendingSession())
+                    m_PendingSessions.push_back(session);
+
                 if ((*i)->Update() == -1)
                 {
                     t = i;
@@ -167,6 +217,10 @@ protected:
 
                     sScriptMgr->OnSocketClose((*t), false);
 
+                    // closed, no longer sends, its counts are kept with the thread
+                    ACORE_GUARD(ACE_Thread_Mutex, m_Sockets_Lock);
+                    m_ClosedSendCalls += (*t)->GetSendCallCount();
+                    m_ClosedSentPackets += (*t)->GetSentPacketCount();
                     (*t)->RemoveReference();
                     --m_Connections;
                     m_Sockets.erase (t);
@@ -174,8 +228,12 @@ protected:
                 else
                     ++i;
             }
+
+            AddPendingSessions(false);
         }
 
+        AddPendingSessions(true);
+
 #if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS)
         sLog->outStaticDebug ("Network Thread exits");
 #endif
@@ -191,18 +249,26 @@ private:
     AtomicInt m_Connections;
     int m_ThreadId;
 
+    /// Only changed by the network thread, under m_Sockets_Lock so AddSendCounts can read it
     SocketSet m_Sockets;
+    ACE_Thread_Mutex m_Sockets_Lock;
+    uint64 m_ClosedSendCalls;
+    uint64 m_ClosedSentPackets;
 
     SocketSet m_NewSockets;
     ACE_Thread_Mutex m_NewSockets_Lock;
+
+    std::deque<WorldSession*> m_PendingSessions;
+    std::chrono::steady_clock::time_point m_NextSessionAddTime;
 };
 
 WorldSocketMgr::WorldSocketMgr() :
     m_NetThreads(0),
     m_NetThreadsCount(0),
     m_SockOutKBuff(-1),
-    m_SockOutUBuff(65536),
     m_UseNoDelay(true),
+    m_RecvQueueSize(256),
+    m_SendQueueSize(1024),
     m_Acceptor (0)
 {
 }
@@ -213,6 +279,14 @@ WorldSocketMgr::~WorldSocketMgr()
     delete m_Acceptor;
 }
 
+void WorldSocketMgr::GetSendCounts(uint64& sendCalls, uint64& sentPackets) const
+{
+    sendCalls = 0;
+    sentPackets = 0;
+    for (size_t i = 0; i < m_NetThreadsCount; ++i)
+        m_NetThreads[i].AddSendCounts(sendCalls, sentPackets);
+}
+
 WorldSocketMgr* WorldSocketMgr::instance()
 {
     static WorldSocketMgr instance;
@@ -241,14 +315,29 @@ WorldSocketMgr::StartReactiveIO (uint16 port, const char* address)
     // -1 means use default
     m_SockOutKBuff = sConfigMgr->GetOption<int32> ("Network.OutKBuff", -1);
 
-    m_SockOutUBuff = sConfigMgr->GetOption<int32> ("Network.OutUBuff", 65536);
+    int32 recvQueueSize = sConfigMgr->GetOption<int32> ("Network.RecvQueueSize", 256);
+    if (recvQueueSize < 16 || recvQueueSize > 65536)
+    {
+        sLog->outError("Network.RecvQueueSize (%i) must be in range 16..65536. Set to 256.", recvQueueSize);
+        recvQueueSize = 256;
+    }
+
+    // the queue needs a power of two
+    m_RecvQueueSize = 16;
+    while (m_RecvQueueSize < uint32(recvQueueSize))
+        m_RecvQueueSize <<= 1;
 
-    if (m_SockOutUBuff <= 0)
+    int32 sendQueueSize = sConfigMgr->GetOption<int32> ("Network.SendQueueSize", 1024);
+    if (sendQueueSize < 16 || sendQueueSize > 65536)
     {
-        sLog->outError("Network.OutUBuff is wrong in your config file");
-        return -1;
+        sLog->outError("Network.SendQueueSize (%i) must be in range 16..65536. Set to 1024.", sendQueueSize);
+        sendQueueSize = 1024;
     }
 
+    m_SendQueueSize = 16;
+    while (m_SendQueueSize < uint32(sendQueueSize))
+        m_SendQueueSize <<= 1;
+
     m_Acceptor = new WorldSocketAcceptor;
 
     ACE_INET_Addr listen_addr (port, address);
@@ -339,8 +428,6 @@ WorldSocketMgr::OnSocketOpen (WorldSocket* sock)
         }
     }
 
-    sock->m_OutBufferSize = static_cast<size_t> (m_SockOutUBuff);
-
     // we skip the Acceptor Thread
     size_t min = 1;
 
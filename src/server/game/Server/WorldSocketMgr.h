@@ -37,6 +37,16 @@ public:
     /// Wait untill all network threads have "joined" .
     void Wait();
 
+    /// Number of send calls issued and packets written by all world sockets, for network statistics.
+    /// Sums up the counts of the sockets, the ones just accepted are counted once their network thread takes them.
+    void GetSendCounts(uint64& sendCalls, uint64& sentPackets) const;
+
+    /// Number of received packets a session keeps in its lock-free queue, see WorldSession::QueuePacket.
+    uint32 GetRecvQueueSize() const { return m_RecvQueueSize; }
+
+    /// Number of packets a socket keeps in its lock-free send queue, see WorldSocket::QueuePacket.
+    uint32 GetSendQueueSize() const { return m_SendQueueSize; }
+
 private:
     int OnSocketOpen(WorldSocket* sock);
 
@@ -50,8 +60,9 @@ private:
     size_t m_NetThreadsCount;
 
     int m_SockOutKBuff;
-    int m_SockOutUBuff;
     bool m_UseNoDelay;
+    uint32 m_RecvQueueSize;
+    uint32 m_SendQueueSize;
 
     class WorldSocketAcceptor* m_Acceptor;
 };
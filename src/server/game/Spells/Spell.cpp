@@ -1181,8 +1181,11 @@ void Spell::SelectImplicitConeTargets(SpellEffIndex effIndex, SpellImplicitTarge
     if (uint32 containerTypeMask = GetSearcherTypeMask(objectType, condList))
     {
         acore::WorldObjectSpellConeTargetCheck check(coneAngle, radius, m_caster, m_spellInfo, selectionType, condList);
+        // cones behind the caster and lines are tested on the whole circle
+        float indexConeAngle = m_spellInfo->HasAttribute(SPELL_ATTR0_CU_CONE_BACK) || m_spellInfo->HasAttribute(SPELL_ATTR0_CU_CONE_LINE) ? 0.0f : coneAngle;
         acore::WorldObjectListSearcher<acore::WorldObjectSpellConeTargetCheck> searcher(m_caster, targets, check, containerTypeMask);
-        SearchTargets<acore::WorldObjectListSearcher<acore::WorldObjectSpellConeTargetCheck> >(searcher, containerTypeMask, m_caster, m_caster, radius);
+        if (!SearchIndexedTargets(searcher, containerTypeMask, m_caster, m_caster, radius, indexConeAngle))
+            SearchTargets<acore::WorldObjectListSearcher<acore::WorldObjectSpellConeTargetCheck> >(searcher, containerTypeMask, m_caster, m_caster, radius);
 
         CallScriptObjectAreaTargetSelectHandlers(targets, effIndex, targetType);
 
@@ -1910,6 +1913,26 @@ void Spell::SearchTargets(SEARCHER& searcher, uint32 containerMask, Unit* refere
     }
 }
 
+// Players and creatures only, from the unit index of the map instead of the grid cells. False if the map has no index
+// or other objects are searched too, then SearchTargets() has to do it. The searcher applies the same type and phase
+// tests to each unit as to the grid cells.
+template<class SEARCHER>
+bool Spell::SearchIndexedTargets(SEARCHER& searcher, uint32 containerMask, Unit* referer, Position const* pos, float radius, float coneAngle)
+{
+    SpatialHash<Unit>* index = referer->GetMap()->GetUnitIndex();
+    if (!index || !containerMask || (containerMask & ~(GRID_MAP_TYPE_MASK_CREATURE | GRID_MAP_TYPE_MASK_PLAYER)))
+        return false;
+
+    auto visitor = [&searcher](Unit* unit) { searcher.Visit(unit); };
+
+    if (coneAngle > 0.0f)
+        index->VisitInCone(pos->GetPositionX(), pos->GetPositionY(), radius, pos->GetOrientation(), coneAngle, visitor);
+    else
+        index->VisitInCircle(pos->GetPositionX(), pos->GetPositionY(), radius, visitor);
+
+    return true;
+}
+
 WorldObject* Spell::SearchNearbyTarget(float range, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectionType, ConditionList* condList)
 {
     WorldObject* target = nullptr;
@@ -1929,6 +1952,9 @@ void Spell::SearchAreaTargets(std::list<WorldObject*>& targets, float range, Pos
         return;
     acore::WorldObjectSpellAreaTargetCheck check(range, position, m_caster, referer, m_spellInfo, selectionType, condList);
     acore::WorldObjectListSearcher<acore::WorldObjectSpellAreaTargetCheck> searcher(m_caster, targets, check, containerTypeMask);
+    if (SearchIndexedTargets(searcher, containerTypeMask, m_caster, position, range))
+        return;
+
     SearchTargets<acore::WorldObjectListSearcher<acore::WorldObjectSpellAreaTargetCheck> > (searcher, containerTypeMask, m_caster, position, range);
 }
 
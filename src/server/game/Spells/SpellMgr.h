@@ -649,6 +649,10 @@ public:
     // Spell proc event table
     [[nodiscard]] SpellProcEventEntry const* GetSpellProcEvent(uint32 spellId) const;
     bool IsSpellProcEventCanTriggeredBy(SpellInfo const* spellProto, SpellProcEventEntry const* spellProcEvent, uint32 EventProcFlag, SpellInfo const* procSpell, uint32 procFlags, uint32 procExtra, bool active) const;
+    /// Proc flags an aura of the spell can trigger on in Unit::ProcDamageAndSpellFor, 0 if it never does there
+    [[nodiscard]] uint32 GetAuraProcFlags(SpellInfo const* spellInfo) const;
+    /// Changes when the proc tables are reloaded
+    [[nodiscard]] uint32 GetProcDataVersion() const { return mProcDataVersion; }
 
     // Spell proc table
     [[nodiscard]] SpellProcEntry const* GetSpellProcEntry(uint32 spellId) const;
@@ -734,6 +738,7 @@ private:
     SpellGroupStackMap         mSpellGroupStackMap;
     SpellProcEventMap          mSpellProcEventMap;
     SpellProcMap               mSpellProcMap;
+    uint32                     mProcDataVersion;
     SpellBonusMap              mSpellBonusMap;
     SpellThreatMap             mSpellThreatMap;
     SpellMixologyMap           mSpellMixologyMap;
@@ -164,6 +164,12 @@ enum WorldBoolConfigs
     CONFIG_DEBUG_BATTLEGROUND,
     CONFIG_DEBUG_ARENA,
     CONFIG_REGEN_HP_CANNOT_REACH_TARGET_IN_RAID,
+    CONFIG_MAP_UPDATE_PARALLEL_SESSIONS,
+    CONFIG_MAP_FILES_MEMORY_MAPPED,
+    CONFIG_GRID_PREFETCH,
+    CONFIG_SPATIAL_INDEX,
+    CONFIG_VISIBILITY_ADAPTIVE,
+    CONFIG_STARTUP_SNAPSHOT,
     BOOL_CONFIG_VALUE_COUNT
 };
 
@@ -188,6 +194,9 @@ enum WorldFloatConfigs
 enum WorldIntConfigs
 {
     CONFIG_COMPRESSION = 0,
+    CONFIG_COMPRESSION_THRESHOLD,
+    CONFIG_COMPRESSION_THREADS,
+    CONFIG_COMPRESSION_OFFLOAD_THRESHOLD,
     CONFIG_INTERVAL_MAPUPDATE,
     CONFIG_INTERVAL_CHANGEWEATHER,
     CONFIG_INTERVAL_DISCONNECT_TOLERANCE,
@@ -303,6 +312,15 @@ enum WorldIntConfigs
     CONFIG_ENABLE_SINFO_LOGIN,
     CONFIG_PLAYER_ALLOW_COMMANDS,
     CONFIG_NUMTHREADS,
+    CONFIG_GRID_PREFETCH_LOOKAHEAD,
+    CONFIG_SPATIAL_INDEX_CELL_SIZE,
+    CONFIG_VISIBILITY_ADAPTIVE_TARGET_COST,
+    CONFIG_VISIBILITY_ADAPTIVE_MOVERS,
+    CONFIG_VISIBILITY_ADAPTIVE_MIN_LEVEL,
+    CONFIG_VISIBILITY_ADAPTIVE_MAX_LEVEL,
+    CONFIG_STARTUP_LOADER_THREADS,
+    CONFIG_MMAPS_ASYNC_THREADS,
+    CONFIG_MMAPS_PATH_CACHE_TIME,
     CONFIG_LOGDB_CLEARINTERVAL,
     CONFIG_LOGDB_CLEARTIME,
     CONFIG_TELEPORT_TIMEOUT_NEAR, // pussywizard
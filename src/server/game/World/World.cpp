@@ -62,6 +62,7 @@
 #include "SmartAI.h"
 #include "SpellMgr.h"
 #include "TemporarySummon.h"
+#include "Threading/TaskGraph.h"
 #include "TicketMgr.h"
 #include "Transport.h"
 #include "TransportMgr.h"
@@ -76,6 +77,7 @@
 #include "World.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
+#include "WorldSocketMgr.h"
 #include <VMapManager2.h>
 
 #ifdef ELUNA
@@ -118,6 +120,11 @@ World::World()
     mail_expire_check_timer = 0;
     m_updateTime = 0;
     m_updateTimeSum = 0;
+    m_lastSendCallCount = 0;
+    m_lastSentPacketCount = 0;
+    m_lastSavedPlayerCount = 0;
+    m_lastSavedStatementCount = 0;
+    m_lastCompressionStats = UpdateCompressionStats();
 
     m_isClosed = false;
 
@@ -637,6 +644,34 @@ void World::LoadConfigSettings(bool reload)
         sLog->outError("Compression level (%i) must be in range 1..9. Using default compression level (1).", m_int_configs[CONFIG_COMPRESSION]);
         m_int_configs[CONFIG_COMPRESSION] = 1;
     }
+    m_int_configs[CONFIG_COMPRESSION_THRESHOLD] = sConfigMgr->GetOption<int32>("Compression.Threshold", 100);
+    if (int32(m_int_configs[CONFIG_COMPRESSION_THRESHOLD]) < 0)
+    {
+        sLog->outError("Compression.Threshold (%i) can't be negative. Set to 100.", m_int_configs[CONFIG_COMPRESSION_THRESHOLD]);
+        m_int_configs[CONFIG_COMPRESSION_THRESHOLD] = 100;
+    }
+    if (reload)
+    {
+        // the compression threads are started once, at startup
+        uint32 val = sConfigMgr->GetOption<int32>("Compression.Threads", 0);
+        if (val != m_int_configs[CONFIG_COMPRESSION_THREADS])
+            sLog->outError("Compression.Threads option can't be changed at worldserver.conf reload, using current value (%u).", m_int_configs[CONFIG_COMPRESSION_THREADS]);
+    }
+    else
+    {
+        m_int_configs[CONFIG_COMPRESSION_THREADS] = sConfigMgr->GetOption<int32>("Compression.Threads", 0);
+        if (m_int_configs[CONFIG_COMPRESSION_THREADS] > 32)
+        {
+            sLog->outError("Compression.Threads (%i) must be in range 0..32. Set to 0.", m_int_configs[CONFIG_COMPRESSION_THREADS]);
+            m_int_configs[CONFIG_COMPRESSION_THREADS] = 0;
+        }
+    }
+    m_int_configs[CONFIG_COMPRESSION_OFFLOAD_THRESHOLD] = sConfigMgr->GetOption<int32>("Compression.OffloadThreshold", 16384);
+    if (int32(m_int_configs[CONFIG_COMPRESSION_OFFLOAD_THRESHOLD]) < 0)
+    {
+        sLog->outError("Compression.OffloadThreshold (%i) can't be negative. Set to 16384.", m_int_configs[CONFIG_COMPRESSION_OFFLOAD_THRESHOLD]);
+        m_int_configs[CONFIG_COMPRESSION_OFFLOAD_THRESHOLD] = 16384;
+    }
     m_bool_configs[CONFIG_ADDON_CHANNEL]                   = sConfigMgr->GetOption<bool>("AddonChannel", true);
     m_bool_configs[CONFIG_CLEAN_CHARACTER_DB]              = sConfigMgr->GetOption<bool>("CleanCharacterDB", false);
     m_int_configs[CONFIG_PERSISTENT_CHARACTER_CLEAN_FLAGS] = sConfigMgr->GetOption<int32>("PersistentCharacterCleanFlags", 0);
@@ -1229,6 +1264,22 @@ void World::LoadConfigSettings(bool reload)
         m_MaxVisibleDistanceInBGArenas = MAX_VISIBILITY_DISTANCE;
     }
 
+    m_bool_configs[CONFIG_VISIBILITY_ADAPTIVE]            = sConfigMgr->GetOption<bool>("Visibility.Adaptive", false);
+    m_int_configs[CONFIG_VISIBILITY_ADAPTIVE_TARGET_COST] = sConfigMgr->GetOption<int32>("Visibility.Adaptive.TargetCost", 20000);
+    m_int_configs[CONFIG_VISIBILITY_ADAPTIVE_MOVERS]      = sConfigMgr->GetOption<int32>("Visibility.Adaptive.Movers", 150);
+    m_int_configs[CONFIG_VISIBILITY_ADAPTIVE_MIN_LEVEL]   = sConfigMgr->GetOption<int32>("Visibility.Adaptive.MinLevel", 0);
+    m_int_configs[CONFIG_VISIBILITY_ADAPTIVE_MAX_LEVEL]   = sConfigMgr->GetOption<int32>("Visibility.Adaptive.MaxLevel", VISIBILITY_SETTINGS_MAX_INTERVAL_NUM - 1);
+    if (m_int_configs[CONFIG_VISIBILITY_ADAPTIVE_MAX_LEVEL] > VISIBILITY_SETTINGS_MAX_INTERVAL_NUM - 1)
+    {
+        sLog->outError("Visibility.Adaptive.MaxLevel (%i) must be in range 0..%u. Set to %u.", m_int_configs[CONFIG_VISIBILITY_ADAPTIVE_MAX_LEVEL], VISIBILITY_SETTINGS_MAX_INTERVAL_NUM - 1, VISIBILITY_SETTINGS_MAX_INTERVAL_NUM - 1);
+        m_int_configs[CONFIG_VISIBILITY_ADAPTIVE_MAX_LEVEL] = VISIBILITY_SETTINGS_MAX_INTERVAL_NUM - 1;
+    }
+    if (m_int_configs[CONFIG_VISIBILITY_ADAPTIVE_MIN_LEVEL] > m_int_configs[CONFIG_VISIBILITY_ADAPTIVE_MAX_LEVEL])
+    {
+        sLog->outError("Visibility.Adaptive.MinLevel (%i) must be in range 0..%u. Set to 0.", m_int_configs[CONFIG_VISIBILITY_ADAPTIVE_MIN_LEVEL], m_int_configs[CONFIG_VISIBILITY_ADAPTIVE_MAX_LEVEL]);
+        m_int_configs[CONFIG_VISIBILITY_ADAPTIVE_MIN_LEVEL] = 0;
+    }
+
     ///- Load the CharDelete related config options
     m_int_configs[CONFIG_CHARDELETE_METHOD]    = sConfigMgr->GetOption<int32>("CharDelete.Method", 0);
     m_int_configs[CONFIG_CHARDELETE_MIN_LEVEL] = sConfigMgr->GetOption<int32>("CharDelete.MinLevel", 0);
@@ -1265,6 +1316,7 @@ void World::LoadConfigSettings(bool reload)
         sLog->outString("Using DataDir %s", m_dataPath.c_str());
     }
 
+    m_bool_configs[CONFIG_MAP_FILES_MEMORY_MAPPED] = sConfigMgr->GetOption<bool>("MapFiles.MemoryMapped", false);
     m_bool_configs[CONFIG_VMAP_INDOOR_CHECK] = sConfigMgr->GetOption<bool>("vmap.enableIndoorCheck", 0);
     bool enableIndoor = sConfigMgr->GetOption<bool>("vmap.enableIndoorCheck", true);
     bool enableLOS = sConfigMgr->GetOption<bool>("vmap.enableLOS", true);
@@ -1299,6 +1351,21 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_INTERVAL_LOG_UPDATE]         = sConfigMgr->GetOption<int32>("RecordUpdateTimeDiffInterval", 300000);
     m_int_configs[CONFIG_MIN_LOG_UPDATE]              = sConfigMgr->GetOption<int32>("MinRecordUpdateTimeDiff", 100);
     m_int_configs[CONFIG_NUMTHREADS]                  = sConfigMgr->GetOption<int32>("MapUpdate.Threads", 1);
+    m_bool_configs[CONFIG_MAP_UPDATE_PARALLEL_SESSIONS] = sConfigMgr->GetOption<bool>("MapUpdate.ParallelSessions", false);
+    m_bool_configs[CONFIG_GRID_PREFETCH]              = sConfigMgr->GetOption<bool>("MapUpdate.GridPrefetch", false);
+    m_int_configs[CONFIG_GRID_PREFETCH_LOOKAHEAD]     = sConfigMgr->GetOption<int32>("MapUpdate.GridPrefetch.LookAhead", 10);
+    m_bool_configs[CONFIG_SPATIAL_INDEX]              = sConfigMgr->GetOption<bool>("MapUpdate.SpatialIndex", false);
+    m_int_configs[CONFIG_SPATIAL_INDEX_CELL_SIZE]     = sConfigMgr->GetOption<int32>("MapUpdate.SpatialIndex.CellSize", 8);
+    if (m_int_configs[CONFIG_SPATIAL_INDEX_CELL_SIZE] < 2 || m_int_configs[CONFIG_SPATIAL_INDEX_CELL_SIZE] > 66)
+    {
+        sLog->outError("MapUpdate.SpatialIndex.CellSize (%i) must be in range 2..66. Set to 8.", m_int_configs[CONFIG_SPATIAL_INDEX_CELL_SIZE]);
+        m_int_configs[CONFIG_SPATIAL_INDEX_CELL_SIZE] = 8;
+    }
+    int32 loaderThreads = sConfigMgr->GetOption<int32>("StartupLoader.Threads", 0);
+    m_int_configs[CONFIG_STARTUP_LOADER_THREADS]      = ClampStartupLoaderThreads(loaderThreads);
+    if (int32(m_int_configs[CONFIG_STARTUP_LOADER_THREADS]) != loaderThreads)
+        sLog->outError("StartupLoader.Threads (%i) must be in range 0..%u. Set to %u.", loaderThreads, MAX_STARTUP_LOADER_THREADS, m_int_configs[CONFIG_STARTUP_LOADER_THREADS]);
+    m_bool_configs[CONFIG_STARTUP_SNAPSHOT]           = sConfigMgr->GetOption<bool>("StartupSnapshot.Enable", false);
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = sConfigMgr->GetOption<int32>("Command.LookupMaxResults", 0);
 
     // chat logging
@@ -1345,6 +1412,13 @@ void World::LoadConfigSettings(bool reload)
     m_bool_configs[CONFIG_PDUMP_NO_PATHS]     = sConfigMgr->GetOption<bool>("PlayerDump.DisallowPaths", true);
     m_bool_configs[CONFIG_PDUMP_NO_OVERWRITE] = sConfigMgr->GetOption<bool>("PlayerDump.DisallowOverwrite", true);
     m_bool_configs[CONFIG_ENABLE_MMAPS]       = sConfigMgr->GetOption<bool>("MoveMaps.Enable", true);
+    m_int_configs[CONFIG_MMAPS_ASYNC_THREADS] = sConfigMgr->GetOption<int32>("MoveMaps.AsyncThreads", 0);
+    m_int_configs[CONFIG_MMAPS_PATH_CACHE_TIME] = sConfigMgr->GetOption<int32>("MoveMaps.PathCacheTime", 2000);
+    if (int32(m_int_configs[CONFIG_MMAPS_PATH_CACHE_TIME]) < 100 || m_int_configs[CONFIG_MMAPS_PATH_CACHE_TIME] > 60000)
+    {
+        sLog->outError("MoveMaps.PathCacheTime (%i) must be in range 100..60000. Set to 2000.", m_int_configs[CONFIG_MMAPS_PATH_CACHE_TIME]);
+        m_int_configs[CONFIG_MMAPS_PATH_CACHE_TIME] = 2000;
+    }
     MMAP::MMapFactory::InitializeDisabledMaps();
 
     // Wintergrasp
@@ -1420,6 +1494,43 @@ void World::LoadConfigSettings(bool reload)
 extern void LoadGameObjectModelList();
 
 /// Initialize the World
+void World::RunStartupTasks(acore::TaskGraph& tasks, char const* stage)
+{
+    uint32 threads = getIntConfig(CONFIG_STARTUP_LOADER_THREADS);
+    tasks.Run(threads);
+
+    uint32 taskTime = 0;
+    std::vector<acore::TaskGraph::TaskId> byTime;
+    for (acore::TaskGraph::TaskId id = 0; id < tasks.GetTaskCount(); ++id)
+    {
+        taskTime += tasks.GetTime(id);
+        byTime.push_back(id);
+    }
+
+    std::stable_sort(byTime.begin(), byTime.end(), [&tasks](acore::TaskGraph::TaskId left, acore::TaskGraph::TaskId right)
+    {
+        return tasks.GetTime(left) > tasks.GetTime(right);
+    });
+
+    std::vector<acore::TaskGraph::TaskId> criticalPath = tasks.GetCriticalPath();
+    uint32 criticalTime = 0;
+    std::string criticalNames;
+    for (acore::TaskGraph::TaskId id : criticalPath)
+    {
+        criticalTime += tasks.GetTime(id);
+        if (!criticalNames.empty())
+            criticalNames += " -> ";
+        criticalNames += tasks.GetName(id);
+    }
+
+    sLog->outString();
+    sLog->outString(">> %s: %u loaders took %u ms on %u threads, %u ms in total", stage, tasks.GetTaskCount(), tasks.GetWallTime(), std::max(threads, 1u), taskTime);
+    for (acore::TaskGraph::TaskId id : byTime)
+        sLog->outString("   %6u ms  %s", tasks.GetTime(id), tasks.GetName(id).c_str());
+    sLog->outString(">> Critical path %u ms: %s", criticalTime, criticalNames.c_str());
+    sLog->outString();
+}
+
 void World::SetInitialWorldSettings()
 {
     ///- Server startup begin
@@ -1446,6 +1557,10 @@ void World::SetInitialWorldSettings()
     ///- Initialize Allowed Security Level
     LoadDBAllowedSecurityLevel();
 
+    ///- Read the results of the world queries below from the snapshot of the last startup when the tables did not change
+    if (getBoolConfig(CONFIG_STARTUP_SNAPSHOT))
+        WorldDatabase.StartSnapshot(m_dataPath + sConfigMgr->GetOption<std::string>("StartupSnapshot.File", "world.snapshot"));
+
     ///- Init highest guids before any table loading to prevent using not initialized guids in some code.
     sObjectMgr->SetHighestGuids();
 
@@ -1547,68 +1662,98 @@ void World::SetInitialWorldSettings()
     sObjectMgr->LoadBroadcastTexts();
     sObjectMgr->LoadBroadcastTextLocales();
 
-    sLog->outString("Loading Localization strings...");
-    uint32 oldMSTime = getMSTime();
-    sObjectMgr->LoadCreatureLocales();
-    sObjectMgr->LoadGameObjectLocales();
-    sObjectMgr->LoadItemLocales();
-    sObjectMgr->LoadItemSetNameLocales();
-    sObjectMgr->LoadQuestLocales();
-    sObjectMgr->LoadQuestOfferRewardLocale();
-    sObjectMgr->LoadQuestRequestItemsLocale();
-    sObjectMgr->LoadNpcTextLocales();
-    sObjectMgr->LoadPageTextLocales();
-    sObjectMgr->LoadGossipMenuItemsLocales();
-    sObjectMgr->LoadPointOfInterestLocales();
-
-    sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
-    sLog->outString(">> Localization strings loaded in %u ms", GetMSTimeDiffToNow(oldMSTime));
-    sLog->outString();
+    ///- Loaders without dependencies between them run in parallel with StartupLoader.Threads
+    acore::TaskGraph dataTasks;
+
+    dataTasks.Add("Localization strings", []()
+    {
+        sLog->outString("Loading Localization strings...");
+        uint32 oldMSTime = getMSTime();
+        sObjectMgr->LoadCreatureLocales();
+        sObjectMgr->LoadGameObjectLocales();
+        sObjectMgr->LoadItemLocales();
+        sObjectMgr->LoadItemSetNameLocales();
+        sObjectMgr->LoadQuestLocales();
+        sObjectMgr->LoadQuestOfferRewardLocale();
+        sObjectMgr->LoadQuestRequestItemsLocale();
+        sObjectMgr->LoadNpcTextLocales();
+        sObjectMgr->LoadPageTextLocales();
+        sObjectMgr->LoadGossipMenuItemsLocales();
+        sObjectMgr->LoadPointOfInterestLocales();
+
+        sObjectMgr->SetDBCLocaleIndex(sWorld->GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
+        sLog->outString(">> Localization strings loaded in %u ms", GetMSTimeDiffToNow(oldMSTime));
+        sLog->outString();
+    });
 
-    sLog->outString("Loading Page Texts...");
-    sObjectMgr->LoadPageTexts();
+    acore::TaskGraph::TaskId pageTexts = dataTasks.Add("Page Texts", []()
+    {
+        sLog->outString("Loading Page Texts...");
+        sObjectMgr->LoadPageTexts();
+    });
 
-    sLog->outString("Loading Game Object Templates...");         // must be after LoadPageTexts
-    sObjectMgr->LoadGameObjectTemplate();
+    acore::TaskGraph::TaskId gameObjectTemplates = dataTasks.Add("Game Object Templates", []()
+    {
+        sLog->outString("Loading Game Object Templates...");
+        sObjectMgr->LoadGameObjectTemplate();
+    }, { pageTexts });
 
-    sLog->outString("Loading Game Object template addons...");
-    sObjectMgr->LoadGameObjectTemplateAddons();
+    dataTasks.Add("Game Object template addons", []()
+    {
+        sLog->outString("Loading Game Object template addons...");
+        sObjectMgr->LoadGameObjectTemplateAddons();
+    }, { gameObjectTemplates });
+
+    dataTasks.Add("Transport templates", []()
+    {
+        sLog->outString("Loading Transport templates...");
+        sTransportMgr->LoadTransportTemplates();
+    }, { gameObjectTemplates });
 
-    sLog->outString("Loading Transport templates...");
-    sTransportMgr->LoadTransportTemplates();
+    acore::TaskGraph::TaskId spellTables = dataTasks.Add("Spell tables", []()
+    {
+        sLog->outString("Loading Spell Required Data...");
+        sSpellMgr->LoadSpellRequired();
 
-    sLog->outString("Loading Spell Required Data...");
-    sSpellMgr->LoadSpellRequired();
+        sLog->outString("Loading Spell Group types...");
+        sSpellMgr->LoadSpellGroups();
 
-    sLog->outString("Loading Spell Group types...");
-    sSpellMgr->LoadSpellGroups();
+        sLog->outString("Loading Spell Learn Skills...");
+        sSpellMgr->LoadSpellLearnSkills();                           // must be after LoadSpellRanks
 
-    sLog->outString("Loading Spell Learn Skills...");
-    sSpellMgr->LoadSpellLearnSkills();                           // must be after LoadSpellRanks
+        sLog->outString("Loading Spell Proc Event conditions...");
+        sSpellMgr->LoadSpellProcEvents();
 
-    sLog->outString("Loading Spell Proc Event conditions...");
-    sSpellMgr->LoadSpellProcEvents();
+        sLog->outString("Loading Spell Proc conditions and data...");
+        sSpellMgr->LoadSpellProcs();
+    });
 
-    sLog->outString("Loading Spell Proc conditions and data...");
-    sSpellMgr->LoadSpellProcs();
+    // the stack rules need the spell groups
+    dataTasks.Add("Spell bonus tables", []()
+    {
+        sLog->outString("Loading Spell Bonus Data...");
+        sSpellMgr->LoadSpellBonusess();
 
-    sLog->outString("Loading Spell Bonus Data...");
-    sSpellMgr->LoadSpellBonusess();
+        sLog->outString("Loading Aggro Spells Definitions...");
+        sSpellMgr->LoadSpellThreats();
 
-    sLog->outString("Loading Aggro Spells Definitions...");
-    sSpellMgr->LoadSpellThreats();
+        sLog->outString("Loading Mixology bonuses...");
+        sSpellMgr->LoadSpellMixology();
 
-    sLog->outString("Loading Mixology bonuses...");
-    sSpellMgr->LoadSpellMixology();
+        sLog->outString("Loading Spell Group Stack Rules...");
+        sSpellMgr->LoadSpellGroupStackRules();
 
-    sLog->outString("Loading Spell Group Stack Rules...");
-    sSpellMgr->LoadSpellGroupStackRules();
+        sLog->outString("Loading Enchant Spells Proc datas...");
+        sSpellMgr->LoadSpellEnchantProcData();
+    }, { spellTables });
 
-    sLog->outString("Loading NPC Texts...");
-    sObjectMgr->LoadGossipText();
+    dataTasks.Add("NPC Texts", []()
+    {
+        sLog->outString("Loading NPC Texts...");
+        sObjectMgr->LoadGossipText();
+    });
 
-    sLog->outString("Loading Enchant Spells Proc datas...");
-    sSpellMgr->LoadSpellEnchantProcData();
+    RunStartupTasks(dataTasks, "Page, game object, spell and text data");
 
     sLog->outString("Loading Item Random Enchantments Table...");
     LoadRandomEnchantmentsTable();
@@ -1755,103 +1900,189 @@ void World::SetInitialWorldSettings()
     sLog->outString("Loading linked spells...");
     sSpellMgr->LoadSpellLinked();
 
-    sLog->outString("Loading Player Create Data...");
-    sObjectMgr->LoadPlayerInfo();
+    ///- Every loader here reads templates, spells and quests loaded above, and fills its own store
+    acore::TaskGraph worldTasks;
 
-    sLog->outString("Loading Exploration BaseXP Data...");
-    sObjectMgr->LoadExplorationBaseXP();
+    worldTasks.Add("Player Create Data", []()
+    {
+        sLog->outString("Loading Player Create Data...");
+        sObjectMgr->LoadPlayerInfo();
+    });
 
-    sLog->outString("Loading Pet Name Parts...");
-    sObjectMgr->LoadPetNames();
+    worldTasks.Add("Exploration BaseXP Data", []()
+    {
+        sLog->outString("Loading Exploration BaseXP Data...");
+        sObjectMgr->LoadExplorationBaseXP();
+    });
 
-    CharacterDatabaseCleaner::CleanDatabase();
+    worldTasks.Add("Pet Name Parts", []()
+    {
+        sLog->outString("Loading Pet Name Parts...");
+        sObjectMgr->LoadPetNames();
+    });
 
-    sLog->outString("Loading the max pet number...");
-    sObjectMgr->LoadPetNumber();
+    acore::TaskGraph::TaskId cleanDatabase = worldTasks.Add("Character database cleanup", []()
+    {
+        CharacterDatabaseCleaner::CleanDatabase();
+    });
 
-    sLog->outString("Loading pet level stats...");
-    sObjectMgr->LoadPetLevelInfo();
+    worldTasks.Add("Pet number and level stats", []()
+    {
+        sLog->outString("Loading the max pet number...");
+        sObjectMgr->LoadPetNumber();
 
-    sLog->outString("Loading Player Corpses...");
-    sObjectMgr->LoadCorpses();
+        sLog->outString("Loading pet level stats...");
+        sObjectMgr->LoadPetLevelInfo();
+    });
 
-    sLog->outString("Loading Player level dependent mail rewards...");
-    sObjectMgr->LoadMailLevelRewards();
+    worldTasks.Add("Player Corpses", []()
+    {
+        sLog->outString("Loading Player Corpses...");
+        sObjectMgr->LoadCorpses();
+    });
 
-    // Loot tables
-    LoadLootTables();
+    worldTasks.Add("Player level dependent mail rewards", []()
+    {
+        sLog->outString("Loading Player level dependent mail rewards...");
+        sObjectMgr->LoadMailLevelRewards();
+    });
 
-    sLog->outString("Loading Skill Discovery Table...");
-    LoadSkillDiscoveryTable();
+    // Loot tables, each store on its own, the references are checked against all of them
+    acore::TaskGraph::TaskId creatureLoot = worldTasks.Add("Creature loot", &LoadLootTemplates_Creature);
+    acore::TaskGraph::TaskId fishingLoot = worldTasks.Add("Fishing loot", &LoadLootTemplates_Fishing);
+    acore::TaskGraph::TaskId gameobjectLoot = worldTasks.Add("Gameobject loot", &LoadLootTemplates_Gameobject);
+    acore::TaskGraph::TaskId itemLoot = worldTasks.Add("Item loot", &LoadLootTemplates_Item);
+    acore::TaskGraph::TaskId mailLoot = worldTasks.Add("Mail loot", &LoadLootTemplates_Mail);
+    acore::TaskGraph::TaskId millingLoot = worldTasks.Add("Milling loot", &LoadLootTemplates_Milling);
+    acore::TaskGraph::TaskId pickpocketingLoot = worldTasks.Add("Pickpocketing loot", &LoadLootTemplates_Pickpocketing);
+    acore::TaskGraph::TaskId skinningLoot = worldTasks.Add("Skinning loot", &LoadLootTemplates_Skinning);
+    acore::TaskGraph::TaskId disenchantLoot = worldTasks.Add("Disenchant loot", &LoadLootTemplates_Disenchant);
+    acore::TaskGraph::TaskId prospectingLoot = worldTasks.Add("Prospecting loot", &LoadLootTemplates_Prospecting);
+    acore::TaskGraph::TaskId spellLoot = worldTasks.Add("Spell loot", &LoadLootTemplates_Spell);
+    worldTasks.Add("Reference loot", &LoadLootTemplates_Reference, { creatureLoot, fishingLoot, gameobjectLoot, itemLoot, mailLoot, millingLoot,
+        pickpocketingLoot, skinningLoot, disenchantLoot, prospectingLoot, spellLoot });
 
-    sLog->outString("Loading Skill Extra Item Table...");
-    LoadSkillExtraItemTable();
+    worldTasks.Add("Skill tables", []()
+    {
+        sLog->outString("Loading Skill Discovery Table...");
+        LoadSkillDiscoveryTable();
+
+        sLog->outString("Loading Skill Extra Item Table...");
+        LoadSkillExtraItemTable();
 
-    sLog->outString("Loading Skill Perfection Data Table...");
-    LoadSkillPerfectItemTable();
+        sLog->outString("Loading Skill Perfection Data Table...");
+        LoadSkillPerfectItemTable();
 
-    sLog->outString("Loading Skill Fishing base level requirements...");
-    sObjectMgr->LoadFishingBaseSkillLevel();
+        sLog->outString("Loading Skill Fishing base level requirements...");
+        sObjectMgr->LoadFishingBaseSkillLevel();
+    });
 
-    sLog->outString("Loading Achievements...");
-    sAchievementMgr->LoadAchievementReferenceList();
-    sLog->outString("Loading Achievement Criteria Lists...");
-    sAchievementMgr->LoadAchievementCriteriaList();
-    sLog->outString("Loading Achievement Criteria Data...");
-    sAchievementMgr->LoadAchievementCriteriaData();
-    sLog->outString("Loading Achievement Rewards...");
-    sAchievementMgr->LoadRewards();
-    sLog->outString("Loading Achievement Reward Locales...");
-    sAchievementMgr->LoadRewardLocales();
-    sLog->outString("Loading Completed Achievements...");
-    sAchievementMgr->LoadCompletedAchievements();
+    acore::TaskGraph::TaskId achievements = worldTasks.Add("Achievements", []()
+    {
+        sLog->outString("Loading Achievements...");
+        sAchievementMgr->LoadAchievementReferenceList();
+        sLog->outString("Loading Achievement Criteria Lists...");
+        sAchievementMgr->LoadAchievementCriteriaList();
+        sLog->outString("Loading Achievement Criteria Data...");
+        sAchievementMgr->LoadAchievementCriteriaData();
+        sLog->outString("Loading Achievement Rewards...");
+        sAchievementMgr->LoadRewards();
+        sLog->outString("Loading Achievement Reward Locales...");
+        sAchievementMgr->LoadRewardLocales();
+    });
+
+    // after the cleanup removed achievements of invalid criteria
+    worldTasks.Add("Completed Achievements", []()
+    {
+        sLog->outString("Loading Completed Achievements...");
+        sAchievementMgr->LoadCompletedAchievements();
+    }, { achievements, cleanDatabase });
 
     ///- Load dynamic data tables from the database
-    sLog->outString("Loading Item Auctions...");
-    sAuctionMgr->LoadAuctionItems();
-    sLog->outString("Loading Auctions...");
-    sAuctionMgr->LoadAuctions();
+    worldTasks.Add("Auctions", []()
+    {
+        sLog->outString("Loading Item Auctions...");
+        sAuctionMgr->LoadAuctionItems();
+        sLog->outString("Loading Auctions...");
+        sAuctionMgr->LoadAuctions();
+    });
 
-    sGuildMgr->LoadGuilds();
+    // guilds, arena teams and groups all update the global player data
+    worldTasks.Add("Guilds, ArenaTeams and Groups", []()
+    {
+        sGuildMgr->LoadGuilds();
 
-    sLog->outString("Loading ArenaTeams...");
-    sArenaTeamMgr->LoadArenaTeams();
+        sLog->outString("Loading ArenaTeams...");
+        sArenaTeamMgr->LoadArenaTeams();
 
-    sLog->outString("Loading Groups...");
-    sGroupMgr->LoadGroups();
+        sLog->outString("Loading Groups...");
+        sGroupMgr->LoadGroups();
+    });
 
-    sLog->outString("Loading ReservedNames...");
-    sObjectMgr->LoadReservedPlayersNames();
+    worldTasks.Add("ReservedNames", []()
+    {
+        sLog->outString("Loading ReservedNames...");
+        sObjectMgr->LoadReservedPlayersNames();
+    });
 
-    sLog->outString("Loading GameObjects for quests...");
-    sObjectMgr->LoadGameObjectForQuests();
+    worldTasks.Add("GameObjects for quests", []()
+    {
+        sLog->outString("Loading GameObjects for quests...");
+        sObjectMgr->LoadGameObjectForQuests();
+    }, { gameobjectLoot });
 
-    sLog->outString("Loading BattleMasters...");
-    sBattlegroundMgr->LoadBattleMastersEntry();
+    worldTasks.Add("BattleMasters", []()
+    {
+        sLog->outString("Loading BattleMasters...");
+        sBattlegroundMgr->LoadBattleMastersEntry();
+    });
+
+    worldTasks.Add("GameTeleports", []()
+    {
+        sLog->outString("Loading GameTeleports...");
+        sObjectMgr->LoadGameTele();
+    });
 
-    sLog->outString("Loading GameTeleports...");
-    sObjectMgr->LoadGameTele();
+    worldTasks.Add("Gossip menus", []()
+    {
+        sLog->outString("Loading Gossip menu...");
+        sObjectMgr->LoadGossipMenu();
 
-    sLog->outString("Loading Gossip menu...");
-    sObjectMgr->LoadGossipMenu();
+        sLog->outString("Loading Gossip menu options...");
+        sObjectMgr->LoadGossipMenuItems();
+    });
 
-    sLog->outString("Loading Gossip menu options...");
-    sObjectMgr->LoadGossipMenuItems();
+    worldTasks.Add("Vendors", []()
+    {
+        sLog->outString("Loading Vendors...");
+        sObjectMgr->LoadVendors();                                   // must be after load CreatureTemplate and ItemTemplate
+    });
 
-    sLog->outString("Loading Vendors...");
-    sObjectMgr->LoadVendors();                                   // must be after load CreatureTemplate and ItemTemplate
+    worldTasks.Add("Trainers", []()
+    {
+        sLog->outString("Loading Trainers...");
+        sObjectMgr->LoadTrainerSpell();                              // must be after load CreatureTemplate
+    });
 
-    sLog->outString("Loading Trainers...");
-    sObjectMgr->LoadTrainerSpell();                              // must be after load CreatureTemplate
+    worldTasks.Add("Waypoints", []()
+    {
+        sLog->outString("Loading Waypoints...");
+        sWaypointMgr->Load();
+    });
 
-    sLog->outString("Loading Waypoints...");
-    sWaypointMgr->Load();
+    worldTasks.Add("SmartAI Waypoints", []()
+    {
+        sLog->outString("Loading SmartAI Waypoints...");
+        sSmartWaypointMgr->LoadFromDB();
+    });
 
-    sLog->outString("Loading SmartAI Waypoints...");
-    sSmartWaypointMgr->LoadFromDB();
+    worldTasks.Add("Creature Formations", []()
+    {
+        sLog->outString("Loading Creature Formations...");
+        sFormationMgr->LoadCreatureFormations();
+    });
 
-    sLog->outString("Loading Creature Formations...");
-    sFormationMgr->LoadCreatureFormations();
+    RunStartupTasks(worldTasks, "Player, loot, achievement, guild and npc data");
 
     sLog->outString("Loading World States...");              // must be loaded before battleground, outdoor PvP and conditions
     LoadWorldStates();
@@ -1932,6 +2163,9 @@ void World::SetInitialWorldSettings()
     sLog->outString();
     sObjectMgr->InitializeSpellInfoPrecomputedData();
 
+    ///- World data is loaded, later queries (reload commands) always go to the database
+    WorldDatabase.FinishSnapshot();
+
     ///- Initialize game time and timers
     sLog->outString("Initialize game time and timers");
     sLog->outString();
@@ -2184,6 +2418,39 @@ void World::Update(uint32 diff)
         if (m_updateTimeSum > m_int_configs[CONFIG_INTERVAL_LOG_UPDATE])
         {
             sLog->outBasic("Average update time diff: %u. Players online: %u.", avgDiffTracker.getAverage(), (uint32)GetActiveSessionCount());
+            sLog->outBasic("Average world sessions update time: %u, max: %u.", sessionDiffTracker.getAverage(), sessionDiffTracker.getMax());
+            sLog->outBasic("World update times (ms): %s.", worldDiffHistogram.ToString().c_str());
+            sLog->outBasic("World sessions update times (ms): %s.", sessionDiffHistogram.ToString().c_str());
+            worldDiffHistogram.Reset();
+            sessionDiffHistogram.Reset();
+
+            uint64 sendCalls, sentPackets;
+            sWorldSocketMgr->GetSendCounts(sendCalls, sentPackets);
+            if (uint32 sessions = GetActiveSessionCount())
+                sLog->outBasic("Network send calls per player per second: %.2f, packets per send call: %.2f.", float(sendCalls - m_lastSendCallCount) * IN_MILLISECONDS / m_updateTimeSum / sessions,
+                               sendCalls != m_lastSendCallCount ? float(sentPackets - m_lastSentPacketCount) / (sendCalls - m_lastSendCallCount) : 0.0f);
+            m_lastSendCallCount = sendCalls;
+            m_lastSentPacketCount = sentPackets;
+
+            uint32 savedPlayers = SavingSystemMgr::GetSavedPlayerCount();
+            uint64 savedStatements = SavingSystemMgr::GetSavedStatementCount();
+            if (savedPlayers != m_lastSavedPlayerCount)
+                sLog->outBasic("Player saves: %u, statements per save: %.1f.", savedPlayers - m_lastSavedPlayerCount,
+                               float(savedStatements - m_lastSavedStatementCount) / (savedPlayers - m_lastSavedPlayerCount));
+            m_lastSavedPlayerCount = savedPlayers;
+            m_lastSavedStatementCount = savedStatements;
+
+            UpdateCompressionStats compression = sUpdateCompressor->GetStats();
+            if (uint64 compressed = compression.CompressedPackets - m_lastCompressionStats.CompressedPackets)
+            {
+                uint64 inputBytes = compression.InputBytes - m_lastCompressionStats.InputBytes;
+                uint64 outputBytes = compression.OutputBytes - m_lastCompressionStats.OutputBytes;
+                sLog->outBasic("Update packets: %u compressed (%u offloaded), %u uncompressed. Compressed %u KB to %u KB, %.1f microseconds per packet.",
+                               uint32(compressed), uint32(compression.OffloadedPackets - m_lastCompressionStats.OffloadedPackets), uint32(compression.UncompressedPackets - m_lastCompressionStats.UncompressedPackets),
+                               uint32(inputBytes / 1024), uint32(outputBytes / 1024), float(compression.CompressTime - m_lastCompressionStats.CompressTime) / compressed);
+            }
+            m_lastCompressionStats = compression;
+
             m_updateTimeSum = 0;
         }
     }
@@ -2260,7 +2527,11 @@ void World::Update(uint32 diff)
             mail_expire_check_timer = m_gameTime + 6 * 3600;
         }
 
+        uint32 sessionsStartTime = getMSTime();
         UpdateSessions(diff);
+        uint32 sessionsTime = getMSTimeDiff(sessionsStartTime, getMSTime());
+        sessionDiffTracker.Update(sessionsTime);
+        sessionDiffHistogram.Update(sessionsTime);
     }
     // end of section with mutex
     AsyncAuctionListingMgr::SetAuctionListingAllowed(true);
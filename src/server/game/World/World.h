@@ -17,6 +17,7 @@
 #include "QueryResult.h"
 #include "SharedDefines.h"
 #include "Timer.h"
+#include "UpdateCompressor.h"
 #include <atomic>
 #include <list>
 #include <map>
@@ -27,6 +28,11 @@ class WorldPacket;
 class WorldSocket;
 class SystemMgr;
 
+namespace acore
+{
+    class TaskGraph;
+}
+
 extern uint32 realmID;
 
 enum ShutdownMask
@@ -140,6 +146,9 @@ enum WorldStates
 
 #define WORLD_SLEEP_CONST 10
 
+// StartupLoader.Threads, every one of them gets its own world and character database connection
+#define MAX_STARTUP_LOADER_THREADS 32
+
 enum GlobalPlayerUpdateMask
 {
     PLAYER_UPDATE_DATA_LEVEL            = 0x01,
@@ -261,6 +270,8 @@ public:
 
     void SetInitialWorldSettings();
     void LoadConfigSettings(bool reload = false);
+    /// StartupLoader.Threads limited to 0..MAX_STARTUP_LOADER_THREADS, Master opens the connections before the config is loaded
+    static uint32 ClampStartupLoaderThreads(int32 threads) { return uint32(std::min(std::max(threads, 0), MAX_STARTUP_LOADER_THREADS)); }
 
     void SendWorldText(uint32 string_id, ...);
     void SendGlobalText(const char* text, WorldSession* self);
@@ -396,6 +407,7 @@ public:
 
 protected:
     void _UpdateGameTime();
+    void RunStartupTasks(acore::TaskGraph& tasks, char const* stage);
     // callback for UpdateRealmCharacters
     void _UpdateRealmCharCount(PreparedQueryResult resultCharCount);
 
@@ -426,6 +438,10 @@ private:
     IntervalTimer m_timers[WUPDATE_COUNT];
     time_t mail_expire_check_timer;
     uint32 m_updateTime, m_updateTimeSum;
+    uint64 m_lastSendCallCount, m_lastSentPacketCount;
+    uint32 m_lastSavedPlayerCount;
+    uint64 m_lastSavedStatementCount;
+    UpdateCompressionStats m_lastCompressionStats;
     static uint32 m_gameMSTime;
 
     SessionMap m_sessions;
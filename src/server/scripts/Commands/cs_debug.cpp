@@ -20,6 +20,7 @@ EndScriptData */
 #include "GridNotifiersImpl.h"
 #include "Language.h"
 #include "ObjectMgr.h"
+#include "PacketLog.h"
 #include "ScriptMgr.h"
 #include <fstream>
 
@@ -58,6 +59,7 @@ public:
             { "anim",           SEC_ADMINISTRATOR,  false, &HandleDebugAnimCommand,            "" },
             { "arena",          SEC_ADMINISTRATOR,  false, &HandleDebugArenaCommand,           "" },
             { "bg",             SEC_ADMINISTRATOR,  false, &HandleDebugBattlegroundCommand,    "" },
+            { "capture",        SEC_ADMINISTRATOR,  true,  &HandleDebugCaptureCommand,         "" },
             { "getitemstate",   SEC_ADMINISTRATOR,  false, &HandleDebugGetItemStateCommand,    "" },
             { "lootrecipient",  SEC_ADMINISTRATOR,  false, &HandleDebugGetLootRecipientCommand, "" },
             { "getvalue",       SEC_ADMINISTRATOR,  false, &HandleDebugGetValueCommand,        "" },
@@ -1368,6 +1370,32 @@ public:
         return true;
     }
 
+    static bool HandleDebugCaptureCommand(ChatHandler* handler, char const* args)
+    {
+        if (!sPacketLog->CanCapturePackets())
+        {
+            handler->SendSysMessage("Packet capture is disabled, set PacketLog.Capture.BufferSize to enable it.");
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        Player* target = nullptr;
+        if (!handler->extractPlayerTarget((char*)args, &target))
+            return false;
+
+        std::string reason = handler->GetSession() ? "GM " + handler->GetSession()->GetPlayerName() : "console";
+        std::string filename = target->GetSession()->DumpPacketCapture(reason);
+        if (filename.empty())
+        {
+            handler->PSendSysMessage("No packet capture written for %s.", target->GetName().c_str());
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        handler->PSendSysMessage("Packets of %s are being written to %s.", target->GetName().c_str(), filename.c_str());
+        return true;
+    }
+
     static bool HandleWPGPSCommand(ChatHandler* handler, char const* /*args*/)
     {
         Player* player = handler->GetSession()->GetPlayer();
@@ -15,8 +15,11 @@ EndScriptData */
 #include "Chat.h"
 #include "Config.h"
 #include "GitRevision.h"
+#include "GridPrefetcher.h"
 #include "Language.h"
+#include "MapManager.h"
 #include "ObjectAccessor.h"
+#include "PathRequestQueue.h"
 #include "Player.h"
 #include "ScriptMgr.h"
 #include "ServerMotd.h"
@@ -64,10 +67,12 @@ public:
         static std::vector<ChatCommand> serverCommandTable =
         {
             { "corpses",        SEC_GAMEMASTER,     true,  &HandleServerCorpsesCommand,             "" },
+            { "dbstats",        SEC_ADMINISTRATOR,  true,  &HandleServerDatabaseStatsCommand,       "" },
             { "exit",           SEC_CONSOLE,        true,  &HandleServerExitCommand,                "" },
             { "idlerestart",    SEC_CONSOLE,        true,  nullptr,                                 "", serverIdleRestartCommandTable },
             { "idleshutdown",   SEC_CONSOLE,        true,  nullptr,                                 "", serverIdleShutdownCommandTable },
             { "info",           SEC_PLAYER,         true,  &HandleServerInfoCommand,                "" },
+            { "mapcosts",       SEC_ADMINISTRATOR,  true,  &HandleServerMapCostsCommand,            "" },
             { "motd",           SEC_PLAYER,         true,  &HandleServerMotdCommand,                "" },
             { "restart",        SEC_ADMINISTRATOR,  true,  nullptr,                                 "", serverRestartCommandTable },
             { "shutdown",       SEC_ADMINISTRATOR,  true,  nullptr,                                 "", serverShutdownCommandTable },
@@ -112,7 +117,12 @@ public:
         if (handler->GetSession())
             if (Player* p = handler->GetSession()->GetPlayer())
                 if (p->IsDeveloper())
+                {
                     handler->PSendSysMessage("DEV wavg: %ums, nsmax: %ums, nsavg: %ums. LFG avg: %ums, max: %ums.", avgDiffTracker.getTimeWeightedAverage(), devDiffTracker.getMax(), devDiffTracker.getAverage(), lfgDiffTracker.getAverage(), lfgDiffTracker.getMax());
+                    handler->PSendSysMessage("World sessions avg: %ums, max: %ums. Parallel map sessions: %s.", sessionDiffTracker.getAverage(), sessionDiffTracker.getMax(), sWorld->getBoolConfig(CONFIG_MAP_UPDATE_PARALLEL_SESSIONS) ? "on" : "off");
+                    handler->PSendSysMessage("World update times (ms): %s.", worldDiffHistogram.ToString().c_str());
+                    handler->PSendSysMessage("World sessions update times (ms): %s.", sessionDiffHistogram.ToString().c_str());
+                }
 
         //! Can't use sWorld->ShutdownMsg here in case of console command
         if (sWorld->IsShuttingDown())
@@ -120,6 +130,77 @@ public:
 
         return true;
     }
+    // Display the most expensive maps by measured update time
+    static bool HandleServerMapCostsCommand(ChatHandler* handler, char const* args)
+    {
+        uint32 limit = 10;
+        if (*args)
+            limit = std::max(1, atoi(args));
+
+        std::vector<Map*> maps;
+        sMapMgr->GetMapsByUpdateCost(maps);
+
+        handler->PSendSysMessage("Map update costs (full avg / sessions avg / last / max, in microseconds), %u threads:", sWorld->getIntConfig(CONFIG_NUMTHREADS));
+        for (uint32 i = 0; i < maps.size() && i < limit; ++i)
+        {
+            Map const* map = maps[i];
+            handler->PSendSysMessage("Map %u (%s) instance %u, players %u: %u / %u / %u / %u", map->GetId(), map->GetMapName(), map->GetInstanceId(), map->GetPlayersCountExceptGMs(),
+                                     map->GetUpdateCost(true), map->GetUpdateCost(false), map->GetLastUpdateCost(), map->GetMaxUpdateCost());
+            if (sWorld->getBoolConfig(CONFIG_VISIBILITY_ADAPTIVE))
+            {
+                MapVisibilityThrottle const& throttle = map->GetVisibilityThrottle();
+                handler->PSendSysMessage("    Visibility level %u: notify delay %ums, AI delay %ums, from %u microseconds and %u movers.", throttle.GetLevel(),
+                                         DynamicVisibilityMgr::GetVisibilityNotifyDelay(map), DynamicVisibilityMgr::GetAINotifyDelay(map), throttle.GetLastCost(), throttle.GetLastMovers());
+            }
+        }
+
+        GridMapStats const& terrain = GridMap::GetStats();
+        uint32 loads = terrain.LoadCount;
+        handler->PSendSysMessage("Terrain tiles: %u loaded (%u memory mapped), average load time %u microseconds, %u KB heap, %u KB mapped.",
+                                 loads, uint32(terrain.MappedCount), loads ? uint32(terrain.LoadTime / loads) : 0, uint32(terrain.HeapBytes / 1024), uint32(terrain.MappedBytes / 1024));
+        if (sGridPrefetcher->IsActive())
+            handler->PSendSysMessage("Grid prefetch: %u grids requested, %u used by maps.", sGridPrefetcher->GetRequestCount(), sGridPrefetcher->GetUsedCount());
+        if (sPathRequestQueue->IsActive())
+            handler->PSendSysMessage("Path requests: %u searched by %u threads, %u taken from the cache.", sPathRequestQueue->GetRequestCount(), sWorld->getIntConfig(CONFIG_MMAPS_ASYNC_THREADS), sPathRequestQueue->GetCacheHitCount());
+
+        UpdateCompressionStats compression = sUpdateCompressor->GetStats();
+        if (compression.CompressedPackets)
+            handler->PSendSysMessage("Update packets: %u compressed (%u by %u compression threads), %u uncompressed. Compressed %u KB to %u KB, average %u microseconds.",
+                                     uint32(compression.CompressedPackets), uint32(compression.OffloadedPackets), sWorld->getIntConfig(CONFIG_COMPRESSION_THREADS), uint32(compression.UncompressedPackets),
+                                     uint32(compression.InputBytes / 1024), uint32(compression.OutputBytes / 1024), uint32(compression.CompressTime / compression.CompressedPackets));
+
+        return true;
+    }
+
+    template<class T>
+    static void SendDatabaseStats(ChatHandler* handler, DatabaseWorkerPool<T>& database, uint32 limit)
+    {
+        uint64 commits, operations;
+        database.GetGroupCommitStats(commits, operations);
+        handler->PSendSysMessage("Database %s: %u grouped commits holding %u async operations.", database.GetDatabaseName(), uint32(commits), uint32(operations));
+
+        std::vector<PreparedStatementStats> stats;
+        database.GetStatementStats(stats);
+        for (uint32 i = 0; i < stats.size() && i < limit; ++i)
+        {
+            PreparedStatementStats const& stat = stats[i];
+            handler->PSendSysMessage("  #%u: %u executions, %u ms total, %u us average: %s", stat.Index, uint32(stat.Count), uint32(stat.Time / 1000),
+                                     uint32(stat.Time / stat.Count), stat.Query.substr(0, 80).c_str());
+        }
+    }
+
+    static bool HandleServerDatabaseStatsCommand(ChatHandler* handler, char const* args)
+    {
+        uint32 limit = 5;
+        if (*args)
+            limit = std::max(1, atoi(args));
+
+        SendDatabaseStats(handler, CharacterDatabase, limit);
+        SendDatabaseStats(handler, WorldDatabase, limit);
+        SendDatabaseStats(handler, LoginDatabase, limit);
+        return true;
+    }
+
     // Display the 'Message of the day' for the realm
     static bool HandleServerMotdCommand(ChatHandler* handler, char const* /*args*/)
     {
@@ -398,6 +398,9 @@ bool Master::_StartDB()
     std::string dbstring;
     uint8 async_threads, synch_threads;
 
+    // every startup loader thread gets a connection of its own to the world and character databases
+    uint8 loader_threads = uint8(World::ClampStartupLoaderThreads(sConfigMgr->GetOption<int32>("StartupLoader.Threads", 0)));
+
     dbstring = sConfigMgr->GetOption<std::string>("WorldDatabaseInfo", "");
     if (dbstring.empty())
     {
@@ -413,7 +416,7 @@ bool Master::_StartDB()
         return false;
     }
 
-    synch_threads = uint8(sConfigMgr->GetOption<int32>("WorldDatabase.SynchThreads", 1));
+    synch_threads = std::max(uint8(sConfigMgr->GetOption<int32>("WorldDatabase.SynchThreads", 1)), loader_threads);
     ///- Initialise the world database
     if (!WorldDatabase.Open(dbstring, async_threads, synch_threads))
     {
@@ -437,7 +440,7 @@ bool Master::_StartDB()
         return false;
     }
 
-    synch_threads = uint8(sConfigMgr->GetOption<int32>("CharacterDatabase.SynchThreads", 2));
+    synch_threads = std::max(uint8(sConfigMgr->GetOption<int32>("CharacterDatabase.SynchThreads", 2)), loader_threads);
 
     ///- Initialise the Character database
     if (!CharacterDatabase.Open(dbstring, async_threads, synch_threads))
@@ -50,6 +50,7 @@ void WorldRunnable::run()
 
         uint32 executionTimeDiff = getMSTimeDiff(realCurrTime, getMSTime());
         devDiffTracker.Update(executionTimeDiff);
+        worldDiffHistogram.Update(executionTimeDiff);
         avgDiffTracker.Update(executionTimeDiff > WORLD_SLEEP_CONST ? executionTimeDiff : WORLD_SLEEP_CONST);
 
         if (executionTimeDiff < WORLD_SLEEP_CONST)
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "QuerySnapshot.h"
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+    std::string const SnapshotPath = "query_snapshot_test.bin";
+
+    // two rows of (entry, name), the second name NULL
+    std::string MakeRows()
+    {
+        std::string rows;
+        auto field = [&rows](char const* value)
+        {
+            uint32 length = value ? uint32(strlen(value)) : QuerySnapshot::NULL_FIELD_LENGTH;
+            rows.append(reinterpret_cast<char const*>(&length), sizeof(uint32));
+            if (value)
+                rows.append(value, length + 1);
+        };
+
+        field("1");
+        field("Hogger");
+        field("2");
+        field(nullptr);
+        return rows;
+    }
+
+    void Record(QuerySnapshot& snapshot, std::string const& sql)
+    {
+        snapshot.Record(sql, 2, 2, { 3, 253 }, MakeRows());
+    }
+}
+
+TEST(QuerySnapshotTest, OnlyStoresReadsOfTables)
+{
+    EXPECT_TRUE(QuerySnapshot::CanStore("SELECT entry, name FROM creature_template"));
+    EXPECT_TRUE(QuerySnapshot::CanStore("  select guid from creature"));
+    EXPECT_FALSE(QuerySnapshot::CanStore("DELETE FROM creature_respawn WHERE respawnTime < 5"));
+    EXPECT_FALSE(QuerySnapshot::CanStore("SELECT id FROM game_event WHERE start_time < UNIX_TIMESTAMP()"));
+    EXPECT_FALSE(QuerySnapshot::CanStore("SELECT id FROM pool WHERE rand() < 0.5"));
+}
+
+TEST(QuerySnapshotTest, ReadsRecordedResultsAfterSaving)
+{
+    remove(SnapshotPath.c_str());
+
+    {
+        QuerySnapshot snapshot(SnapshotPath, 42);
+        EXPECT_FALSE(snapshot.Load());
+        Record(snapshot, "SELECT entry, name FROM creature_template");
+        Record(snapshot, "SELECT entry, name FROM item_template");
+        EXPECT_EQ(snapshot.GetRecorded(), 2u);
+        ASSERT_TRUE(snapshot.Save());
+    }
+
+    QuerySnapshot snapshot(SnapshotPath, 42);
+    ASSERT_TRUE(snapshot.Load());
+
+    QuerySnapshot::Result result;
+    EXPECT_FALSE(snapshot.Find("SELECT guid FROM creature", result));
+    ASSERT_TRUE(snapshot.Find("SELECT entry, name FROM creature_template", result));
+    EXPECT_EQ(result.FieldCount, 2u);
+    EXPECT_EQ(result.RowCount, 2u);
+
+    uint32 type;
+    memcpy(&type, result.Types + sizeof(uint32), sizeof(uint32));
+    EXPECT_EQ(type, 253u);
+
+    std::string rows = MakeRows();
+    EXPECT_EQ(memcmp(result.Rows, rows.data(), rows.size()), 0);
+    EXPECT_EQ(snapshot.GetHits(), 1u);
+
+    // nothing new was asked, the file stays as it is
+    EXPECT_TRUE(snapshot.Save());
+
+    remove(SnapshotPath.c_str());
+}
+
+TEST(QuerySnapshotTest, KeepsOnlyResultsStillAsked)
+{
+    remove(SnapshotPath.c_str());
+
+    {
+        QuerySnapshot snapshot(SnapshotPath, 7);
+        Record(snapshot, "SELECT a FROM old_table");
+        Record(snapshot, "SELECT a FROM kept_table");
+        ASSERT_TRUE(snapshot.Save());
+    }
+
+    {
+        QuerySnapshot snapshot(SnapshotPath, 7);
+        ASSERT_TRUE(snapshot.Load());
+        QuerySnapshot::Result result;
+        ASSERT_TRUE(snapshot.Find("SELECT a FROM kept_table", result));
+        Record(snapshot, "SELECT a FROM new_table");
+        ASSERT_TRUE(snapshot.Save());
+    }
+
+    QuerySnapshot snapshot(SnapshotPath, 7);
+    ASSERT_TRUE(snapshot.Load());
+    QuerySnapshot::Result result;
+    EXPECT_TRUE(snapshot.Find("SELECT a FROM kept_table", result));
+    EXPECT_TRUE(snapshot.Find("SELECT a FROM new_table", result));
+    EXPECT_FALSE(snapshot.Find("SELECT a FROM old_table", result));
+
+    remove(SnapshotPath.c_str());
+}
+
+TEST(QuerySnapshotTest, RejectsOtherKeysAndDamagedFiles)
+{
+    remove(SnapshotPath.c_str());
+
+    {
+        QuerySnapshot snapshot(SnapshotPath, 1);
+        Record(snapshot, "SELECT entry, name FROM creature_template");
+        ASSERT_TRUE(snapshot.Save());
+    }
+
+    // tables changed since the file was written
+    EXPECT_FALSE(QuerySnapshot(SnapshotPath, 2).Load());
+    EXPECT_TRUE(QuerySnapshot(SnapshotPath, 1).Load());
+
+    // one byte of a row changed
+    FILE* file = fopen(SnapshotPath.c_str(), "r+b");
+    ASSERT_NE(file, nullptr);
+    fseek(file, -3, SEEK_END);
+    fputc('x', file);
+    fclose(file);
+    EXPECT_FALSE(QuerySnapshot(SnapshotPath, 1).Load());
+
+    remove(SnapshotPath.c_str());
+}
+
+TEST(QuerySnapshotTest, FindsTablesReadByQueries)
+{
+    QuerySnapshot snapshot(SnapshotPath, 1);
+    snapshot.SetTableNames({ "creature", "creature_template", "item_template", "spell_dbc" });
+
+    std::vector<std::string> tables = snapshot.GetTablesWithoutChecksum("SELECT ct.entry FROM `creature_template` ct LEFT JOIN creature c ON c.id = ct.entry");
+    EXPECT_EQ(tables, std::vector<std::string>({ "creature", "creature_template" }));
+
+    // names inside longer names are not tables
+    EXPECT_TRUE(snapshot.GetTablesWithoutChecksum("SELECT entry FROM creature_template_addon").empty());
+    EXPECT_EQ(snapshot.GetTablesWithoutChecksum("select Id from SPELL_DBC"), std::vector<std::string>({ "spell_dbc" }));
+
+    // a table gets one checksum, the first
+    snapshot.SetChecksums({ { "creature", "10" } });
+    snapshot.SetChecksums({ { "creature", "11" }, { "creature_template", "20" } });
+    EXPECT_TRUE(snapshot.GetTablesWithoutChecksum("SELECT ct.entry FROM creature_template ct LEFT JOIN creature c ON c.id = ct.entry").empty());
+    EXPECT_EQ(snapshot.GetChecksums().at("creature"), "10");
+}
+
+TEST(QuerySnapshotTest, KeepsChecksumsOfTables)
+{
+    remove(SnapshotPath.c_str());
+
+    {
+        QuerySnapshot snapshot(SnapshotPath, 3);
+        snapshot.SetChecksums({ { "creature_template", "1234" }, { "missing_table", "-" } });
+        Record(snapshot, "SELECT entry, name FROM creature_template");
+        ASSERT_TRUE(snapshot.Save());
+    }
+
+    QuerySnapshot snapshot(SnapshotPath, 3);
+    ASSERT_TRUE(snapshot.Load());
+    QuerySnapshot::TableChecksums expected = { { "creature_template", "1234" }, { "missing_table", "-" } };
+    EXPECT_EQ(snapshot.GetChecksums(), expected);
+
+    // a changed table drops the file
+    snapshot.Unload();
+    QuerySnapshot::Result result;
+    EXPECT_FALSE(snapshot.IsLoaded());
+    EXPECT_FALSE(snapshot.Find("SELECT entry, name FROM creature_template", result));
+    EXPECT_TRUE(snapshot.GetChecksums().empty());
+
+    remove(SnapshotPath.c_str());
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "Logging/LogWriter.h"
+#include "gtest/gtest.h"
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr uint32 THREADS = 4;
+    constexpr uint32 RECORDS_PER_THREAD = 50000;
+}
+
+TEST(LogWriterTest, KeepsOrderOfEachThread)
+{
+    std::vector<std::vector<uint32>> written(THREADS);
+    {
+        LogWriter writer(1024, LOG_OVERFLOW_WAIT, [&written](std::vector<LogRecord*> const& records, uint64 /*droppedRecords*/)
+        {
+            for (LogRecord const* record : records)
+                written[record->Value >> 24].push_back(record->Value & 0xFFFFFF);
+        });
+
+        std::vector<std::thread> threads;
+        for (uint32 t = 0; t < THREADS; ++t)
+            threads.emplace_back([&writer, t]()
+            {
+                for (uint32 i = 0; i < RECORDS_PER_THREAD; ++i)
+                {
+                    LogRecord* record = new LogRecord(LOG_RECORD_FILE, std::string());
+                    record->Value = (t << 24) | i;
+                    writer.Push(record);
+                }
+            });
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        // the threads ended, their queues are still written
+        writer.Flush();
+        EXPECT_EQ(writer.GetDroppedRecords(), 0u);
+    }
+
+    for (uint32 t = 0; t < THREADS; ++t)
+    {
+        ASSERT_EQ(written[t].size(), RECORDS_PER_THREAD);
+        for (uint32 i = 0; i < RECORDS_PER_THREAD; ++i)
+            ASSERT_EQ(written[t][i], i);
+    }
+}
+
+TEST(LogWriterTest, DropsWhenFull)
+{
+    std::mutex blockWriter;
+    uint64 written = 0;
+    uint64 reportedDropped = 0;
+
+    std::unique_lock<std::mutex> guard(blockWriter);
+    LogWriter writer(8, LOG_OVERFLOW_DROP, [&](std::vector<LogRecord*> const& records, uint64 droppedRecords)
+    {
+        std::lock_guard<std::mutex> writeGuard(blockWriter);
+        written += records.size();
+        reportedDropped += droppedRecords;
+    });
+
+    // the writer is stuck in a slow write, the queue holds 8 records
+    for (uint32 i = 0; i < 100; ++i)
+        writer.Push(new LogRecord(LOG_RECORD_FILE, std::string("text")));
+
+    EXPECT_GE(writer.GetDroppedRecords(), 100u - 16u);
+
+    guard.unlock();
+    writer.Flush();
+
+    EXPECT_EQ(written + writer.GetDroppedRecords(), 100u);
+    EXPECT_EQ(reportedDropped, writer.GetDroppedRecords());
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "Define.h"
+#include "Threading/MPSCQueue.h"
+#include "gtest/gtest.h"
+#include <thread>
+#include <vector>
+
+using acore::MPSCQueue;
+
+namespace
+{
+    struct EvenChecker
+    {
+        bool Process(uint32 value) { return value % 2 == 0; }
+    };
+
+    constexpr uint32 PRODUCERS = 4;
+    constexpr uint32 ITEMS_PER_PRODUCER = 100000;
+}
+
+TEST(MPSCQueueTest, FifoAndCapacity)
+{
+    MPSCQueue<uint32> queue(4);
+    uint32 item = 0;
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.next(item));
+
+    for (uint32 i = 1; i <= 4; ++i)
+        EXPECT_TRUE(queue.add(i));
+    EXPECT_FALSE(queue.add(5));
+
+    for (uint32 i = 1; i <= 4; ++i)
+    {
+        EXPECT_TRUE(queue.next(item));
+        EXPECT_EQ(item, i);
+    }
+
+    // positions wrap around the ring
+    EXPECT_TRUE(queue.add(6));
+    EXPECT_TRUE(queue.peek(item));
+    EXPECT_EQ(item, 6u);
+    queue.pop_front();
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(MPSCQueueTest, CheckerKeepsRejectedItemInFront)
+{
+    MPSCQueue<uint32> queue(8);
+    EvenChecker checker;
+    uint32 item = 0;
+
+    queue.add(2);
+    queue.add(3);
+    queue.add(4);
+
+    EXPECT_TRUE(queue.next(item, checker));
+    EXPECT_EQ(item, 2u);
+    EXPECT_FALSE(queue.next(item, checker));
+    EXPECT_TRUE(queue.peek(item));
+    EXPECT_EQ(item, 3u);
+
+    EXPECT_TRUE(queue.next(item));
+    EXPECT_EQ(item, 3u);
+    EXPECT_TRUE(queue.next(item, checker));
+    EXPECT_EQ(item, 4u);
+}
+
+// items are producer << 24 | sequence, the consumer checks the items of every producer arrive in order
+TEST(MPSCQueueTest, KeepsOrderOfEveryProducer)
+{
+    MPSCQueue<uint32> queue(256);
+
+    std::vector<std::thread> producers;
+    for (uint32 p = 0; p < PRODUCERS; ++p)
+        producers.emplace_back([&queue, p]()
+        {
+            for (uint32 i = 0; i < ITEMS_PER_PRODUCER; ++i)
+                while (!queue.add((p << 24) | i))
+                    std::this_thread::yield();
+        });
+
+    std::vector<uint32> expected(PRODUCERS, 0);
+    uint32 received = 0;
+    uint32 item;
+    while (received < PRODUCERS * ITEMS_PER_PRODUCER)
+    {
+        if (!queue.next(item))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        uint32 producer = item >> 24;
+        ASSERT_LT(producer, PRODUCERS);
+        EXPECT_EQ(item & 0xFFFFFF, expected[producer]);
+        expected[producer] = (item & 0xFFFFFF) + 1;
+        ++received;
+    }
+
+    for (std::thread& producer : producers)
+        producer.join();
+
+    EXPECT_TRUE(queue.empty());
+}
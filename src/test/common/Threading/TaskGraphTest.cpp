@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "Threading/TaskGraph.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+using namespace acore;
+
+namespace
+{
+    void Sleep(uint32 ms)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    }
+}
+
+TEST(TaskGraphTest, RunsInOrderOfAddingWithoutThreads)
+{
+    std::vector<uint32> order;
+    TaskGraph tasks;
+    TaskGraph::TaskId first = tasks.Add("first", [&order]() { order.push_back(0); });
+    tasks.Add("second", [&order]() { order.push_back(1); });
+    tasks.Add("third", [&order]() { order.push_back(2); }, { first });
+
+    tasks.Run(0);
+    EXPECT_EQ(order, std::vector<uint32>({ 0, 1, 2 }));
+}
+
+TEST(TaskGraphTest, RunsDependenciesFirst)
+{
+    std::mutex lock;
+    std::vector<uint32> finished;
+    TaskGraph tasks;
+
+    // a diamond under each of several roots
+    std::vector<std::vector<TaskGraph::TaskId>> dependencies;
+    for (uint32 root = 0; root < 8; ++root)
+    {
+        auto task = [&lock, &finished](uint32 id)
+        {
+            return [&lock, &finished, id]()
+            {
+                Sleep(id % 3);
+                std::lock_guard<std::mutex> guard(lock);
+                finished.push_back(id);
+            };
+        };
+
+        TaskGraph::TaskId top = tasks.Add("top", task(tasks.GetTaskCount()));
+        dependencies.push_back({});
+        TaskGraph::TaskId left = tasks.Add("left", task(tasks.GetTaskCount()), { top });
+        dependencies.push_back({ top });
+        TaskGraph::TaskId right = tasks.Add("right", task(tasks.GetTaskCount()), { top });
+        dependencies.push_back({ top });
+        tasks.Add("bottom", task(tasks.GetTaskCount()), { left, right });
+        dependencies.push_back({ left, right });
+    }
+
+    tasks.Run(4);
+
+    ASSERT_EQ(finished.size(), tasks.GetTaskCount());
+    std::vector<uint32> position(finished.size());
+    for (uint32 i = 0; i < finished.size(); ++i)
+        position[finished[i]] = i;
+
+    for (uint32 id = 0; id < dependencies.size(); ++id)
+        for (TaskGraph::TaskId dependency : dependencies[id])
+            EXPECT_LT(position[dependency], position[id]);
+}
+
+TEST(TaskGraphTest, FindsCriticalPath)
+{
+    TaskGraph tasks;
+    TaskGraph::TaskId templates = tasks.Add("templates", []() { Sleep(30); });
+    TaskGraph::TaskId locales = tasks.Add("locales", []() { Sleep(5); });
+    TaskGraph::TaskId loot = tasks.Add("loot", []() { Sleep(40); }, { templates });
+    tasks.Add("vendors", []() { Sleep(10); }, { templates, locales });
+    TaskGraph::TaskId conditions = tasks.Add("conditions", []() { Sleep(5); }, { loot, locales });
+
+    tasks.Run(3);
+
+    EXPECT_EQ(tasks.GetCriticalPath(), std::vector<TaskGraph::TaskId>({ templates, loot, conditions }));
+    EXPECT_GE(tasks.GetTime(loot), 40u);
+
+    // no number of threads beats the critical path
+    EXPECT_GE(tasks.GetWallTime(), 75u);
+}
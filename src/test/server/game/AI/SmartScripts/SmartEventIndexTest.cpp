@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "SmartEventIndex.h"
+#include "gtest/gtest.h"
+#include <random>
+
+namespace
+{
+    // the parts of SmartScriptHolder read when events are raised and timers updated
+    struct Row
+    {
+        uint32 Type;
+        bool Timed;
+        bool Active;
+        uint32 Timer;
+
+        uint32 GetEventType() const { return Type; }
+    };
+
+    constexpr uint32 EVENT_TYPES = 80;
+    constexpr uint32 ROW_COUNT = 50;
+
+    // a script like those of world creatures: a few update timers, the rest spread over the events they wait for
+    std::vector<Row> MakeScript(uint32 seed)
+    {
+        std::mt19937 random(seed);
+        std::vector<Row> rows;
+        for (uint32 i = 0; i < ROW_COUNT; ++i)
+        {
+            bool timed = i % 8 == 0;
+            rows.push_back({ timed ? 0 : 1 + uint32(random() % (EVENT_TYPES - 1)), timed, true, 0 });
+        }
+        return rows;
+    }
+
+    bool NeedsTimer(Row const& row)
+    {
+        return row.Timed || !row.Active;
+    }
+}
+
+TEST(SmartEventIndexTest, FindsRowsOfTypeInOrder)
+{
+    std::vector<Row> rows = MakeScript(5);
+    SmartEventIndex index;
+    index.Build(rows, NeedsTimer);
+
+    for (uint32 type = 0; type < EVENT_TYPES; ++type)
+    {
+        std::vector<uint32> expected;
+        for (uint32 row = 0; row < rows.size(); ++row)
+            if (rows[row].Type == type)
+                expected.push_back(row);
+
+        std::vector<uint32> found;
+        auto range = index.GetRows(type);
+        for (auto itr = range.first; itr != range.second; ++itr)
+            found.push_back(itr->second);
+
+        EXPECT_EQ(found, expected) << "event type " << type;
+    }
+
+    EXPECT_EQ(index.GetTimerRowCount(), 7u);
+}
+
+TEST(SmartEventIndexTest, UpdatesCooldownsUntilTheyRunOut)
+{
+    std::vector<Row> rows = MakeScript(9);
+    SmartEventIndex index;
+    index.Build(rows, NeedsTimer);
+
+    // rows 3 and 5 fire and start cooldowns
+    rows[3].Active = false;
+    rows[3].Timer = 250;
+    index.AddTimerRow(3);
+    rows[5].Active = false;
+    rows[5].Timer = 100;
+    index.AddTimerRow(5);
+    EXPECT_EQ(index.GetTimerRowCount(), 9u);
+
+    std::vector<uint32> updated;
+    auto update = [&rows, &updated](uint32 row)
+    {
+        updated.push_back(row);
+        if (rows[row].Timer < 200)
+            rows[row].Active = true;
+        else
+            rows[row].Timer -= 200;
+    };
+    auto keep = [&rows](uint32 row) { return NeedsTimer(rows[row]); };
+
+    index.UpdateTimers(update, keep);
+    EXPECT_EQ(updated, std::vector<uint32>({ 0, 3, 5, 8, 16, 24, 32, 40, 48 }));
+    EXPECT_EQ(index.GetTimerRowCount(), 8u);
+
+    updated.clear();
+    index.UpdateTimers(update, keep);
+    EXPECT_EQ(updated, std::vector<uint32>({ 0, 3, 8, 16, 24, 32, 40, 48 }));
+    EXPECT_EQ(index.GetTimerRowCount(), 7u);
+}
+
+TEST(SmartEventIndexTest, RowsStartingTimersDuringUpdate)
+{
+    std::vector<Row> rows = MakeScript(13);
+    SmartEventIndex index;
+    index.Build(rows, NeedsTimer);
+
+    // the timer of row 16 fires and starts cooldowns on an earlier and a later row, as a linear pass over all rows
+    // would, the later one is updated in the same pass, the earlier one from the next one on
+    std::vector<uint32> updated;
+    index.UpdateTimers([&](uint32 row)
+    {
+        updated.push_back(row);
+        if (row == 16)
+        {
+            rows[2].Active = false;
+            index.AddTimerRow(2);
+            rows[20].Active = false;
+            index.AddTimerRow(20);
+        }
+    }, [&rows](uint32 row) { return NeedsTimer(rows[row]); });
+
+    EXPECT_EQ(updated, std::vector<uint32>({ 0, 8, 16, 20, 24, 32, 40, 48 }));
+    EXPECT_EQ(index.GetTimerRowCount(), 9u);
+}
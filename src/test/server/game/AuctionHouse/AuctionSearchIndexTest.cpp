@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "AuctionHouseMgr.h"
+#include "ItemTemplate.h"
+#include "Util.h"
+#include "gtest/gtest.h"
+#include <map>
+#include <random>
+
+namespace
+{
+    constexpr uint32 AUCTION_COUNT = 100000;
+
+    struct SyntheticAuction
+    {
+        AuctionEntry Entry;
+        AuctionSearchRow Row;
+        std::string Name;
+    };
+
+    char const* const Words[] = { "Shadow", "Frost", "Bracers", "Helm", "Sword", "of the Monkey", "of the Bear", "Cloth", "Potion", "Elixir",
+                                  "Greater", "Ancient", "Runed", "Titanium", "Saronite", "Boots", "Staff", "Ring", "Glyph", "Recipe" };
+
+    class AuctionSearchIndexTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            std::mt19937 rng(12345);
+            uint32 const wordCount = sizeof(Words) / sizeof(Words[0]);
+
+            auctions.resize(AUCTION_COUNT);
+            for (uint32 i = 0; i < AUCTION_COUNT; ++i)
+            {
+                SyntheticAuction& auction = auctions[i];
+                auction.Entry = AuctionEntry();
+                auction.Entry.Id = i + 1;
+                auction.Row.ItemClass = uint8(rng() % 16);
+                auction.Row.ItemSubClass = uint8(rng() % 20);
+                auction.Row.InventoryType = uint8(rng() % 28);
+                auction.Row.Quality = uint8(rng() % 6);
+                auction.Row.RequiredLevel = uint8(rng() % 81);
+                auction.Row.ExpireTime = 1000 + time_t(rng() % 100);
+                auction.Name = std::string(Words[rng() % wordCount]) + ' ' + Words[rng() % wordCount] + ' ' + Words[rng() % wordCount];
+
+                index.Insert(&auction.Entry, auction.Entry.Id, auction.Row);
+                byId[auction.Entry.Id] = &auction;
+            }
+        }
+
+        // every auction checked on its own, the name converted on each check
+        std::vector<AuctionEntry*> LinearSearch(AuctionSearchQuery const& query)
+        {
+            std::vector<AuctionEntry*> result;
+            for (auto const& itr : byId)
+            {
+                SyntheticAuction* auction = itr.second;
+                AuctionSearchRow const& row = auction->Row;
+                if (row.ExpireTime < query.CurTime)
+                    continue;
+                if (query.ItemClass != 0xffffffff && row.ItemClass != query.ItemClass)
+                    continue;
+                if (query.ItemSubClass != 0xffffffff && row.ItemSubClass != query.ItemSubClass)
+                    continue;
+                if (query.InventoryType != 0xffffffff && row.InventoryType != query.InventoryType)
+                    if (query.InventoryType != INVTYPE_CHEST || row.InventoryType != INVTYPE_ROBE)
+                        continue;
+                if (query.Quality != 0xffffffff && row.Quality != query.Quality)
+                    continue;
+                if (query.LevelMin != 0x00 && (row.RequiredLevel < query.LevelMin || (query.LevelMax != 0x00 && row.RequiredLevel > query.LevelMax)))
+                    continue;
+                if (!query.Name.empty() && !Utf8FitTo(auction->Name, query.Name))
+                    continue;
+
+                result.push_back(&auction->Entry);
+            }
+            return result;
+        }
+
+        std::vector<SyntheticAuction> auctions;
+        std::map<uint32, SyntheticAuction*> byId;
+        uint32 namesBuilt = 0;
+        AuctionSearchIndex index{ [this](AuctionEntry const* auction, uint32 /*nameLocale*/, std::wstring& name)
+        {
+            ++namesBuilt;
+            // re-added auctions get AUCTION_COUNT added to their id
+            if (!Utf8toWStr(auctions[(auction->Id - 1) % AUCTION_COUNT].Name, name))
+                return false;
+
+            wstrToLower(name);
+            return true;
+        } };
+    };
+
+    std::vector<AuctionSearchQuery> Queries()
+    {
+        std::vector<AuctionSearchQuery> queries;
+
+        AuctionSearchQuery query;
+        query.CurTime = 1050;
+
+        query.Name = L"monkey";
+        queries.push_back(query);
+
+        query.Name = L"titanium boots";
+        queries.push_back(query);
+
+        query.Name.clear();
+        query.ItemClass = 4;
+        query.ItemSubClass = 2;
+        queries.push_back(query);
+
+        query.ItemSubClass = 0xffffffff;
+        query.Quality = 3;
+        query.LevelMin = 70;
+        query.LevelMax = 80;
+        queries.push_back(query);
+
+        query.Name = L"of";
+        query.InventoryType = INVTYPE_CHEST;
+        queries.push_back(query);
+
+        return queries;
+    }
+}
+
+TEST_F(AuctionSearchIndexTest, MatchesLinearSearch)
+{
+    for (AuctionSearchQuery const& query : Queries())
+    {
+        std::vector<AuctionEntry*> indexed;
+        index.Search(query, indexed);
+        EXPECT_EQ(indexed, LinearSearch(query));
+    }
+}
+
+TEST_F(AuctionSearchIndexTest, IncrementalUpdates)
+{
+    AuctionSearchQuery query;
+    query.Name = L"glyph";
+
+    std::vector<AuctionEntry*> before;
+    index.Search(query, before);
+    ASSERT_FALSE(before.empty());
+
+    // removing every other auction, the name index of the searched locale is kept up to date
+    for (uint32 i = 0; i < AUCTION_COUNT; i += 2)
+    {
+        index.Remove(auctions[i].Entry.Id);
+        byId.erase(auctions[i].Entry.Id);
+    }
+
+    std::vector<AuctionEntry*> after;
+    index.Search(query, after);
+    EXPECT_EQ(after, LinearSearch(query));
+    EXPECT_EQ(index.GetCount(), AUCTION_COUNT / 2);
+
+    // added back with new ids, the lists stay in id order
+    for (uint32 i = 0; i < AUCTION_COUNT; i += 2)
+    {
+        auctions[i].Entry.Id += AUCTION_COUNT;
+        index.Insert(&auctions[i].Entry, auctions[i].Entry.Id, auctions[i].Row);
+        byId[auctions[i].Entry.Id] = &auctions[i];
+    }
+
+    after.clear();
+    index.Search(query, after);
+    EXPECT_EQ(after, LinearSearch(query));
+    EXPECT_EQ(after.size(), before.size());
+}
+
+TEST_F(AuctionSearchIndexTest, AddedLocaleIsNotBuiltBySearch)
+{
+    index.AddLocale(0);
+    EXPECT_EQ(namesBuilt, AUCTION_COUNT);
+
+    AuctionSearchQuery query;
+    query.Name = L"saronite";
+    std::vector<AuctionEntry*> found;
+    index.Search(query, found);
+    EXPECT_EQ(found, LinearSearch(query));
+    EXPECT_EQ(namesBuilt, AUCTION_COUNT);
+
+    // a locale nobody added yet is still built at its first search
+    query.NameLocale = 1;
+    found.clear();
+    index.Search(query, found);
+    EXPECT_EQ(namesBuilt, AUCTION_COUNT * 2);
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "ThreatStorage.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <memory>
+#include <random>
+
+namespace
+{
+    // the parts of HostileReference read by the threat list
+    struct Ref
+    {
+        Ref(uint64 guid, float threat) : Guid(guid), Threat(threat) { }
+
+        float getThreat() const { return Threat; }
+        uint64 getUnitGuid() const { return Guid; }
+
+        uint64 Guid;
+        float Threat;
+    };
+
+    std::vector<float> Threats(ThreatStorage<Ref> const& storage)
+    {
+        std::vector<float> threats;
+        for (Ref* ref : storage)
+            threats.push_back(ref->getThreat());
+        return threats;
+    }
+}
+
+TEST(ThreatStorageTest, KeepsThreatOrder)
+{
+    std::vector<std::unique_ptr<Ref>> refs;
+    ThreatStorage<Ref> storage;
+    for (uint32 i = 0; i < 20; ++i)
+    {
+        refs.emplace_back(new Ref(i + 1, float(i % 7)));
+        storage.Add(refs.back().get());
+    }
+
+    std::mt19937 rng(99);
+    for (uint32 round = 0; round < 2000; ++round)
+    {
+        for (uint32 change = rng() % 5; change > 0; --change)
+        {
+            Ref* ref = refs[rng() % refs.size()].get();
+            ref->Threat = float(rng() % 10);
+            storage.ThreatChanged(ref);
+        }
+
+        if (round % 100 == 50)
+        {
+            Ref* ref = refs[rng() % refs.size()].get();
+            storage.Remove(ref);
+            EXPECT_EQ(storage.Find(ref->getUnitGuid()), nullptr);
+            storage.Add(ref);
+        }
+
+        storage.Update();
+
+        std::vector<float> threats = Threats(storage);
+        ASSERT_EQ(threats.size(), refs.size());
+        ASSERT_TRUE(std::is_sorted(threats.begin(), threats.end(), std::greater<float>()));
+    }
+
+    for (auto const& ref : refs)
+        EXPECT_EQ(storage.Find(ref->getUnitGuid()), ref.get());
+}
+
+TEST(ThreatStorageTest, IterationSurvivesChanges)
+{
+    Ref refs[4] = { { 1, 40.0f }, { 2, 30.0f }, { 3, 20.0f }, { 4, 10.0f } };
+    ThreatStorage<Ref> storage;
+    for (uint32 i = 0; i < 3; ++i)
+        storage.Add(&refs[i]);
+    storage.Update();
+
+    // threat changes keep the order while iterating, removed references are skipped and added ones reached
+    std::vector<uint64> seen;
+    for (ThreatStorage<Ref>::const_iterator itr = storage.begin(); itr != storage.end(); ++itr)
+    {
+        seen.push_back((*itr)->getUnitGuid());
+        if (seen.size() == 1)
+        {
+            refs[2].Threat = 100.0f;
+            storage.ThreatChanged(&refs[2]);
+            storage.Remove(&refs[1]);
+            storage.Add(&refs[3]);
+        }
+    }
+
+    EXPECT_EQ(seen, std::vector<uint64>({ 1, 3, 4 }));
+
+    ThreatStorage<Ref> copy(storage);
+    EXPECT_EQ(copy.size(), 3u);
+
+    storage.Update();
+    EXPECT_EQ(storage.front(), &refs[2]);
+    EXPECT_EQ(storage.back(), &refs[3]);
+
+    // the copy restores the order of its own
+    copy.Update();
+    EXPECT_TRUE(std::equal(storage.begin(), storage.end(), copy.begin()));
+}
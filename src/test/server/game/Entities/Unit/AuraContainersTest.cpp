@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "AuraContainers.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <map>
+#include <random>
+
+namespace
+{
+    // the parts of AuraEffect read by GetTotalAuraModifier and the proc checks
+    struct Effect
+    {
+        uint32 SpellId;
+        int32 Amount;
+        int32 MiscValue;
+    };
+}
+
+TEST(FlatAuraListTest, IterationSurvivesChanges)
+{
+    Effect effects[4] = { { 1, 1, 0 }, { 2, 2, 0 }, { 3, 3, 0 }, { 4, 4, 0 } };
+    FlatAuraList<Effect> list;
+    for (Effect& effect : effects)
+        list.push_back(&effect);
+
+    // removing the current item and adding items while iterating, like aura handlers may do
+    std::vector<uint32> seen;
+    for (FlatAuraList<Effect>::const_iterator itr = list.begin(); itr != list.end(); ++itr)
+    {
+        seen.push_back((*itr)->SpellId);
+        if ((*itr)->SpellId == 2)
+        {
+            list.remove(*itr);
+            list.remove(&effects[2]);
+        }
+        if (seen.size() == 1)
+            list.push_back(&effects[3]);
+    }
+
+    EXPECT_EQ(seen, std::vector<uint32>({ 1, 2, 4, 4 }));
+    EXPECT_EQ(list.size(), 3u);
+    EXPECT_EQ(list.front(), &effects[0]);
+    EXPECT_EQ(list.back(), &effects[3]);
+
+    std::vector<uint32> reversed;
+    for (FlatAuraList<Effect>::const_reverse_iterator itr = list.rbegin(); itr != list.rend(); ++itr)
+        reversed.push_back((*itr)->SpellId);
+    EXPECT_EQ(reversed, std::vector<uint32>({ 4, 4, 1 }));
+
+    FlatAuraList<Effect> copy(list);
+    EXPECT_FALSE(copy.NeedsCompact());
+    EXPECT_TRUE(list.NeedsCompact());
+    list.Compact();
+    EXPECT_FALSE(list.NeedsCompact());
+    EXPECT_TRUE(std::equal(list.begin(), list.end(), copy.begin()));
+
+    copy.sort([](Effect const* left, Effect const* right) { return left->SpellId > right->SpellId; });
+    EXPECT_EQ(copy.front(), &effects[3]);
+    EXPECT_EQ(copy.back(), &effects[0]);
+
+    list.remove(&effects[0]);
+    list.remove(&effects[3]);
+    EXPECT_TRUE(list.empty());
+    EXPECT_TRUE(list.begin() == list.end());
+}
+
+TEST(AuraSpellIdTableTest, CountsAndRemoval)
+{
+    AuraSpellIdTable table;
+    EXPECT_FALSE(table.Contains(1));
+
+    std::map<uint32, uint32> expected;
+    std::mt19937 rng(7);
+    for (uint32 i = 0; i < 20000; ++i)
+    {
+        uint32 spellId = rng() % 300;
+        if (rng() % 3 && expected[spellId])
+        {
+            table.Remove(spellId);
+            --expected[spellId];
+        }
+        else
+        {
+            table.Add(spellId);
+            ++expected[spellId];
+        }
+
+        // the removals shift entries back, every remaining spell id must stay reachable
+        if (i % 1000 == 0)
+            for (auto const& itr : expected)
+                ASSERT_EQ(table.Contains(itr.first), itr.second != 0) << "spell " << itr.first;
+    }
+}
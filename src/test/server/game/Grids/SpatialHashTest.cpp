@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "SpatialHash.h"
+#include "gtest/gtest.h"
+#include <cmath>
+#include <random>
+#include <set>
+
+namespace
+{
+    constexpr float MAX_RADIUS = 533.3333f;
+
+    struct TestObject
+    {
+        float X;
+        float Y;
+        float Size;
+        SpatialHashSlot Slot;
+
+        SpatialHashSlot& GetSpatialHashSlot() { return Slot; }
+    };
+
+    bool Reaches(TestObject const& object, float x, float y, float radius)
+    {
+        return std::hypot(object.X - x, object.Y - y) <= radius + object.Size;
+    }
+
+    std::set<TestObject*> FindInCircle(SpatialHash<TestObject> const& hash, float x, float y, float radius)
+    {
+        std::set<TestObject*> found;
+        hash.VisitInCircle(x, y, radius, [&found](TestObject* object) { found.insert(object); });
+        return found;
+    }
+}
+
+TEST(SpatialHashTest, OffersEveryObjectInRange)
+{
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+    std::uniform_real_distribution<float> size(0.5f, 12.0f);
+
+    std::vector<TestObject> objects(2000);
+    SpatialHash<TestObject> hash(8.0f, MAX_RADIUS);
+    for (TestObject& object : objects)
+    {
+        object.X = position(random);
+        object.Y = position(random);
+        object.Size = size(random);
+        hash.Insert(&object, object.X, object.Y, object.Size);
+    }
+
+    // move half of them, some far away, and remove a few
+    for (uint32 i = 0; i < objects.size(); i += 2)
+    {
+        objects[i].X += i % 4 ? 3.0f : 150.0f;
+        objects[i].Y -= 2.0f;
+        hash.Update(&objects[i], objects[i].X, objects[i].Y, objects[i].Size);
+    }
+
+    for (uint32 i = 1; i < objects.size(); i += 10)
+        hash.Remove(&objects[i]);
+
+    EXPECT_EQ(hash.GetCount(), uint32(objects.size() - objects.size() / 10));
+
+    for (uint32 search = 0; search < 200; ++search)
+    {
+        float x = position(random), y = position(random), radius = float(search % 40);
+        std::set<TestObject*> found = FindInCircle(hash, x, y, radius);
+
+        for (uint32 i = 0; i < objects.size(); ++i)
+        {
+            bool removed = i % 10 == 1;
+            if (!removed && Reaches(objects[i], x, y, radius))
+                EXPECT_TRUE(found.count(&objects[i])) << "object " << i << " missing in search " << search;
+            if (removed)
+                EXPECT_FALSE(found.count(&objects[i]));
+        }
+    }
+}
+
+TEST(SpatialHashTest, ConeKeepsObjectsInArc)
+{
+    SpatialHash<TestObject> hash(8.0f, MAX_RADIUS);
+    TestObject front{ 20.0f, 1.0f, 1.0f, SpatialHashSlot() };
+    TestObject back{ -20.0f, 0.0f, 1.0f, SpatialHashSlot() };
+    TestObject side{ 0.0f, 20.0f, 1.0f, SpatialHashSlot() };
+    TestObject near{ -1.0f, 0.0f, 1.0f, SpatialHashSlot() };
+    for (TestObject* object : { &front, &back, &side, &near })
+        hash.Insert(object, object->X, object->Y, object->Size);
+
+    std::set<TestObject*> found;
+    hash.VisitInCone(0.0f, 0.0f, 30.0f, 0.0f, 3.14159265f / 2, [&found](TestObject* object) { found.insert(object); });
+
+    EXPECT_TRUE(found.count(&front));
+    EXPECT_FALSE(found.count(&back));
+    EXPECT_FALSE(found.count(&side));
+    // too close to the center to tell, callers decide
+    EXPECT_TRUE(found.count(&near));
+}
+
+TEST(SpatialHashTest, LimitsRadius)
+{
+    std::vector<TestObject> objects;
+    for (float x : { 0.0f, 100.0f, 500.0f, 560.0f, 2000.0f, -3000.0f })
+        objects.push_back({ x, 0.0f, 1.0f, SpatialHashSlot() });
+    // far away, each in a bucket of its own
+    for (uint32 i = 0; i < 100; ++i)
+        objects.push_back({ 0.0f, 10000.0f + i * 8.0f, 1.0f, SpatialHashSlot() });
+
+    SpatialHash<TestObject> hash(8.0f, MAX_RADIUS);
+    for (TestObject& object : objects)
+        hash.Insert(&object, object.X, object.Y, object.Size);
+
+    // far more buckets in range than in use, the search walks the buckets in use
+    std::set<TestObject*> found = FindInCircle(hash, 0.0f, 0.0f, 50000.0f);
+    EXPECT_TRUE(found.count(&objects[0]));
+    EXPECT_TRUE(found.count(&objects[1]));
+    EXPECT_TRUE(found.count(&objects[2]));
+    EXPECT_FALSE(found.count(&objects[4]));
+    EXPECT_FALSE(found.count(&objects[5]));
+    EXPECT_FALSE(found.count(&objects[6]));
+
+    // fewer buckets in range than in use, the search looks them up
+    EXPECT_EQ(FindInCircle(hash, 90.0f, 0.0f, 20.0f), std::set<TestObject*>({ &objects[1] }));
+}
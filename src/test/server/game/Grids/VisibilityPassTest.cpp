@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "VisibilityPass.h"
+#include "gtest/gtest.h"
+#include <unordered_set>
+
+namespace
+{
+    struct FakePlayer
+    {
+        uint64 Guid;
+        std::unordered_set<uint64> ClientGuids;
+    };
+
+    // every mover of a pass in one cell runs its notifier over all players of the cell, as
+    // PlayerRelocationNotifier does, and returns how many pairs it updated both ways
+    uint32 RunPass(std::vector<FakePlayer>& players, uint32 movers, VisibilityPairs<FakePlayer>* pairs)
+    {
+        if (pairs)
+            for (uint32 i = 0; i < movers; ++i)
+                pairs->AddMover(&players[i]);
+
+        uint32 updated = 0;
+        for (uint32 i = 0; i < movers; ++i)
+        {
+            FakePlayer& mover = players[i];
+            VisibleGuidDiff diff(mover.ClientGuids);
+            for (FakePlayer& other : players)
+            {
+                if (&other == &mover)
+                    continue;
+
+                diff.Visit(other.Guid);
+                if (pairs && !pairs->MarkPair(&mover, &other))
+                    continue;
+
+                mover.ClientGuids.insert(other.Guid);
+                other.ClientGuids.insert(mover.Guid);
+                ++updated;
+            }
+
+            for (uint64 guid : diff.GetNotVisited())
+                mover.ClientGuids.erase(guid);
+        }
+
+        if (pairs)
+            pairs->Clear();
+        return updated;
+    }
+}
+
+TEST(VisibilityPassTest, FindsKnownGuidsNotVisited)
+{
+    std::unordered_set<uint64> known = { 9, 3, 7, 1, 5 };
+    VisibleGuidDiff diff(known);
+    for (uint64 guid : { 7, 2, 1, 7, 10 })
+        diff.Visit(guid);
+
+    EXPECT_EQ(diff.GetNotVisited(), std::vector<uint64>({ 3, 5, 9 }));
+}
+
+TEST(VisibilityPassTest, OffersPairsOfMoversOnce)
+{
+    FakePlayer first { 1 }, second { 2 }, still { 3 };
+    VisibilityPairs<FakePlayer> pairs;
+
+    // outside of a pass every pair is offered
+    EXPECT_TRUE(pairs.MarkPair(&first, &second));
+    EXPECT_TRUE(pairs.MarkPair(&first, &second));
+
+    pairs.AddMover(&first);
+    pairs.AddMover(&second);
+    pairs.AddMover(&first);
+    EXPECT_TRUE(pairs.MarkPair(&first, &second));
+    EXPECT_FALSE(pairs.MarkPair(&second, &first));
+    EXPECT_FALSE(pairs.MarkPair(&first, &second));
+
+    // only the mover finds a unit that did not move, the pair is offered to each of its notifiers
+    EXPECT_TRUE(pairs.MarkPair(&first, &still));
+    EXPECT_TRUE(pairs.MarkPair(&first, &still));
+    EXPECT_TRUE(pairs.MarkPair(&first, &first));
+
+    pairs.Clear();
+    pairs.AddMover(&second);
+    pairs.AddMover(&first);
+    EXPECT_TRUE(pairs.MarkPair(&second, &first));
+}
+
+// N players moving in one cell: each pair of movers is updated once per pass instead of once by the notifier of each
+TEST(VisibilityPassTest, PlayersMovingInOneCell)
+{
+    uint32 const count = 200;
+    uint32 const movers = 150;
+
+    std::vector<FakePlayer> players(count);
+    for (uint32 i = 0; i < count; ++i)
+        players[i].Guid = i + 1;
+
+    // a gone player is still known by every client
+    for (FakePlayer& player : players)
+        player.ClientGuids.insert(1000);
+
+    std::vector<FakePlayer> unpaired = players;
+    VisibilityPairs<FakePlayer> pairs;
+
+    EXPECT_EQ(RunPass(unpaired, movers, nullptr), movers * (count - 1));
+    EXPECT_EQ(RunPass(players, movers, &pairs), movers * (count - 1) - movers * (movers - 1) / 2);
+
+    // both passes leave every client with the same objects
+    for (uint32 i = 0; i < count; ++i)
+    {
+        EXPECT_EQ(players[i].ClientGuids, unpaired[i].ClientGuids);
+        EXPECT_EQ(players[i].ClientGuids.count(1000), i < movers ? 0u : 1u);
+        // players that did not move only learned of the movers
+        EXPECT_EQ(players[i].ClientGuids.size(), i < movers ? count - 1 : movers + 1);
+    }
+}
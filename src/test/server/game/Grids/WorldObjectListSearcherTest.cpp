@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "GridNotifiers.h"
+#include "GridNotifiersImpl.h"
+#include "gtest/gtest.h"
+#include <memory>
+
+namespace
+{
+    class SearchObject : public WorldObject
+    {
+    public:
+        SearchObject(TypeID typeId, uint32 phaseMask) : WorldObject(false)
+        {
+            m_objectTypeId = typeId;
+            SetPhaseMask(phaseMask, false);
+        }
+    };
+
+    struct AcceptAll
+    {
+        uint32 Checked = 0;
+
+        bool operator()(WorldObject* /*object*/)
+        {
+            ++Checked;
+            return true;
+        }
+    };
+}
+
+// the objects a map's unit index offers get the same type and phase tests as those of the grid cells
+TEST(WorldObjectListSearcherTest, SingleObjectsSkipOtherPhases)
+{
+    SearchObject caster(TYPEID_PLAYER, 1 | 4);
+
+    std::vector<std::unique_ptr<SearchObject>> objects;
+    for (uint32 phaseMask : { 1, 2, 4, 8, 1 | 2, 2 | 8 })
+    {
+        objects.emplace_back(new SearchObject(TYPEID_UNIT, phaseMask));
+        objects.emplace_back(new SearchObject(TYPEID_PLAYER, phaseMask));
+    }
+
+    std::list<WorldObject*> found;
+    AcceptAll check;
+    acore::WorldObjectListSearcher<AcceptAll> searcher(&caster, found, check, GRID_MAP_TYPE_MASK_CREATURE | GRID_MAP_TYPE_MASK_PLAYER);
+    for (auto const& object : objects)
+        searcher.Visit(object.get());
+
+    std::list<WorldObject*> expected;
+    for (auto const& object : objects)
+        if (object->GetPhaseMask() & caster.GetPhaseMask())
+            expected.push_back(object.get());
+
+    EXPECT_EQ(found, expected);
+    // other phases are skipped before the check
+    EXPECT_EQ(check.Checked, uint32(expected.size()));
+
+    // only the asked object types
+    found.clear();
+    acore::WorldObjectListSearcher<AcceptAll> creatureSearcher(&caster, found, check, GRID_MAP_TYPE_MASK_CREATURE);
+    for (auto const& object : objects)
+        creatureSearcher.Visit(object.get());
+
+    for (WorldObject* object : found)
+        EXPECT_EQ(object->GetTypeId(), TYPEID_UNIT);
+    EXPECT_EQ(found.size(), expected.size() / 2);
+}
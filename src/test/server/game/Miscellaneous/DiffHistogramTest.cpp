@@ -0,0 +1,25 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "AvgDiffTracker.h"
+#include "gtest/gtest.h"
+
+TEST(DiffHistogramTest, CountsTimesByRange)
+{
+    DiffHistogram histogram;
+    for (uint32 diff : { 0, 5, 6, 10, 50, 51, 500, 501, 100000 })
+        histogram.Update(diff);
+
+    EXPECT_EQ(histogram.getCount(0), 2u); // <=5
+    EXPECT_EQ(histogram.getCount(1), 2u); // <=10
+    EXPECT_EQ(histogram.getCount(3), 1u); // <=50
+    EXPECT_EQ(histogram.getCount(4), 1u); // <=100
+    EXPECT_EQ(histogram.getCount(7), 1u); // <=500
+    EXPECT_EQ(histogram.getCount(8), 2u); // >500
+    EXPECT_EQ(histogram.ToString(), "<=5: 2, <=10: 2, <=25: 0, <=50: 1, <=100: 1, <=150: 0, <=250: 0, <=500: 1, >500: 2");
+
+    histogram.Reset();
+    for (uint32 i = 0; i < DIFF_HISTOGRAM_BUCKETS; ++i)
+        EXPECT_EQ(histogram.getCount(i), 0u);
+}
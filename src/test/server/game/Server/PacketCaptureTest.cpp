@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-AGPL3
+ */
+
+#include "PacketCapture.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace
+{
+    // packet whose bytes all hold its number, so a copy of a packet being overwritten shows
+    std::vector<uint8> MakeData(uint32 number)
+    {
+        return std::vector<uint8>(16 + number % 200, uint8(number));
+    }
+
+    bool IsIntact(PacketCapture::Packet const& packet)
+    {
+        return packet.Data == MakeData(packet.Opcode);
+    }
+}
+
+TEST(PacketCaptureTest, KeepsLatestPacketsOfBothDirections)
+{
+    PacketCapture capture(4096);
+    for (uint32 i = 0; i < 1000; ++i)
+    {
+        std::vector<uint8> data = MakeData(i);
+        capture.Add(uint8(i % 3 == 0), i, 100 + i / 10, data.data(), uint32(data.size()));
+    }
+
+    std::vector<PacketCapture::Packet> packets = capture.GetPackets(0);
+    ASSERT_FALSE(packets.empty());
+
+    // the newest packets are kept, in the order they were added, each with its direction
+    EXPECT_EQ(packets.back().Opcode, 999u);
+    for (uint32 i = 0; i < packets.size(); ++i)
+    {
+        EXPECT_TRUE(IsIntact(packets[i]));
+        EXPECT_EQ(packets[i].Direction, packets[i].Opcode % 3 == 0 ? 1 : 0);
+        if (i > 0)
+            EXPECT_GT(packets[i].Opcode, packets[i - 1].Opcode);
+    }
+
+    // only the packets of the asked time
+    for (PacketCapture::Packet const& packet : capture.GetPackets(195))
+        EXPECT_GE(packet.Opcode, 950u);
+
+    // too big to keep
+    std::vector<uint8> big(2000, 1);
+    capture.Add(0, 1, 200, big.data(), uint32(big.size()));
+    EXPECT_EQ(capture.GetSkippedPackets(), 1u);
+    EXPECT_EQ(capture.GetPackets(0).back().Opcode, 999u);
+}
+
+TEST(PacketCaptureTest, CopiesWhileWriting)
+{
+    PacketCapture capture(1024);
+    std::atomic<bool> stop(false);
+
+    std::thread writer([&capture, &stop]()
+    {
+        for (uint32 i = 0; !stop; ++i)
+        {
+            std::vector<uint8> data = MakeData(i);
+            capture.Add(1, i, 0, data.data(), uint32(data.size()));
+        }
+    });
+
+    // copies race the writer overwriting the ring, every packet copied must be whole
+    uint32 copies = 0;
+    auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+    while (std::chrono::steady_clock::now() < end)
+    {
+        std::vector<PacketCapture::Packet> packets = capture.GetPackets(0);
+        for (uint32 i = 0; i < packets.size(); ++i)
+        {
+            ASSERT_TRUE(IsIntact(packets[i]));
+            if (i > 0)
+                ASSERT_EQ(packets[i].Opcode, packets[i - 1].Opcode + 1);
+        }
+
+        ++copies;
+        std::this_thread::yield();
+    }
+
+    stop = true;
+    writer.join();
+    EXPECT_GT(copies, 0u);
+}
+
+TEST(PacketCaptureTest, VisitsRingWhileWriting)
+{
+    PacketCaptureRing ring(1024);
+    std::atomic<bool> stop(false);
+
+    // small packets, the writer goes around the ring many times between the loads of one visit
+    std::thread writer([&ring, &stop]()
+    {
+        for (uint32 i = 0; !stop; ++i)
+        {
+            std::vector<uint8> data(i % 24, uint8(i));
+            PacketCaptureRing::Header header{ uint32(data.size()), i, 0, i };
+            ring.Add(header, data.data());
+        }
+    });
+
+    uint32 visits = 0;
+    auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+    while (std::chrono::steady_clock::now() < end)
+    {
+        uint32 bytes = 0;
+        uint32 last = 0;
+        bool first = true;
+        ring.Visit([&](PacketCaptureRing::Header const& header, uint8 const* data)
+        {
+            ASSERT_EQ(header.Size, header.Opcode % 24);
+            for (uint32 i = 0; i < header.Size; ++i)
+                ASSERT_EQ(data[i], uint8(header.Opcode));
+            if (!first)
+                ASSERT_EQ(header.Opcode, last + 1);
+
+            bytes += sizeof(PacketCaptureRing::Header) + header.Size;
+            last = header.Opcode;
+            first = false;
+        });
+
+        ASSERT_LE(bytes, ring.GetCapacity());
+        ++visits;
+    }
+
+    stop = true;
+    writer.join();
+    EXPECT_GT(visits, 0u);
+}
+
+TEST(PacketCaptureTest, LimitsDumps)
+{
+    PacketCapture capture(1024);
+    EXPECT_TRUE(capture.StartDump(1000, 60));
+    EXPECT_FALSE(capture.StartDump(1030, 60));
+    // forced
+    EXPECT_TRUE(capture.StartDump(1030, 0));
+    EXPECT_FALSE(capture.StartDump(1089, 60));
+    EXPECT_TRUE(capture.StartDump(1090, 60));
+}
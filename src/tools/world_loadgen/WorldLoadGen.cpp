@@ -0,0 +1,687 @@
+/*
+ * Copyright (C) 2016+     AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license: https://github.com/azerothcore/azerothcore-wotlk/blob/master/LICENSE-GPL2
+ */
+
+/// Loopback load generator for the network threads of the worldserver. It logs accounts in through the authserver
+/// first, then opens all their world connections at once, as clients do after a restart, and reports the connections
+/// per second and the latency of the handshakes, from connecting to SMSG_AUTH_RESPONSE.
+/// Without a password it only connects and waits for SMSG_AUTH_CHALLENGE, which needs no accounts.
+
+#include "Cryptography/ARC4.h"
+#include "Cryptography/BigNumber.h"
+#include "Cryptography/HMACSHA1.h"
+#include "Cryptography/SHA1.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <random>
+#include <string>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+    typedef std::chrono::steady_clock Clock;
+
+    uint8 const AUTH_LOGON_CHALLENGE = 0x00;
+    uint8 const AUTH_LOGON_PROOF = 0x01;
+    uint16 const SMSG_AUTH_CHALLENGE = 0x1EC;
+    uint32 const CMSG_AUTH_SESSION = 0x1ED;
+    uint16 const SMSG_AUTH_RESPONSE = 0x1EE;
+    uint8 const AUTH_OK = 0x0C;
+    uint8 const AUTH_WAIT_QUEUE = 0x1B;
+    uint16 const CLIENT_BUILD = 12340;
+
+    struct Options
+    {
+        std::string AuthHost = "127.0.0.1";
+        uint16 AuthPort = 3724;
+        std::string WorldHost = "127.0.0.1";
+        uint16 WorldPort = 8085;
+        std::string AccountPrefix = "LOADTEST";
+        std::string Password;
+        uint32 Clients = 100;
+        uint32 Threads = 32;
+        uint32 Realm = 1;
+        uint32 Sources = 64;
+        uint32 HoldSeconds = 10;
+        uint32 TimeoutMs = 60000;
+    };
+
+    std::string Upper(std::string text)
+    {
+        std::transform(text.begin(), text.end(), text.begin(), [](char c) { return char(toupper(uint8(c))); });
+        return text;
+    }
+
+    /// The authserver accepts one logon per address and second, logons are spread over 127.0.0.1 and the following
+    /// loopback addresses
+    std::string GetSourceAddress(Options const& options, uint32 index)
+    {
+        if (!options.Sources)
+            return std::string();
+
+        uint32 host = 0x7F000001 + index % options.Sources;
+        char address[INET_ADDRSTRLEN];
+        in_addr addr;
+        addr.s_addr = htonl(host);
+        inet_ntop(AF_INET, &addr, address, sizeof(address));
+        return address;
+    }
+
+    int Connect(std::string const& host, uint16 port, std::string const& source, uint32 timeoutMs)
+    {
+        addrinfo hints = { };
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* result = nullptr;
+        if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &result) != 0 || !result)
+            return -1;
+
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd == -1)
+        {
+            freeaddrinfo(result);
+            return -1;
+        }
+
+        timeval timeout;
+        timeout.tv_sec = timeoutMs / 1000;
+        timeout.tv_usec = (timeoutMs % 1000) * 1000;
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        int noDelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+        if (!source.empty())
+        {
+            sockaddr_in local = { };
+            local.sin_family = AF_INET;
+            inet_pton(AF_INET, source.c_str(), &local.sin_addr);
+            if (bind(fd, reinterpret_cast<sockaddr*>(&local), sizeof(local)) == -1)
+            {
+                close(fd);
+                freeaddrinfo(result);
+                return -1;
+            }
+        }
+
+        int connected = connect(fd, result->ai_addr, result->ai_addrlen);
+        freeaddrinfo(result);
+        if (connected == -1)
+        {
+            close(fd);
+            return -1;
+        }
+
+        return fd;
+    }
+
+    bool SendAll(int fd, std::vector<uint8> const& data)
+    {
+        size_t sent = 0;
+        while (sent < data.size())
+        {
+            ssize_t result = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (result <= 0)
+            {
+                if (result == -1 && errno == EINTR)
+                    continue;
+                return false;
+            }
+
+            sent += size_t(result);
+        }
+
+        return true;
+    }
+
+    bool RecvAll(int fd, void* data, size_t size)
+    {
+        size_t received = 0;
+        while (received < size)
+        {
+            ssize_t result = recv(fd, static_cast<uint8*>(data) + received, size - received, 0);
+            if (result <= 0)
+            {
+                if (result == -1 && errno == EINTR)
+                    continue;
+                return false;
+            }
+
+            received += size_t(result);
+        }
+
+        return true;
+    }
+
+    template<class T>
+    void Append(std::vector<uint8>& data, T value)
+    {
+        uint8 const* bytes = reinterpret_cast<uint8 const*>(&value);
+        data.insert(data.end(), bytes, bytes + sizeof(T));
+    }
+
+    void Append(std::vector<uint8>& data, uint8 const* bytes, size_t size)
+    {
+        data.insert(data.end(), bytes, bytes + size);
+    }
+
+    /// SRP6 logon through the authserver, as AuthSocket expects it from a 3.3.5a client.
+    /// Returns nullptr and the session key the worldserver reads from the account, or the reason of the failure
+    char const* Logon(Options const& options, std::string const& account, std::string const& source, BigNumber& K)
+    {
+        int fd = Connect(options.AuthHost, options.AuthPort, source, options.TimeoutMs);
+        if (fd == -1)
+            return "cannot connect to the authserver";
+
+        std::string user = Upper(account);
+        std::vector<uint8> packet;
+        Append(packet, AUTH_LOGON_CHALLENGE);
+        Append(packet, uint8(8));
+        Append(packet, uint16(30 + user.size()));
+        Append(packet, reinterpret_cast<uint8 const*>("WoW\0"), 4);
+        Append(packet, uint8(3));
+        Append(packet, uint8(3));
+        Append(packet, uint8(5));
+        Append(packet, CLIENT_BUILD);
+        // platform, os and country are sent reversed
+        Append(packet, reinterpret_cast<uint8 const*>("68x\0"), 4);
+        Append(packet, reinterpret_cast<uint8 const*>("niW\0"), 4);
+        Append(packet, reinterpret_cast<uint8 const*>("SUne"), 4);
+        Append(packet, uint32(0));
+        Append(packet, uint32(0x0100007F));
+        Append(packet, uint8(user.size()));
+        Append(packet, reinterpret_cast<uint8 const*>(user.data()), user.size());
+
+        uint8 header[3];
+        if (!SendAll(fd, packet) || !RecvAll(fd, header, sizeof(header)))
+        {
+            close(fd);
+            return "no logon challenge answer";
+        }
+
+        // also the answer of the flood protection, for more than one logon per address and second
+        if (header[2] != 0)
+        {
+            close(fd);
+            return "logon challenge refused, unknown account or too many logons from the address";
+        }
+
+        uint8 bBytes[32], gLength, gBytes[32], nLength, nBytes[32], sBytes[32], unknown[16], securityFlags;
+        if (!RecvAll(fd, bBytes, 32) || !RecvAll(fd, &gLength, 1) || gLength > 32 || !RecvAll(fd, gBytes, gLength) ||
+            !RecvAll(fd, &nLength, 1) || nLength > 32 || !RecvAll(fd, nBytes, nLength) || !RecvAll(fd, sBytes, 32) ||
+            !RecvAll(fd, unknown, 16) || !RecvAll(fd, &securityFlags, 1))
+        {
+            close(fd);
+            return "incomplete logon challenge answer";
+        }
+
+        if (securityFlags)
+        {
+            close(fd);
+            return "the account needs a PIN, matrix or token";
+        }
+
+        BigNumber B, g, N, s;
+        B.SetBinary(bBytes, 32);
+        g.SetBinary(gBytes, gLength);
+        N.SetBinary(nBytes, nLength);
+        s.SetBinary(sBytes, 32);
+
+        SHA1Hash sha;
+        sha.UpdateData(user + ":" + Upper(options.Password));
+        sha.Finalize();
+        uint8 passwordHash[SHA_DIGEST_LENGTH];
+        memcpy(passwordHash, sha.GetDigest(), SHA_DIGEST_LENGTH);
+
+        sha.Initialize();
+        sha.UpdateData(s.AsByteArray().get(), s.GetNumBytes());
+        sha.UpdateData(passwordHash, SHA_DIGEST_LENGTH);
+        sha.Finalize();
+        BigNumber x;
+        x.SetBinary(sha.GetDigest(), SHA_DIGEST_LENGTH);
+
+        sha.Initialize();
+        sha.UpdateBigNumbers(&N, nullptr);
+        sha.Finalize();
+        uint8 hash[SHA_DIGEST_LENGTH];
+        memcpy(hash, sha.GetDigest(), SHA_DIGEST_LENGTH);
+        sha.Initialize();
+        sha.UpdateBigNumbers(&g, nullptr);
+        sha.Finalize();
+        for (int i = 0; i < SHA_DIGEST_LENGTH; ++i)
+            hash[i] ^= sha.GetDigest()[i];
+
+        BigNumber t3;
+        t3.SetBinary(hash, SHA_DIGEST_LENGTH);
+
+        sha.Initialize();
+        sha.UpdateData(user);
+        sha.Finalize();
+        uint8 userHash[SHA_DIGEST_LENGTH];
+        memcpy(userHash, sha.GetDigest(), SHA_DIGEST_LENGTH);
+
+        // BigNumber::AsByteArray() pads on the wrong side, A and M are picked again until they need no padding,
+        // like the authserver reads them
+        BigNumber A, M;
+        do
+        {
+            BigNumber a;
+            a.SetRand(19 * 8);
+            A = g.ModExp(a, N);
+
+            sha.Initialize();
+            sha.UpdateBigNumbers(&A, &B, nullptr);
+            sha.Finalize();
+            BigNumber u;
+            u.SetBinary(sha.GetDigest(), SHA_DIGEST_LENGTH);
+
+            // S = (B - 3 * g^x) ^ (a + u * x)
+            BigNumber k(3);
+            BigNumber kgx = (g.ModExp(x, N) * k) % N;
+            BigNumber base = ((B + N) - kgx) % N;
+            BigNumber S = base.ModExp(a + u * x, N);
+
+            uint8 t[32];
+            uint8 half[16];
+            uint8 vK[40];
+            memcpy(t, S.AsByteArray(32).get(), 32);
+            for (int part = 0; part < 2; ++part)
+            {
+                for (int i = 0; i < 16; ++i)
+                    half[i] = t[i * 2 + part];
+
+                sha.Initialize();
+                sha.UpdateData(half, 16);
+                sha.Finalize();
+                for (int i = 0; i < 20; ++i)
+                    vK[i * 2 + part] = sha.GetDigest()[i];
+            }
+
+            K.SetBinary(vK, 40);
+
+            sha.Initialize();
+            sha.UpdateBigNumbers(&t3, nullptr);
+            sha.UpdateData(userHash, SHA_DIGEST_LENGTH);
+            sha.UpdateBigNumbers(&s, &A, &B, &K, nullptr);
+            sha.Finalize();
+            M.SetBinary(sha.GetDigest(), SHA_DIGEST_LENGTH);
+        } while (A.GetNumBytes() != 32 || M.GetNumBytes() != SHA_DIGEST_LENGTH);
+
+        packet.clear();
+        Append(packet, AUTH_LOGON_PROOF);
+        Append(packet, A.AsByteArray(32).get(), 32);
+        Append(packet, M.AsByteArray(SHA_DIGEST_LENGTH).get(), SHA_DIGEST_LENGTH);
+        for (int i = 0; i < SHA_DIGEST_LENGTH; ++i)
+            Append(packet, uint8(0));                       // crc hash
+        Append(packet, uint8(0));                           // number of keys
+        Append(packet, uint8(0));                           // security flags
+
+        uint8 proof[32];
+        if (!SendAll(fd, packet) || !RecvAll(fd, proof, 2))
+        {
+            close(fd);
+            return "no logon proof answer";
+        }
+
+        if (proof[1] != 0)
+        {
+            close(fd);
+            return "wrong password";
+        }
+
+        bool complete = RecvAll(fd, proof + 2, sizeof(proof) - 2);
+        close(fd);
+        return complete ? nullptr : "incomplete logon proof answer";
+    }
+
+    /// Reads a packet header of the worldserver, 4 bytes or 5 for packets over 32767 bytes
+    bool ReadServerHeader(int fd, ARC4* decrypt, uint32& size, uint16& opcode)
+    {
+        uint8 header[5];
+        if (!RecvAll(fd, header, 4))
+            return false;
+
+        if (decrypt)
+            decrypt->UpdateData(4, header);
+
+        if (!(header[0] & 0x80))
+        {
+            size = (uint32(header[0]) << 8) | header[1];
+            opcode = uint16(header[2] | (header[3] << 8));
+            return true;
+        }
+
+        if (!RecvAll(fd, header + 4, 1))
+            return false;
+
+        if (decrypt)
+            decrypt->UpdateData(1, header + 4);
+
+        size = (uint32(header[0] & 0x7F) << 16) | (uint32(header[1]) << 8) | header[2];
+        opcode = uint16(header[3] | (header[4] << 8));
+        return true;
+    }
+
+    enum HandshakeResult
+    {
+        HANDSHAKE_OK,
+        HANDSHAKE_QUEUED,
+        HANDSHAKE_REFUSED,
+        HANDSHAKE_FAILED
+    };
+
+    /// Connects to the worldserver and, with a session key, authenticates like a client until SMSG_AUTH_RESPONSE.
+    /// The connection is returned in fd to be kept open.
+    HandshakeResult EnterWorld(Options const& options, std::string const& account, BigNumber* K, int& fd)
+    {
+        fd = Connect(options.WorldHost, options.WorldPort, std::string(), options.TimeoutMs);
+        if (fd == -1)
+            return HANDSHAKE_FAILED;
+
+        uint32 size;
+        uint16 opcode;
+        std::vector<uint8> body;
+        if (!ReadServerHeader(fd, nullptr, size, opcode) || opcode != SMSG_AUTH_CHALLENGE || size < 2 + 8)
+            return HANDSHAKE_FAILED;
+
+        body.resize(size - 2);
+        if (!RecvAll(fd, body.data(), body.size()))
+            return HANDSHAKE_FAILED;
+
+        if (!K)
+            return HANDSHAKE_OK;
+
+        uint32 serverSeed;
+        memcpy(&serverSeed, body.data() + 4, 4);
+        uint32 clientSeed = uint32(std::random_device()());
+        std::string user = Upper(account);
+
+        uint32 zero = 0;
+        SHA1Hash sha;
+        sha.UpdateData(user);
+        sha.UpdateData(reinterpret_cast<uint8 const*>(&zero), 4);
+        sha.UpdateData(reinterpret_cast<uint8 const*>(&clientSeed), 4);
+        sha.UpdateData(reinterpret_cast<uint8 const*>(&serverSeed), 4);
+        sha.UpdateBigNumbers(K, nullptr);
+        sha.Finalize();
+
+        body.clear();
+        Append(body, uint32(CLIENT_BUILD));
+        Append(body, uint32(0));                            // login server id
+        Append(body, reinterpret_cast<uint8 const*>(user.c_str()), user.size() + 1);
+        Append(body, uint32(0));                            // login server type
+        Append(body, clientSeed);
+        Append(body, uint32(0));                            // region
+        Append(body, uint32(0));                            // battlegroup
+        Append(body, options.Realm);
+        Append(body, uint64(0));                            // dos response
+        Append(body, sha.GetDigest(), SHA_DIGEST_LENGTH);
+        Append(body, uint32(0));                            // no addon info
+
+        // client headers are 6 bytes, the size counts the opcode
+        std::vector<uint8> packet;
+        Append(packet, uint8((body.size() + 4) >> 8));
+        Append(packet, uint8((body.size() + 4) & 0xFF));
+        Append(packet, CMSG_AUTH_SESSION);
+        packet.insert(packet.end(), body.begin(), body.end());
+        if (!SendAll(fd, packet))
+            return HANDSHAKE_FAILED;
+
+        // headers are encrypted from here on, except for refusals sent before the session key was checked
+        uint8 ServerEncryptionKey[16] = { 0xCC, 0x98, 0xAE, 0x04, 0xE8, 0x97, 0xEA, 0xCA, 0x12, 0xDD, 0xC0, 0x93, 0x42, 0x91, 0x53, 0x57 };
+        HmacHash decryptHmac(16, ServerEncryptionKey);
+        ARC4 decrypt(SHA_DIGEST_LENGTH);
+        decrypt.Init(decryptHmac.ComputeHash(K));
+        uint8 drop[1024] = { };
+        decrypt.UpdateData(sizeof(drop), drop);
+
+        bool first = true;
+        for (;;)
+        {
+            uint8 header[4];
+            if (!RecvAll(fd, header, 4))
+                return HANDSHAKE_FAILED;
+
+            if (first && header[0] == 0 && header[1] == 3 && (header[2] | (header[3] << 8)) == SMSG_AUTH_RESPONSE)
+                return HANDSHAKE_REFUSED;
+            first = false;
+
+            decrypt.UpdateData(4, header);
+            if (header[0] & 0x80)
+            {
+                uint8 last;
+                if (!RecvAll(fd, &last, 1))
+                    return HANDSHAKE_FAILED;
+
+                decrypt.UpdateData(1, &last);
+                size = (uint32(header[0] & 0x7F) << 16) | (uint32(header[1]) << 8) | header[2];
+                opcode = uint16(header[3] | (last << 8));
+            }
+            else
+            {
+                size = (uint32(header[0]) << 8) | header[1];
+                opcode = uint16(header[2] | (header[3] << 8));
+            }
+
+            if (size < 2)
+                return HANDSHAKE_FAILED;
+
+            body.resize(size - 2);
+            if (!RecvAll(fd, body.data(), body.size()))
+                return HANDSHAKE_FAILED;
+
+            if (opcode != SMSG_AUTH_RESPONSE || body.empty())
+                continue;
+
+            if (body[0] == AUTH_OK)
+                return HANDSHAKE_OK;
+            return body[0] == AUTH_WAIT_QUEUE ? HANDSHAKE_QUEUED : HANDSHAKE_REFUSED;
+        }
+    }
+
+    double Percentile(std::vector<double> const& sorted, double percent)
+    {
+        if (sorted.empty())
+            return 0.0;
+
+        size_t index = std::min(sorted.size() - 1, size_t(percent / 100.0 * sorted.size()));
+        return sorted[index];
+    }
+
+    void Usage(char const* program)
+    {
+        printf("Usage: %s [options]\n"
+               "Opens many world connections at once against a local worldserver and reports their latency.\n\n"
+               "  -c <count>      clients (default 100)\n"
+               "  -t <count>      threads opening world connections (default 32)\n"
+               "  -a <host:port>  authserver (default 127.0.0.1:3724)\n"
+               "  -w <host:port>  worldserver (default 127.0.0.1:8085)\n"
+               "  -u <prefix>     account names, the prefix followed by 1..count (default LOADTEST)\n"
+               "  -p <password>   password of every account, without it only SMSG_AUTH_CHALLENGE is awaited\n"
+               "  -r <id>         realm id of the worldserver (default 1)\n"
+               "  -s <count>      loopback addresses to log in from, the authserver accepts one logon\n"
+               "                  per address and second (default 64, 0 to not bind)\n"
+               "  -h <seconds>    time the connections are kept open afterwards (default 10)\n"
+               "  -o <ms>         timeout of each step (default 60000)\n\n"
+               "The accounts are created beforehand, e.g. with .account create LOADTEST1 <password>.\n", program);
+    }
+
+    bool ParseHost(char const* value, std::string& host, uint16& port)
+    {
+        std::string text(value);
+        size_t colon = text.rfind(':');
+        if (colon == std::string::npos)
+            return false;
+
+        host = text.substr(0, colon);
+        port = uint16(atoi(text.c_str() + colon + 1));
+        return !host.empty() && port;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (argv[i][0] != '-' || strlen(argv[i]) != 2 || i + 1 >= argc)
+        {
+            Usage(argv[0]);
+            return 1;
+        }
+
+        char const* value = argv[++i];
+        switch (argv[i - 1][1])
+        {
+            case 'c': options.Clients = uint32(atoi(value)); break;
+            case 't': options.Threads = std::max(1, atoi(value)); break;
+            case 'u': options.AccountPrefix = value; break;
+            case 'p': options.Password = value; break;
+            case 'r': options.Realm = uint32(atoi(value)); break;
+            case 's': options.Sources = uint32(std::max(0, std::min(atoi(value), 65000))); break;
+            case 'h': options.HoldSeconds = uint32(atoi(value)); break;
+            case 'o': options.TimeoutMs = uint32(std::max(1, atoi(value))); break;
+            case 'a':
+                if (!ParseHost(value, options.AuthHost, options.AuthPort))
+                {
+                    Usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'w':
+                if (!ParseHost(value, options.WorldHost, options.WorldPort))
+                {
+                    Usage(argv[0]);
+                    return 1;
+                }
+                break;
+            default:
+                Usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (!options.Clients)
+    {
+        Usage(argv[0]);
+        return 1;
+    }
+
+    bool authenticate = !options.Password.empty();
+    std::vector<BigNumber> keys(options.Clients);
+    std::vector<bool> loggedOn(options.Clients, false);
+
+    if (authenticate)
+    {
+        // one thread per loopback address, each logs on at most once per second
+        uint32 sources = std::max(1u, std::min(options.Sources, options.Clients));
+        printf("Logging %u accounts on through %s:%u from %u addresses...\n", options.Clients, options.AuthHost.c_str(), options.AuthPort, sources);
+
+        std::mutex errorLock;
+        std::vector<std::thread> threads;
+        for (uint32 source = 0; source < sources; ++source)
+        {
+            threads.emplace_back([&, source]()
+            {
+                std::string address = GetSourceAddress(options, source);
+                for (uint32 i = source; i < options.Clients; i += sources)
+                {
+                    Clock::time_point next = Clock::now() + std::chrono::milliseconds(1100);
+                    std::string account = options.AccountPrefix + std::to_string(i + 1);
+                    if (char const* error = Logon(options, account, address, keys[i]))
+                    {
+                        std::lock_guard<std::mutex> guard(errorLock);
+                        printf("  %s: %s\n", account.c_str(), error);
+                    }
+                    else
+                        loggedOn[i] = true;
+
+                    std::this_thread::sleep_until(next);
+                }
+            });
+        }
+
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+
+    std::vector<uint32> clients;
+    for (uint32 i = 0; i < options.Clients; ++i)
+        if (!authenticate || loggedOn[i])
+            clients.push_back(i);
+
+    if (clients.empty())
+    {
+        printf("No account could log on.\n");
+        return 1;
+    }
+
+    printf("Opening %u world connections to %s:%u with %u threads...\n", uint32(clients.size()), options.WorldHost.c_str(), options.WorldPort, options.Threads);
+
+    std::atomic<uint32> nextClient(0);
+    std::vector<double> latencies(clients.size(), -1.0);
+    std::vector<HandshakeResult> results(clients.size(), HANDSHAKE_FAILED);
+    std::vector<int> sockets(clients.size(), -1);
+
+    Clock::time_point start = Clock::now();
+    std::vector<std::thread> threads;
+    for (uint32 t = 0; t < options.Threads; ++t)
+    {
+        threads.emplace_back([&]()
+        {
+            for (uint32 i = nextClient++; i < clients.size(); i = nextClient++)
+            {
+                uint32 client = clients[i];
+                Clock::time_point begin = Clock::now();
+                results[i] = EnterWorld(options, options.AccountPrefix + std::to_string(client + 1), authenticate ? &keys[client] : nullptr, sockets[i]);
+                if (results[i] == HANDSHAKE_OK || results[i] == HANDSHAKE_QUEUED)
+                    latencies[i] = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    uint32 counts[HANDSHAKE_FAILED + 1] = { };
+    std::vector<double> sorted;
+    for (uint32 i = 0; i < clients.size(); ++i)
+    {
+        ++counts[results[i]];
+        if (latencies[i] >= 0.0)
+            sorted.push_back(latencies[i]);
+    }
+
+    std::sort(sorted.begin(), sorted.end());
+
+    printf("%u connected, %u queued, %u refused, %u failed in %.2f s: %.1f connections per second.\n",
+           counts[HANDSHAKE_OK], counts[HANDSHAKE_QUEUED], counts[HANDSHAKE_REFUSED], counts[HANDSHAKE_FAILED], elapsed, sorted.size() / std::max(elapsed, 0.001));
+    printf("Latency until %s (ms): p50 %.1f, p90 %.1f, p99 %.1f, max %.1f.\n", authenticate ? "SMSG_AUTH_RESPONSE" : "SMSG_AUTH_CHALLENGE",
+           Percentile(sorted, 50.0), Percentile(sorted, 90.0), Percentile(sorted, 99.0), sorted.empty() ? 0.0 : sorted.back());
+
+    // the connections stay open a while, as players in the world
+    if (options.HoldSeconds)
+        std::this_thread::sleep_for(std::chrono::seconds(options.HoldSeconds));
+
+    for (int fd : sockets)
+        if (fd != -1)
+            close(fd);
+
+    return counts[HANDSHAKE_FAILED] || counts[HANDSHAKE_REFUSED] ? 1 : 0;
+}